@@ -1160,6 +1160,7 @@ AudioRegionView::delete_waves ()
 		delete *i;
 	}
 	_data_ready_connections.clear ();
+	_peak_range_connections.drop_connections ();
 
 	for (vector<ArdourWaveView::WaveView*>::iterator w = waves.begin(); w != waves.end(); ++w) {
 		group->remove(*w);
@@ -1199,6 +1200,7 @@ AudioRegionView::create_waves ()
 	}
 
 	_data_ready_connections.clear ();
+	_peak_range_connections.drop_connections ();
 
 	for (uint32_t i = 0; i < nchans.n_audio(); ++i) {
 		_data_ready_connections.push_back (0);
@@ -1213,21 +1215,23 @@ AudioRegionView::create_waves ()
 		// cerr << "\tchannel " << n << endl;
 
 		if (wait_for_data) {
-			if (audio_region()->audio_source(n)->peaks_ready (boost::bind (&AudioRegionView::peaks_ready_handler, this, n), &_data_ready_connections[n], gui_context())) {
-				// cerr << "\tData is ready for channel " << n << "\n";
-				create_one_wave (n, true);
-			} else {
+			boost::shared_ptr<AudioSource> src (audio_region()->audio_source(n));
+			if (!src->peaks_ready (boost::bind (&AudioRegionView::peaks_ready_handler, this, n), &_data_ready_connections[n], gui_context())) {
 				// cerr << "\tdata is not ready for channel " << n << "\n";
-				// we'll get a PeaksReady signal from the source in the future
-				// and will call create_one_wave(n) then.
+				// the peakfile is (about to be) built. The wave is
+				// created when the first part of it is written, and
+				// updated as the builder proceeds.
+				src->PeakRangeReady.connect (_peak_range_connections, invalidator (*this),
+				                             boost::bind (&AudioRegionView::peak_range_ready_handler, this, n, _1, _2),
+				                             gui_context());
 				pending_peak_data->show ();
+				continue;
 			}
-
-		} else {
-			// cerr << "\tdon't delay, display channel " << n << " today!\n";
-			create_one_wave (n, true);
 		}
 
+		// cerr << "\tdisplay channel " << n << " today!\n";
+		create_one_wave (n, true);
+
 	}
 }
 
@@ -1323,8 +1327,10 @@ AudioRegionView::create_one_wave (uint32_t which, bool /*direct*/)
 			tmp_waves.pop_back ();
 		}
 
-		/* indicate peak-completed */
-		pending_peak_data->hide ();
+		/* indicate peak-completed, unless peakfiles are still being built */
+		if (!peaks_pending ()) {
+			pending_peak_data->hide ();
+		}
 
 		/* Restore stacked coverage */
 		LayerDisplay layer_display;
@@ -1333,20 +1339,64 @@ AudioRegionView::create_one_wave (uint32_t which, bool /*direct*/)
 	  }
 	}
 
-	/* channel wave created, don't hook into peaks ready anymore */
-	delete _data_ready_connections[which];
-	_data_ready_connections[which] = 0;
-
 	maybe_raise_cue_markers ();
 }
 
+bool
+AudioRegionView::peaks_pending () const
+{
+	for (vector<ScopedConnection*>::const_iterator i = _data_ready_connections.begin(); i != _data_ready_connections.end(); ++i) {
+		if (*i) {
+			return true;
+		}
+	}
+	return false;
+}
+
 void
 AudioRegionView::peaks_ready_handler (uint32_t which)
 {
-	Gtkmm2ext::UI::instance()->call_slot (invalidator (*this), boost::bind (&AudioRegionView::create_one_wave, this, which, false));
+	Gtkmm2ext::UI::instance()->call_slot (invalidator (*this), boost::bind (&AudioRegionView::peaks_built, this, which));
 	// cerr << "AudioRegionView::peaks_ready_handler() called on " << which << " this: " << this << endl;
 }
 
+void
+AudioRegionView::peak_range_ready_handler (uint32_t which, samplepos_t start, samplecnt_t cnt)
+{
+	if (which < waves.size ()) {
+		waves[which]->peaks_changed (start, cnt);
+	} else if (waves.empty () && which < tmp_waves.size () && !tmp_waves[which]) {
+		/* first part of the peakfile is ready */
+		create_one_wave (which, false);
+	}
+}
+
+void
+AudioRegionView::peaks_built (uint32_t which)
+{
+	if (!trackview.session() || trackview.session()->deletion_in_progress () || which >= _data_ready_connections.size ()) {
+		return;
+	}
+
+	/* don't hook into peaks ready anymore */
+	delete _data_ready_connections[which];
+	_data_ready_connections[which] = 0;
+
+	if (which < waves.size ()) {
+		/* the wave was drawn while the peakfile was built, redraw all of it */
+		waves[which]->peaks_changed (0, audio_region()->audio_source(which)->length().samples());
+	} else if (waves.empty () && which < tmp_waves.size () && !tmp_waves[which]) {
+		create_one_wave (which, false);
+	}
+
+	if (!peaks_pending ()) {
+		_peak_range_connections.drop_connections ();
+		if (!waves.empty ()) {
+			pending_peak_data->hide ();
+		}
+	}
+}
+
 void
 AudioRegionView::add_gain_point_event (ArdourCanvas::Item *item, GdkEvent *ev, bool with_guard_points)
 {
@@ -197,6 +197,9 @@ protected:
 
 	void create_one_wave (uint32_t, bool);
 	void peaks_ready_handler (uint32_t);
+	void peak_range_ready_handler (uint32_t, samplepos_t, samplecnt_t);
+	void peaks_built (uint32_t);
+	bool peaks_pending () const;
 
 	void set_colors ();
 	void set_waveform_colors ();
@@ -221,6 +224,9 @@ private:
 	 */
 	std::vector<PBD::ScopedConnection*> _data_ready_connections;
 
+	/** PeakRangeReady callbacks of sources whose peakfile is being built */
+	PBD::ScopedConnectionList _peak_range_connections;
+
 	/** RegionViews that we hid the xfades for at the start of the current drag;
 	 *  first list is for start xfades, second list is for end xfades.
 	 */
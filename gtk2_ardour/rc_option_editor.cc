@@ -2403,6 +2403,16 @@ RCOptionEditor::RCOptionEditor ()
 		     sigc::mem_fun (*_rc_config, &RCConfiguration::set_periodic_safety_backups)
 		     ));
 
+	bo = new BoolOption (
+		     "save-binary-state",
+		     _("Save session files in binary format"),
+		     sigc::mem_fun (*_rc_config, &RCConfiguration::get_save_binary_state),
+		     sigc::mem_fun (*_rc_config, &RCConfiguration::set_save_binary_state)
+		     );
+	add_option (_("General"), bo);
+	Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+			_("<b>When enabled</b> session files are written in a compact binary format, which is considerably faster to save and to load. Older versions of Ardour and other tools cannot read them. Sessions in either format can be loaded, and are converted when saved."));
+
 	add_option (_("General"), new DirectoryOption (
 			    X_("default-session-parent-dir"),
 			    _("Default folder for new sessions:"),
@@ -3758,6 +3768,17 @@ These settings will only take effect after %1 is restarted.\n\
 				sigc::mem_fun (*this, &RCOptionEditor::plugin_scan_refresh)));
 
 	add_option (_("Plugins"), new PluginScanTimeOutSliderOption (_rc_config));
+
+	SpinOption<uint32_t>* so = new SpinOption<uint32_t> (
+			"plugin-scan-jobs",
+			_("Concurrent plugin scans"),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::get_plugin_scan_jobs),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::set_plugin_scan_jobs),
+			0, 64, 1, 4
+			);
+	add_option (_("Plugins"), so);
+	Gtkmm2ext::UI::instance()->set_tip (so->tip_widget(),
+			_("Number of VST plugins that are scanned at the same time, each in a separate scanner process. 0 uses one per CPU core, 1 scans one plugin after the other."));
 #endif
 
 	add_option (_("Plugins"), new OptionEditorHeading (_("General")));
@@ -4518,6 +4539,16 @@ These settings will only take effect after %1 is restarted.\n\
 		procs->set_note (string_compose (_("This setting will only take effect when %1 is restarted."), PROGRAM_NAME));
 
 		add_option (_("Performance"), procs);
+
+		bo = new BoolOption (
+				"graph-work-stealing",
+				_("Use per-thread work-stealing process scheduler"),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::get_graph_work_stealing),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::set_graph_work_stealing)
+				);
+		Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+				_("When enabled, each DSP thread queues the routes that it triggers locally, and idle threads steal work from other threads. This reduces contention on systems with many CPU cores and small buffer-sizes."));
+		add_option (_("Performance"), bo);
 	}
 
 #if !(defined PLATFORM_WINDOWS || defined __APPLE__)
@@ -4630,6 +4661,28 @@ These settings will only take effect after %1 is restarted.\n\
 
 	add_option (_("Performance"), new BufferingOptions (_rc_config));
 
+	SpinOption<uint32_t>* bt = new SpinOption<uint32_t> (
+		"butler-threads",
+		_("Disk I/O threads"),
+		sigc::mem_fun (*_rc_config, &RCConfiguration::get_butler_threads),
+		sigc::mem_fun (*_rc_config, &RCConfiguration::set_butler_threads),
+		1, 32,
+		1, 4
+		);
+	Gtkmm2ext::UI::instance()->set_tip (bt->tip_widget(),
+			_("Number of threads used to read playback data from and write captured data to disk. With many tracks on fast storage, more threads reduce the time it takes to resume playback after a locate and keep up with recording many tracks."));
+	add_option (_("Performance"), bt);
+
+	bo = new BoolOption (
+		"mmap-audio-sources",
+		_("Memory-map 32-bit float WAV/RF64 files for playback"),
+		sigc::mem_fun (*_rc_config, &RCConfiguration::get_mmap_audio_sources),
+		sigc::mem_fun (*_rc_config, &RCConfiguration::set_mmap_audio_sources)
+		);
+	Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+			_("When enabled, uncompressed floating-point files are read directly from the page-cache rather than through libsndfile. This reduces CPU usage of disk-reads for sessions with many long recordings. Changes take effect when the session is reloaded."));
+	add_option (_("Performance"), bo);
+
 	/* Image cache size */
 	add_option (_("Performance"), new OptionEditorHeading (_("Memory Usage")));
 
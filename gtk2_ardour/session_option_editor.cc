@@ -408,6 +408,15 @@ SessionOptionEditor::SessionOptionEditor (Session* s)
 				sigc::mem_fun (*_session_config, &SessionConfiguration::set_count_in)
 				));
 
+	add_option (_("Misc"), new OptionEditorHeading (_("Processing")));
+
+	add_option (_("Misc"), new BoolOption (
+				"graph-critical-path",
+				_("Schedule routes by measured critical path"),
+				sigc::mem_fun (*_session_config, &SessionConfiguration::get_graph_critical_path),
+				sigc::mem_fun (*_session_config, &SessionConfiguration::set_graph_critical_path)
+				));
+
 	add_option (_("Misc"), new OptionEditorHeading (_("Defaults")));
 
 	Gtk::Button* btn = Gtk::manage (new Gtk::Button (_("Use these settings as defaults")));
@@ -34,6 +34,7 @@
 #include "pbd/failed_constructor.h"
 
 #include "ardour/ardour.h"
+#include "ardour/audio_backend.h"
 #include "ardour/audioengine.h"
 #include "ardour/revision.h"
 #include "ardour/session.h"
@@ -50,6 +51,8 @@ static const char* localedir = LOCALEDIR;
 
 static string             backend_client_name;
 static string             backend_name = "JACK";
+static uint32_t           benchmark_cycles = 0;
+static string             benchmark_data;
 static CrossThreadChannel xthread (true);
 static TestReceiver       test_receiver;
 
@@ -135,6 +138,9 @@ print_help ()
 	     << "  SNAPSHOT_NAME               Name of session/snapshot to load (without .ardour at end\n"
 	     << "  -v, --version               Show version information\n"
 	     << "  -h, --help                  Print this message\n"
+	     << "  -b, --benchmark <cycles>    Roll using the Dummy backend, process <cycles> as fast as possible,\n"
+	     << "                              print timing statistics and quit\n"
+	     << "  -C, --benchmark-data <file> Write per-cycle timings of the benchmark to <file> (CSV)\n"
 	     << "  -c, --name <name>           Use a specific backend client name, default is ardour\n"
 	     << "  -d, --disable-plugins       Disable all plugins in an existing session\n"
 	     << "  -D, --debug <options>       Set debug flags. Use \"-D list\" to see available options\n"
@@ -149,12 +155,14 @@ print_help ()
 int
 main (int argc, char* argv[])
 {
-	const char* optstring = "vhBdD:c:OU:P";
+	const char* optstring = "vhb:BC:dD:c:OU:P";
 
 	/* clang-format off */
 	const struct option longopts[] = {
 		{ "version",             no_argument,       0, 'v' },
 		{ "help",                no_argument,       0, 'h' },
+		{ "benchmark",           required_argument, 0, 'b' },
+		{ "benchmark-data",      required_argument, 0, 'C' },
 		{ "bypass-plugins",      no_argument,       0, 'B' },
 		{ "disable-plugins",     no_argument,       0, 'd' },
 		{ "debug",               required_argument, 0, 'D' },
@@ -185,6 +193,15 @@ main (int argc, char* argv[])
 				exit (EXIT_SUCCESS);
 				break;
 
+			case 'b':
+				benchmark_cycles = atoi (optarg);
+				backend_name     = "None (Dummy)";
+				break;
+
+			case 'C':
+				benchmark_data = optarg;
+				break;
+
 			case 'c':
 				backend_client_name = optarg;
 				break;
@@ -267,6 +284,24 @@ main (int argc, char* argv[])
 
 	s->request_roll ();
 
+	if (benchmark_cycles > 0) {
+		boost::shared_ptr<AudioBackend> backend = AudioEngine::instance ()->current_backend ();
+		Glib::usleep (100000); // let the transport start rolling
+		if (backend->start_benchmark (benchmark_cycles)) {
+			cerr << "Cannot start benchmark\n";
+			xthread.deliver ('x');
+		} else {
+			while (backend->benchmark_running () && AudioEngine::instance ()->running ()) {
+				Glib::usleep (100000);
+			}
+			cout << backend->benchmark_report ();
+			if (!benchmark_data.empty () && backend->write_benchmark_data (benchmark_data)) {
+				cerr << "Cannot write benchmark data to '" << benchmark_data << "'\n";
+			}
+			xthread.deliver ('x');
+		}
+	}
+
 	char msg;
 	do {
 	} while (0 == xthread.receive (msg, true));
@@ -709,6 +709,44 @@ public:
 	 */
 	virtual float dsp_load () const = 0;
 
+	/* Benchmarking (currently only offered by the Dummy backend) */
+
+	/** Process the next \p n_cycles cycles as fast as possible, without
+	 * waiting for the nominal duration of a cycle, and record the
+	 * wall-clock time, CPU time and DSP load of each cycle.
+	 *
+	 * Return zero on success, non-zero if the backend does not support
+	 * benchmarking, is not running, or a benchmark is in progress.
+	 */
+	virtual int start_benchmark (uint32_t n_cycles)
+	{
+		return -1;
+	}
+
+	/** return true while cycles requested by start_benchmark() remain */
+	virtual bool benchmark_running () const
+	{
+		return false;
+	}
+
+	/** return a summary of the most recent benchmark (timing statistics
+	 * and a DSP load histogram), or an empty string if there is none.
+	 */
+	virtual std::string benchmark_report () const
+	{
+		return "";
+	}
+
+	/** Write the per-cycle timings of the most recent benchmark to
+	 * \p path as comma separated values.
+	 *
+	 * Return zero on success, non-zero otherwise
+	 */
+	virtual int write_benchmark_data (std::string const& path) const
+	{
+		return -1;
+	}
+
 	/* Transport Control (JACK is the only audio API that currently offers
 	 * the concept of shared transport control)
 	 */
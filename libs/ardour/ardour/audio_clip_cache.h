@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _ardour_audio_clip_cache_h_
+#define _ardour_audio_clip_cache_h_
+
+#include <map>
+#include <vector>
+
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <glibmm/threads.h>
+
+#include "pbd/id.h"
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+class AudioClipCacheTest;
+
+namespace ARDOUR {
+
+class AudioRegion;
+
+/** Decoded audio data of regions that are used as clips (triggers).
+ *
+ * Triggers that use the same audio (e.g. the same loop in many slots)
+ * share a single copy of the data. Clips are reference counted, and
+ * clips that are no longer used by any trigger are kept until the
+ * cache exceeds its size limit (least recently used are dropped first).
+ */
+class LIBARDOUR_API AudioClipCache
+{
+public:
+	/** Audio data of all channels of a region, read-only once it is shared */
+	struct LIBARDOUR_API Clip : public std::vector<Sample*> {
+		Clip () : length (0) {}
+		~Clip ();
+
+		samplecnt_t length;
+	};
+
+	typedef boost::shared_ptr<Clip const> ClipPtr;
+
+	static AudioClipCache& instance ();
+
+	/** @return the decoded data of the given region, or a null pointer
+	 * if the region cannot be read. Not realtime safe.
+	 *
+	 * The region is decoded without holding the cache lock. Concurrent
+	 * requests for the same data wait until it is ready, requests for
+	 * other clips are not blocked.
+	 */
+	ClipPtr get (boost::shared_ptr<AudioRegion>, samplecnt_t sample_rate);
+
+	/** Drop unused clips until the cache size is within limits */
+	void trim ();
+
+	/** Drop all unused clips */
+	void clear ();
+
+	/** @return memory used by all clips in the cache, in bytes */
+	size_t size () const;
+
+private:
+	friend class ::AudioClipCacheTest;
+
+	AudioClipCache ();
+
+	struct Key {
+		std::vector<PBD::ID> sources;
+		samplepos_t          start;
+		samplecnt_t          length;
+		samplecnt_t          sample_rate;
+
+		bool operator< (Key const&) const;
+	};
+
+	struct Entry {
+		Entry () : bytes (0), last_use (0), loading (true) {}
+
+		ClipPtr  clip;
+		size_t   bytes;
+		uint64_t last_use;
+		bool     loading; ///< being decoded, clip is not set yet
+	};
+
+	typedef std::map<Key, Entry> Clips;
+
+	/** fill the given clip with the data of all channels, return false on error */
+	typedef boost::function<bool (Clip&)> Reader;
+
+	ClipPtr get (Key const&, std::string const& name, Reader const&, size_t limit);
+	void    trim_locked (size_t limit);
+
+	mutable Glib::Threads::Mutex _lock;
+	Glib::Threads::Cond          _loaded;
+	Clips                        _clips;
+	size_t                       _size;
+	uint64_t                     _use_count;
+
+	static AudioClipCache* _instance;
+};
+
+} // namespace ARDOUR
+
+#endif /* _ardour_audio_clip_cache_h_ */
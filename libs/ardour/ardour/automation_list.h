@@ -143,6 +143,10 @@ private:
 	bool operator== (const AutomationList&) const { /* not called */ abort(); return false; }
 	XMLNode* _before; //used for undo of touch start/stop pairs.
 
+	std::string          _events_xml;       ///< serialize_events() of the previous save
+	uint64_t             _events_xml_count; ///< edit_count() of _events_xml
+	Glib::Threads::Mutex _events_xml_lock;
+
 };
 
 } // namespace
@@ -25,6 +25,7 @@
 
 #include <pthread.h>
 
+#include <boost/shared_ptr.hpp>
 #include <glibmm/threads.h>
 
 #include "pbd/crossthread.h"
@@ -38,6 +39,9 @@
 
 namespace ARDOUR {
 
+class IOTaskList;
+class Track;
+
 /**
  *  One of the Butler's functions is to clean up (ie delete) unused CrossThreadPools.
  *  When a thread with a CrossThreadPool terminates, its CTP is added to pool_trash.
@@ -97,6 +101,24 @@ private:
 
 	bool flush_tracks_to_disk_normal (boost::shared_ptr<RouteList>, uint32_t& errors);
 
+	/* Parallel disk I/O.
+	 *
+	 * The butler thread itself and (butler-threads - 1) I/O threads
+	 * share the list of tracks to refill or flush. Playback buffers
+	 * are refilled in order of their load, emptiest first.
+	 */
+	bool refill_tracks (RouteList const&);
+	void refill_track (boost::shared_ptr<Track>);
+	void flush_track (boost::shared_ptr<Track>);
+	bool io_preempted ();
+	void reset_io_tasklist ();
+
+	IOTaskList*       _io_tasklist;
+	GATOMIC_QUAL gint _io_started;
+	GATOMIC_QUAL gint _io_unfinished;
+	GATOMIC_QUAL gint _io_preempted;
+	GATOMIC_QUAL gint _io_errors;
+
 	/**
 	 * Add request to butler thread request queue
 	 */
@@ -36,10 +36,9 @@
  * That's ok, it just means that the nicer scheduling heuristics
  * won't work for you.
  *
- * We only use the low 32 bits, and we'd simply better make sure
- * that we reschedule before that wraps. Scheduling at least every
- * four billion cycles just basically sounds like a good idea,
- * regardless of how fast the machine is.
+ * On x86_64 and ia64 the full 64 bit counter is returned. On other
+ * platforms it may only be 32 bits wide, and wrap within seconds,
+ * or always be zero.
  */
 typedef uint64_t cycles_t;
 
@@ -53,7 +52,7 @@ static inline cycles_t get_cycles (void)
 	cycles_t lo, hi;
 
 	rdtscll(lo, hi);
-	return lo;
+	return (hi << 32) | lo;
 }
 
 #else
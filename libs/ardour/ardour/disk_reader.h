@@ -90,6 +90,12 @@ public:
 	static void allocate_working_buffers ();
 	static void free_working_buffers ();
 
+	/** Give the calling thread its own working buffers for do_refill,
+	 * so that several I/O threads can refill tracks concurrently.
+	 * They are freed when the thread exits.
+	 */
+	static void allocate_thread_working_buffers ();
+
 	void adjust_buffering ();
 
 	bool can_internal_playback_seek (sampleoffset_t distance);
@@ -28,7 +28,7 @@
 #include "audiographer/utils/identity_vertex.h"
 
 #include <boost/ptr_container/ptr_list.hpp>
-#include <glibmm/threadpool.h>
+#include <glibmm/threads.h>
 
 namespace AudioGrapher {
 	class SampleRateConverter;
@@ -45,7 +45,7 @@ namespace AudioGrapher {
 	template <typename T> class CmdPipeWriter;
 	template <typename T> class SilenceTrimmer;
 	template <typename T> class TmpFile;
-	template <typename T> class Threader;
+	template <typename T> class Queue;
 	template <typename T> class AllocatingProcessContext;
 }
 
@@ -158,11 +158,13 @@ class LIBARDOUR_API ExportGraphBuilder
 		typedef boost::shared_ptr<AudioGrapher::SampleFormatConverter<Sample> > FloatConverterPtr;
 		typedef boost::shared_ptr<AudioGrapher::SampleFormatConverter<int> >   IntConverterPtr;
 		typedef boost::shared_ptr<AudioGrapher::SampleFormatConverter<short> > ShortConverterPtr;
+		typedef boost::shared_ptr<AudioGrapher::Queue<Sample> > QueuePtr;
 
 		FileSpec           config;
 		int                data_width;
 		boost::ptr_list<Encoder> children;
 
+		QueuePtr        queue;
 		NormalizerPtr   normalizer;
 		LimiterPtr      limiter;
 		DemoNoisePtr    demo_noise_adder;
@@ -192,7 +194,6 @@ class LIBARDOUR_API ExportGraphBuilder
 		typedef boost::shared_ptr<AudioGrapher::PeakReader> PeakReaderPtr;
 		typedef boost::shared_ptr<AudioGrapher::LoudnessReader> LoudnessReaderPtr;
 		typedef boost::shared_ptr<AudioGrapher::TmpFile<Sample> > TmpFilePtr;
-		typedef boost::shared_ptr<AudioGrapher::Threader<Sample> > ThreaderPtr;
 		typedef boost::shared_ptr<AudioGrapher::AllocatingProcessContext<Sample> > BufferPtr;
 
 		void prepare_post_processing ();
@@ -207,7 +208,6 @@ class LIBARDOUR_API ExportGraphBuilder
 		BufferPtr       buffer;
 		PeakReaderPtr   peak_reader;
 		TmpFilePtr      tmp_file;
-		ThreaderPtr     threader;
 
 		LoudnessReaderPtr    loudness_reader;
 		boost::ptr_list<SFC> children;
@@ -227,6 +227,7 @@ class LIBARDOUR_API ExportGraphBuilder
 
 	                                        private:
 		typedef boost::shared_ptr<AudioGrapher::SampleRateConverter> SRConverterPtr;
+		typedef boost::shared_ptr<AudioGrapher::Queue<Sample> > QueuePtr;
 
 		template<typename T>
 		void add_child_to_list (FileSpec const & new_config, boost::ptr_list<T> & list);
@@ -235,6 +236,7 @@ class LIBARDOUR_API ExportGraphBuilder
 		FileSpec              config;
 		boost::ptr_list<SFC>  children;
 		boost::ptr_list<Intermediate> intermediate_children;
+		QueuePtr              queue;
 		SRConverterPtr        converter;
 		samplecnt_t           max_samples_out;
 	};
@@ -297,7 +299,6 @@ class LIBARDOUR_API ExportGraphBuilder
 	bool        _realtime;
 	samplecnt_t _master_align;
 
-	Glib::ThreadPool     thread_pool;
 	Glib::Threads::Mutex engine_request_lock;
 };
 
@@ -33,6 +33,7 @@
 #include "pbd/mpmc_queue.h"
 #include "pbd/semutils.h"
 #include "pbd/g_atomic_compat.h"
+#include "pbd/work_stealing_deque.h"
 
 #include "ardour/audio_backend.h"
 #include "ardour/libardour_visibility.h"
@@ -57,10 +58,12 @@ class LIBARDOUR_API Graph : public SessionHandleRef
 {
 public:
 	Graph (Session& session);
+	~Graph ();
 
 	void trigger (GraphNode* n);
 	void rechain (boost::shared_ptr<RouteList>, GraphEdges const&);
 	bool plot (std::string const& file_name) const;
+	bool critical_path (float& predicted_usec, float& actual_usec) const;
 
 	void plot (int chain);
 	void reached_terminal_node ();
@@ -84,7 +87,10 @@ protected:
 private:
 	void reset_thread_list ();
 	void drop_threads ();
+	void drop_thread_queues ();
 	void run_one ();
+	bool pop_work (GraphNode*&);
+	void order_by_critical_path (int chain);
 	void main_thread ();
 	void prep ();
 	void dump (int chain) const;
@@ -93,7 +99,30 @@ private:
 	node_list_t _init_trigger_list[2];
 
 	PBD::MPMCQueue<GraphNode*> _trigger_queue;      ///< nodes that can be processed
-	GATOMIC_QUAL guint         _trigger_queue_size; ///< number of entries in trigger-queue
+	GATOMIC_QUAL guint         _trigger_queue_size; ///< number of entries in trigger-queue (or thread-queues)
+
+	/** Per process-thread queue, used by the work-stealing scheduler */
+	struct ThreadQueue {
+		ThreadQueue (guint i) : id (i) {}
+		guint                              id;
+		PBD::WorkStealingDeque<GraphNode*> deque;
+	};
+
+	/** One queue for each process-thread, index 0 is the main thread */
+	std::vector<ThreadQueue*> _thread_queues;
+
+	/** The queue owned by the calling process-thread */
+	static Glib::Threads::Private<ThreadQueue> _thread_queue;
+
+	/** Use _thread_queues instead of _trigger_queue, constant during a cycle */
+	bool _work_stealing;
+
+	/** Measure route DSP cost and dispatch nodes with the longest
+	 *  remaining path first, constant during a cycle */
+	bool  _critical_path_order;
+	guint _cycles_since_reorder;
+	float _predicted_critical_path; ///< usec, longest path of current chain
+	float _actual_critical_path;    ///< usec, average graph execution time
 
 	/** Start worker threads */
 	PBD::Semaphore _execution_sem;
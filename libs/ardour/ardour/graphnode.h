@@ -44,8 +44,13 @@ protected:
 	friend class Graph;
 	/** Nodes that we directly feed */
 	node_set_t _activation_set[2];
+	/** Nodes that we directly feed, in the order in which they are triggered */
+	std::vector<GraphNode*> _activation_order[2];
 	/** The number of nodes that we directly feed us (one count for each chain) */
 	gint _init_refcount[2];
+	/** Estimated time [usec] from the start of this node until
+	 *  all nodes that depend on it have completed (one for each chain) */
+	float _critical_path[2];
 };
 
 /** A node on our processing graph, ie a Route */
@@ -65,12 +70,26 @@ public:
 		finish (chain);
 	}
 
+	/** @return estimated time [usec] until all downstream nodes completed */
+	float critical_path (int chain) const { return _critical_path[chain]; }
+
+	/** @return average processing time [usec] */
+	float dsp_cost () const { return _dsp_cost; }
+
+	/** Update the running average of the processing time */
+	void
+	update_dsp_cost (float usec)
+	{
+		_dsp_cost += .05f * (usec - _dsp_cost);
+	}
+
 private:
 	void finish (int chain);
 	void process ();
 
 	boost::shared_ptr<Graph> _graph;
 	GATOMIC_QUAL gint        _refcount;
+	float                    _dsp_cost;
 };
 }
 
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _ardour_io_tasklist_h_
+#define _ardour_io_tasklist_h_
+
+#include <vector>
+#include <boost/function.hpp>
+
+#include "pbd/semutils.h"
+#include "pbd/g_atomic_compat.h"
+
+#include "ardour/libardour_visibility.h"
+
+namespace ARDOUR {
+
+/** Perform disk I/O of several tracks concurrently.
+ *
+ * The disk-readers and -writers use blocking I/O (via libsndfile),
+ * so several requests are kept in flight by issuing them from a pool
+ * of non-realtime threads. The thread calling process() takes part in
+ * processing the list.
+ *
+ * Each I/O thread has its own DiskReader working buffers.
+ */
+class LIBARDOUR_API IOTaskList
+{
+public:
+	/** @param n_threads total number of threads, including the one calling process() */
+	IOTaskList (uint32_t n_threads);
+	~IOTaskList ();
+
+	typedef std::vector<boost::function<void ()> > TaskList;
+
+	/** process tasks in list in parallel (in order of the list), wait for them to complete */
+	void process (TaskList const&);
+
+	uint32_t n_threads () const { return _threads.size () + 1; }
+
+private:
+	std::vector<pthread_t> _threads;
+	GATOMIC_QUAL gint      _terminate;
+	GATOMIC_QUAL gint      _next;
+
+	static void* _thread_run (void* arg);
+	void run ();
+	void process_tasks ();
+
+	PBD::Semaphore _task_run_sem;
+	PBD::Semaphore _task_end_sem;
+
+	TaskList const* _tasklist;
+};
+
+} // namespace ARDOUR
+#endif
@@ -151,6 +151,8 @@ public:
 
 		std::set<NotePtr> side_effect_removals;
 
+		bool extend_edit_range (TimeType& start, TimeType& end) const;
+
 		XMLNode &marshal_change(const NoteChange&);
 		NoteChange unmarshal_change(XMLNode *xml_note);
 
@@ -302,6 +304,13 @@ public:
 	PBD::Signal0<void> ContentsChanged;
 	PBD::Signal1<void, Temporal::timecnt_t> ContentsShifted;
 
+	/** While ContentsChanged is emitted by a NoteDiffCommand, this
+	 * provides the range of note-on and note-off times that the command
+	 * changed. Otherwise it returns false and any part of the model
+	 * may have changed.
+	 */
+	bool edited_notes (TimeType& start, TimeType& end) const;
+
 	boost::shared_ptr<const MidiSource> midi_source ();
 	void set_midi_source (boost::shared_ptr<MidiSource>);
 
@@ -346,11 +355,17 @@ private:
 
 	void control_list_marked_dirty ();
 
+	void notes_changed (TimeType start, TimeType end);
+
 	PBD::ScopedConnectionList _midi_source_connections;
 
 	// We cannot use a boost::shared_ptr here to avoid a retain cycle
 	boost::weak_ptr<MidiSource> _midi_source;
 	InsertMergePolicy _insert_merge_policy;
+
+	bool     _edited_notes;
+	TimeType _edited_start;
+	TimeType _edited_end;
 };
 
 } /* namespace ARDOUR */
@@ -28,8 +28,14 @@
 
 #include <boost/utility.hpp>
 
+#include <glibmm/threads.h>
+
+#include "pbd/id.h"
+
 #include "evoral/Parameter.h"
 
+#include "temporal/tempo.h"
+
 #include "ardour/ardour.h"
 #include "ardour/midi_cursor.h"
 #include "ardour/midi_model.h"
@@ -87,13 +93,56 @@ public:
   protected:
 	void remove_dependents (boost::shared_ptr<Region> region);
 	void region_going_away (boost::weak_ptr<Region> region);
+	bool region_changed (const PBD::PropertyChange&, boost::shared_ptr<Region>);
 
   private:
 	void dump () const;
+	void render_range (std::vector<boost::shared_ptr<Region> > const&, MidiChannelFilter*, samplepos_t start, samplepos_t end);
+	bool render_notes (std::vector<boost::shared_ptr<Region> > const&, MidiChannelFilter*, samplepos_t start, samplepos_t end);
 
 	NoteMode     _note_mode;
 
 	RTMidiBuffer _rendered;
+
+	/* Everything besides the contents of the regions that went into
+	 * the last ::render(). As long as this does not change, an edit of
+	 * a region's model only re-renders the region's range.
+	 */
+	struct RenderedRegion {
+		RenderedRegion (boost::shared_ptr<Region> const&);
+		bool operator== (RenderedRegion const& other) const {
+			return id == other.id && source == other.source
+				&& first == other.first && last == other.last && start == other.start
+				&& layer == other.layer && muted == other.muted && opaque == other.opaque;
+		}
+
+		PBD::ID     id;
+		PBD::ID     source;
+		samplepos_t first;
+		samplepos_t last;
+		timepos_t   start;
+		layer_t     layer;
+		bool        muted;
+		bool        opaque;
+	};
+
+	std::vector<RenderedRegion>   _rendered_regions;
+	Temporal::TempoMap::SharedPtr _rendered_tempo_map;
+	MidiChannelFilter*            _rendered_filter;
+	uint32_t                      _rendered_filter_state;
+	NoteMode                      _rendered_note_mode;
+
+	/* range of region content changes since the last ::render(),
+	 * empty if _dirty_start > _dirty_end. _dirty_notes_start/end is
+	 * the range of changes that only added, removed or changed notes.
+	 * _dirty_all is set when any other property of a region changed.
+	 */
+	Glib::Threads::Mutex _dirty_lock;
+	samplepos_t          _dirty_start;
+	samplepos_t          _dirty_end;
+	samplepos_t          _dirty_notes_start;
+	samplepos_t          _dirty_notes_end;
+	bool                 _dirty_all;
 };
 
 } /* namespace ARDOUR */
@@ -25,6 +25,8 @@
 
 #include <vector>
 
+#include <glibmm/threads.h>
+
 #include "temporal/beats.h"
 #include "temporal/range.h"
 
@@ -116,6 +118,24 @@ class LIBARDOUR_API MidiRegion : public Region
 	                  timecnt_t const &               read_length,
 	                  MidiChannelFilter*              filter) const;
 
+	/** Write the note-on and note-off events that ::render() writes within
+	 * [start, end] (session samples, inclusive), including note-offs of
+	 * notes that are cut off by the end of the region. Nothing else is
+	 * written.
+	 * @return -1 if the source has no model
+	 */
+	int render_notes (Evoral::EventSink<samplepos_t>& dst,
+	                  samplepos_t                     start,
+	                  samplepos_t                     end,
+	                  MidiChannelFilter*              filter) const;
+
+	/** Get the range (in session samples) of all notes that were added,
+	 * removed or changed since the last call, and reset it. The range is
+	 * empty if start > end.
+	 * @return false if other contents of the model may have changed
+	 */
+	bool take_edited_notes (samplepos_t& start, samplepos_t& end);
+
   protected:
 
 	virtual bool can_trim_start_before_source_start () const {
@@ -158,6 +178,15 @@ class LIBARDOUR_API MidiRegion : public Region
 	PBD::ScopedConnection _source_connection;
 	PBD::ScopedConnection _model_contents_connection;
 	bool _ignore_shift;
+
+	/* range of note edits since ::take_edited_notes(), in model time,
+	 * empty if _edited_start > _edited_end. _edited_all is set if
+	 * anything but notes changed.
+	 */
+	Glib::Threads::Mutex _edited_lock;
+	Temporal::Beats      _edited_start;
+	Temporal::Beats      _edited_end;
+	bool                 _edited_all;
 };
 
 } /* namespace ARDOUR */
@@ -50,11 +50,31 @@ extern "C" {
 LIBARDOUR_API void x86_sse_avx_find_peaks               (float const* buf, uint32_t nsamples, float* min, float* max);
 #endif
 
+/* AVX functions without SSE equivalent */
+LIBARDOUR_API void  x86_avx_apply_gain_ramp             (float* buf, uint32_t nframes, float gain_start, float gain_end);
+LIBARDOUR_API void  x86_avx_interleave                  (float* dst, float const* src, uint32_t nframes, uint32_t channel, uint32_t n_channels);
+LIBARDOUR_API void  x86_avx_deinterleave                (float* dst, float const* src, uint32_t nframes, uint32_t channel, uint32_t n_channels);
+LIBARDOUR_API void  x86_avx_float_to_s32                (int32_t* dst, float const* src, uint32_t nframes);
+
 /* FMA functions */
 #ifdef FPU_AVX_FMA_SUPPORT
 LIBARDOUR_API void  x86_fma_mix_buffers_with_gain       (float* dst, float const* src, uint32_t nframes, float gain);
 #endif
 
+/* AVX-512 functions */
+#ifdef FPU_AVX512F_SUPPORT
+LIBARDOUR_API float x86_avx512f_compute_peak            (float const* buf, uint32_t nsamples, float current);
+LIBARDOUR_API void  x86_avx512f_find_peaks              (float const* buf, uint32_t nsamples, float* min, float* max);
+LIBARDOUR_API void  x86_avx512f_apply_gain_to_buffer    (float* buf, uint32_t nframes, float gain);
+LIBARDOUR_API void  x86_avx512f_mix_buffers_with_gain   (float* dst, float const* src, uint32_t nframes, float gain);
+LIBARDOUR_API void  x86_avx512f_mix_buffers_no_gain     (float* dst, float const* src, uint32_t nframes);
+LIBARDOUR_API void  x86_avx512f_copy_vector             (float* dst, float const* src, uint32_t nframes);
+LIBARDOUR_API void  x86_avx512f_apply_gain_ramp         (float* buf, uint32_t nframes, float gain_start, float gain_end);
+LIBARDOUR_API void  x86_avx512f_interleave              (float* dst, float const* src, uint32_t nframes, uint32_t channel, uint32_t n_channels);
+LIBARDOUR_API void  x86_avx512f_deinterleave            (float* dst, float const* src, uint32_t nframes, uint32_t channel, uint32_t n_channels);
+LIBARDOUR_API void  x86_avx512f_float_to_s32            (int32_t* dst, float const* src, uint32_t nframes);
+#endif
+
 /* debug wrappers for SSE functions */
 
 LIBARDOUR_API float debug_compute_peak               (ARDOUR::Sample const* buf, ARDOUR::pframes_t nsamples, float current);
@@ -96,4 +116,13 @@ LIBARDOUR_API void  default_mix_buffers_with_gain     (ARDOUR::Sample* dst, ARDO
 LIBARDOUR_API void  default_mix_buffers_no_gain       (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes);
 LIBARDOUR_API void  default_copy_vector               (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes);
 
+/** Apply a linear gain ramp from gain_start to (but excluding) gain_end */
+LIBARDOUR_API void  default_apply_gain_ramp           (ARDOUR::Sample* buf, ARDOUR::pframes_t nframes, float gain_start, float gain_end);
+/** Copy a mono buffer to channel of an interleaved buffer with n_channels */
+LIBARDOUR_API void  default_interleave                (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes, uint32_t channel, uint32_t n_channels);
+/** Copy channel of an interleaved buffer with n_channels to a mono buffer */
+LIBARDOUR_API void  default_deinterleave              (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes, uint32_t channel, uint32_t n_channels);
+/** Convert to 24bit integer, MSB aligned in 32bit, clamped to [-1, +1] */
+LIBARDOUR_API void  default_float_to_s32              (int32_t* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes);
+
 #endif /* __ardour_mix_h__ */
@@ -51,6 +51,7 @@
 #include "ardour/ardour.h"
 #include "ardour/data_type.h"
 #include "ardour/region.h"
+#include "ardour/region_interval_tree.h"
 #include "ardour/session_object.h"
 #include "ardour/thawlist.h"
 
@@ -322,10 +323,12 @@ protected:
 			if (block_notify) {
 				playlist->delay_notifications ();
 			}
+			playlist->invalidate_region_index ();
 		}
 
 		~RegionWriteLock ()
 		{
+			playlist->invalidate_region_index ();
 			Glib::Threads::RWLock::WriterLock::release ();
 			thawlist.release ();
 			if (block_notify) {
@@ -410,6 +413,12 @@ protected:
 
 	void mark_session_dirty ();
 
+	/* the caller must hold the region lock. A null pointer is returned
+	 * if the playlist cannot use an index (few regions or mixed time domains)
+	 */
+	boost::shared_ptr<RegionIntervalTree const> region_index () const;
+	void invalidate_region_index ();
+
 	void         region_changed_proxy (const PBD::PropertyChange&, boost::weak_ptr<Region>);
 	virtual bool region_changed (const PBD::PropertyChange&, boost::shared_ptr<Region>);
 
@@ -471,6 +480,10 @@ private:
 	boost::shared_ptr<RegionList> find_regions_at (timepos_t const &);
 
 	mutable boost::optional<std::pair<timepos_t, timepos_t> > _cached_extent;
+
+	mutable Glib::Threads::Mutex                        _region_index_lock;
+	mutable boost::shared_ptr<RegionIntervalTree const> _region_index;
+	mutable bool                                        _region_index_dirty;
 	timepos_t _end_space;  //this is used when we are pasting a range with extra space at the end
 	bool _playlist_shift_active;
 
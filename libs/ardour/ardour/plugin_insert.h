@@ -201,6 +201,14 @@ public:
 	bool get_stats (PBD::microseconds_t& min, PBD::microseconds_t& max, double& avg, double& dev) const;
 	void clear_stats ();
 
+	/** Per-cycle DSP time of the plugin(s) only, excluding automation and bypass */
+	bool get_plugin_dsp_timing (double& min, double& avg, double& p99, double& max) const {
+		return _plugin_timing.get_stats (min, avg, p99, max);
+	}
+
+	void allocate_timing ();
+	void reset_timing ();
+
 	/** A control that manipulates a plugin parameter (control port). */
 	struct PluginControl : public AutomationControl
 	{
@@ -443,6 +451,7 @@ private:
 	void preset_load_set_value (uint32_t, float);
 
 	PBD::TimingStats  _timing_stats;
+	ProcessorTiming   _plugin_timing;
 	GATOMIC_QUAL gint _stat_reset;
 	GATOMIC_QUAL gint _flush;
 };
@@ -357,6 +357,10 @@ private:
 	bool run_vst3_scanner_app (std::string bundle_path, PSLEPtr) const;
 #endif
 
+#if (defined WINDOWS_VST_SUPPORT || defined MACVST_SUPPORT || defined LXVST_SUPPORT || defined VST3_SUPPORT)
+	void run_scanner_apps (ARDOUR::PluginType, std::vector<std::string> const&, std::set<std::string>&);
+#endif
+
 	int ladspa_discover (std::string path);
 
 	std::string get_ladspa_category (uint32_t id);
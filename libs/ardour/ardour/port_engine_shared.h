@@ -89,6 +89,15 @@ class LIBARDOUR_API BackendPort : public ProtoPort
 		return _connections;
 	}
 
+	typedef std::vector<BackendPortPtr> ConnectionPlan;
+
+	/* Flat copy of the connections for use in the process thread,
+	 * republished (RCU) whenever a connection is made or removed.
+	 */
+	boost::shared_ptr<ConnectionPlan> connection_plan () const {
+		return _connection_plan.reader ();
+	}
+
 	int  connect (BackendPortHandle port, BackendPortHandle self);
 	int  disconnect (BackendPortHandle port, BackendPortHandle self);
 	void disconnect_all (BackendPortHandle self);
@@ -116,8 +125,11 @@ private:
 	LatencyRange           _playback_latency_range;
 	std::set<BackendPortPtr> _connections;
 
+	SerializedRCUManager<ConnectionPlan> _connection_plan;
+
 	void store_connection (BackendPortHandle);
 	void remove_connection (BackendPortHandle);
+	void update_connection_plan ();
 
 }; // class BackendPort
 
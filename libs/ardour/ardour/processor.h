@@ -31,6 +31,7 @@
 #include "ardour/ardour.h"
 #include "ardour/buffer_set.h"
 #include "ardour/latent.h"
+#include "ardour/processor_timing.h"
 #include "ardour/session_object.h"
 #include "ardour/libardour_visibility.h"
 #include "ardour/types.h"
@@ -157,6 +158,17 @@ class LIBARDOUR_API Processor : public SessionObject, public Automatable, public
 	virtual void set_owner (SessionObject*);
 	SessionObject* owner() const;
 
+	/** DSP timing of run(), collected by the Route */
+	ProcessorTiming& timing () { return _timing; }
+
+	/** Per-cycle DSP time of run() in microseconds, over the last ProcessorTiming::window_size cycles */
+	bool get_dsp_timing (double& min, double& avg, double& p99, double& max) const {
+		return _timing.get_stats (min, avg, p99, max);
+	}
+
+	virtual void allocate_timing () { _timing.allocate (); }
+	virtual void reset_timing () { _timing.reset (); }
+
 protected:
 	virtual XMLNode& state ();
 	virtual int set_state_2X (const XMLNode&, int version);
@@ -183,6 +195,8 @@ protected:
 	samplecnt_t _capture_offset;
 	samplecnt_t _playback_offset;
 	Location*   _loop_location;
+
+	ProcessorTiming _timing;
 };
 
 } // namespace ARDOUR
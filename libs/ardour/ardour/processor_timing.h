@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef __ardour_processor_timing_h__
+#define __ardour_processor_timing_h__
+
+#include <atomic>
+#include <stdint.h>
+
+#include "pbd/g_atomic_compat.h"
+#include "pbd/microseconds.h"
+
+#include "ardour/cycles.h"
+#include "ardour/libardour_visibility.h"
+
+namespace ARDOUR {
+
+/** Lock-free per-processor DSP timing collector.
+ *
+ * The process thread measures the time spent in a processor using the
+ * CPU cycle counter and stores one value per process-cycle in a
+ * fixed-size ring-buffer. Any other thread can compute statistics over
+ * the most recent cycles without interfering with the process thread.
+ *
+ * Collection is globally disabled by default. The ring-buffer is only
+ * allocated when collection is enabled, see ProcessorTiming::set_enabled
+ * and Session::set_processor_timing_enabled.
+ */
+class LIBARDOUR_API ProcessorTiming
+{
+public:
+	ProcessorTiming ();
+	~ProcessorTiming ();
+
+	/** Number of process cycles to keep (power of two) */
+	static const uint32_t window_size = 1024;
+
+	/** Enable or disable timing of all processors (not realtime safe) */
+	static void set_enabled (bool);
+	static bool enabled () { return g_atomic_int_get (&_enabled) != 0; }
+
+	/** Allocate the ring-buffer (not realtime safe) */
+	void allocate ();
+
+	/* realtime context, only called by the process thread that runs the owner */
+
+	void
+	start ()
+	{
+		if (g_atomic_int_get (&_enabled) && _window.load (std::memory_order_acquire)) {
+			_start   = now ();
+			_running = true;
+		}
+	}
+
+	void
+	stop ()
+	{
+		if (_running) {
+			_accum  += (uint32_t) (now () - _start);
+			_running = false;
+		}
+	}
+
+	/** Add time measured by other means, in ticks (see ticks_per_usec) */
+	void add (uint32_t ticks)
+	{
+		_accum += ticks;
+	}
+
+	/** Store the time accumulated since the last call in the ring-buffer */
+	void commit ();
+
+	static double ticks_per_usec () { return _ticks_per_usec; }
+
+	/* any thread */
+
+	/** Statistics of the most recent process cycles, in microseconds.
+	 * @return false if no data is available.
+	 */
+	bool get_stats (double& min, double& avg, double& p99, double& max) const;
+
+	/** Discard collected data, the process thread performs the reset */
+	void reset ()
+	{
+		g_atomic_int_set (&_reset, 1);
+	}
+
+	/** RAII helper to time a scope */
+	class Timer
+	{
+	public:
+		Timer (ProcessorTiming& t) : _t (t) { _t.start (); }
+		~Timer () { _t.stop (); }
+	private:
+		ProcessorTiming& _t;
+	};
+
+private:
+	ProcessorTiming (ProcessorTiming const&);
+	ProcessorTiming& operator= (ProcessorTiming const&);
+
+	static uint64_t
+	now ()
+	{
+		if (_use_cycle_counter) {
+			return get_cycles ();
+		}
+		return PBD::get_microseconds ();
+	}
+
+	static void calibrate ();
+
+	/* set once by allocate(), the process thread may read it any time */
+	std::atomic<uint32_t*> _window;
+
+	GATOMIC_QUAL guint _write_pos;
+	GATOMIC_QUAL gint  _reset;
+	uint64_t           _start;
+	uint32_t           _accum;
+	bool               _running;
+
+	static GATOMIC_QUAL gint _enabled;
+	static bool              _use_cycle_counter;
+	static double            _ticks_per_usec;
+};
+
+} // namespace ARDOUR
+
+#endif /* __ardour_processor_timing_h__ */
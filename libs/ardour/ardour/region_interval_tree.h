@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _ardour_region_interval_tree_h_
+#define _ardour_region_interval_tree_h_
+
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include "temporal/timeline.h"
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace ARDOUR {
+
+class Region;
+
+/** Index of the regions of a Playlist, to look up regions by position.
+ *
+ * The regions are kept in a vector sorted by position, which is
+ * traversed as implicit balanced binary tree (the root of [lo, hi) is
+ * at (lo + hi) / 2). Every node also stores the latest end of all
+ * regions in its subtree, which allows to skip subtrees that end
+ * before a given range (augmented interval tree).
+ *
+ * Lookups return candidates in order of position; the caller has to
+ * apply the exact test (Region::covers, Region::coverage).
+ *
+ * The index is immutable once built, a Playlist replaces it as a whole
+ * when its regions change.
+ */
+class LIBARDOUR_API RegionIntervalTree
+{
+public:
+	/** Build an index of the given regions.
+	 * All regions positions and lengths must use the same time domain,
+	 * see usable()
+	 */
+	RegionIntervalTree (RegionList const&);
+
+	/** @return true if the regions can be indexed. Comparing positions
+	 * that use different time domains depends on the tempo map, and
+	 * the order of the index would not be stable.
+	 */
+	static bool usable (RegionList const&);
+
+	size_t size () const { return _entries.size (); }
+
+	/** Add regions that may overlap the range [start, end] to @p rl */
+	void overlapping (timepos_t const& start, timepos_t const& end, RegionList& rl) const;
+
+	/** Add regions whose position is within [start, end) to @p rl */
+	void starting_within (timepos_t const& start, timepos_t const& end, RegionList& rl) const;
+
+	/** @return the first region with a position later than @p pos */
+	boost::shared_ptr<Region> first_starting_after (timepos_t const& pos) const;
+
+	/** @return the region with the latest position before @p pos.
+	 * If there are several regions at this position, the first one
+	 * in the playlist is returned.
+	 */
+	boost::shared_ptr<Region> last_starting_before (timepos_t const& pos) const;
+
+private:
+	struct Entry {
+		Entry (boost::shared_ptr<Region> const&);
+
+		timepos_t                 position;
+		timepos_t                 last;
+		timepos_t                 max_last; ///< latest end in subtree
+		boost::shared_ptr<Region> region;
+	};
+
+	struct EntrySortByPosition {
+		bool operator() (Entry const& a, Entry const& b) const {
+			return a.position < b.position;
+		}
+	};
+
+	timepos_t build (size_t lo, size_t hi);
+	void      overlapping (size_t lo, size_t hi, timepos_t const& start, timepos_t const& end, RegionList& rl) const;
+	size_t    lower_bound (timepos_t const& pos) const;
+	size_t    upper_bound (timepos_t const& pos) const;
+
+	std::vector<Entry> _entries;
+};
+
+} // namespace ARDOUR
+
+#endif /* _ardour_region_interval_tree_h_ */
@@ -63,6 +63,20 @@ class LIBARDOUR_API RTMidiBuffer : public Evoral::EventSink<samplepos_t>
 	uint32_t write (TimeType time, Evoral::EventType type, uint32_t size, const uint8_t* buf);
 	uint32_t read (MidiBuffer& dst, samplepos_t start, samplepos_t end, MidiNoteTracker& tracker, samplecnt_t offset = 0);
 
+	/** Replace all events with a timestamp in [start, end] (inclusive)
+	 * by the events of @p src, which must all be within that range.
+	 * The caller must hold the lock (WriteProtectRender).
+	 * Blobs of the removed events are not reclaimed until the next clear()
+	 */
+	void replace (samplepos_t start, samplepos_t end, RTMidiBuffer const& src);
+
+	/** Replace all note-on and note-off events with a timestamp in
+	 * [start, end] (inclusive) by the events of @p notes, which must all
+	 * be notes within that range, sorted by time. Other events in the
+	 * range are kept. The caller must hold the lock (WriteProtectRender).
+	 */
+	void replace_notes (samplepos_t start, samplepos_t end, RTMidiBuffer const& notes);
+
 	void dump (uint32_t);
 	void reverse ();
 	bool reversed() const;
@@ -31,6 +31,10 @@ namespace ARDOUR {
 	typedef void  (*mix_buffers_with_gain_t) (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t, float);
 	typedef void  (*mix_buffers_no_gain_t)   (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t);
 	typedef void  (*copy_vector_t)           (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t);
+	typedef void  (*apply_gain_ramp_t)       (ARDOUR::Sample *, pframes_t, float, float);
+	typedef void  (*interleave_t)            (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t, uint32_t, uint32_t);
+	typedef void  (*deinterleave_t)          (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t, uint32_t, uint32_t);
+	typedef void  (*float_to_s32_t)          (int32_t *, const ARDOUR::Sample *, pframes_t);
 
 	LIBARDOUR_API extern compute_peak_t          compute_peak;
 	LIBARDOUR_API extern find_peaks_t            find_peaks;
@@ -38,6 +42,10 @@ namespace ARDOUR {
 	LIBARDOUR_API extern mix_buffers_with_gain_t mix_buffers_with_gain;
 	LIBARDOUR_API extern mix_buffers_no_gain_t   mix_buffers_no_gain;
 	LIBARDOUR_API extern copy_vector_t           copy_vector;
+	LIBARDOUR_API extern apply_gain_ramp_t       apply_gain_ramp;
+	LIBARDOUR_API extern interleave_t            interleave;
+	LIBARDOUR_API extern deinterleave_t          deinterleave;
+	LIBARDOUR_API extern float_to_s32_t          float_to_s32;
 }
 
 #endif /* __ardour_runtime_functions_h__ */
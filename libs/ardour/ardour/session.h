@@ -107,6 +107,7 @@ class Parser;
 
 namespace PBD {
 class Controllable;
+class Thread;
 }
 
 namespace luabridge {
@@ -351,6 +352,14 @@ public:
 	uint32_t nbusses () const;
 
 	bool plot_process_graph (std::string const& file_name) const;
+	bool process_graph_critical_path (float& predicted_usec, float& actual_usec) const;
+
+	/* per processor DSP timing */
+	void set_processor_timing_enabled (bool);
+	bool processor_timing_enabled () const;
+	void reset_processor_timing ();
+	/** @return processors with timing data, sorted by 99th percentile of their per-cycle DSP time, most expensive first */
+	std::list<boost::shared_ptr<Processor> > processors_by_dsp_load (uint32_t max_count = 0) const;
 
 	boost::shared_ptr<BundleList> bundles () {
 		return _bundles.reader ();
@@ -1585,6 +1594,11 @@ private:
 
 	Glib::Threads::Mutex save_state_lock;
 	Glib::Threads::Mutex save_source_lock;
+
+	PBD::Thread* _pending_save_thread; ///< writes the file of a pending save_state()
+	void         wait_for_pending_save ();
+	void         remove_pending_capture_state_locked ();
+
 	Glib::Threads::Mutex peak_cleanup_lock;
 
 	int        load_options (const XMLNode&);
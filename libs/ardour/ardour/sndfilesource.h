@@ -89,8 +89,21 @@ class LIBARDOUR_API SndFileSource : public AudioFileSource {
 	SF_INFO _info;
 	BroadcastInfo *_broadcast_info;
 
+	/* read-only float WAV/RF64 files are memory-mapped and read directly,
+	 * bypassing libsndfile.
+	 */
+	uint8_t*            _map_addr;
+	size_t              _map_length;
+	size_t              _map_data_offset;
+	mutable samplepos_t _map_last_read;
+	mutable int         _map_direction;
+
 	void init_sndfile ();
 	int open();
+	void map_file ();
+	void unmap_file ();
+	samplecnt_t read_mapped (Sample* dst, samplepos_t start, samplecnt_t cnt) const;
+	void advise_read_ahead (samplepos_t start, samplecnt_t cnt) const;
 	int setup_broadcast_info (samplepos_t when, struct tm&, time_t);
 	void file_closed ();
 
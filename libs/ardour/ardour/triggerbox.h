@@ -43,6 +43,7 @@
 #include "evoral/PatchChange.h"
 #include "evoral/SMF.h"
 
+#include "ardour/audio_clip_cache.h"
 #include "ardour/midi_model.h"
 #include "ardour/midi_state_tracker.h"
 #include "ardour/processor.h"
@@ -509,12 +510,19 @@ class LIBARDOUR_API AudioTrigger : public Trigger {
 
 	bool stretching () const;
 
+	/* called by the TriggerBoxThread */
+	void render_wanted_stretch ();
+
   protected:
 	void retrigger ();
 
   private:
+	/* The samples are owned by the clip, which may be shared with
+	 * other triggers (see AudioClipCache). They must not be modified.
+	 */
 	struct Data : std::vector<Sample*> {
-		samplecnt_t length;
+		samplecnt_t             length;
+		AudioClipCache::ClipPtr clip;
 
 		Data () : length (0) {}
 	};
@@ -523,6 +531,43 @@ class LIBARDOUR_API AudioTrigger : public Trigger {
 	RubberBand::RubberBandStretcher*  _stretcher;
 	samplepos_t _start_offset;
 
+	/* A copy of the data that was stretched offline to a given tempo,
+	 * rendered by the TriggerBoxThread. It is played instead of
+	 * stretching in realtime while the tempo matches.
+	 */
+	struct Stretched {
+		AudioClipCache::Clip    data;
+		AudioClipCache::ClipPtr source;
+		double                  ratio;
+		double                  segment_tempo;
+		double                  bpm;
+		StretchMode             mode;
+
+		bool matches (AudioClipCache::Clip const* c, double st, double b, StretchMode m) const {
+			return source.get() == c && segment_tempo == st && bpm == b && mode == m;
+		}
+	};
+
+	std::atomic<Stretched*> _stretched;        /* most recent copy, set by the worker */
+	std::atomic<Stretched*> _stretched_in_use; /* may be used by the process thread, must not be deleted */
+	std::vector<Stretched*> _stretched_all;    /* all copies, only used by the worker */
+	Stretched const*        _prestretched;     /* copy used for the current pass, if any */
+	bool                    _select_stretched;
+
+	/* The copy wanted by the process thread. It is written by the process
+	 * thread only, and polled by the TriggerBoxThread. _wanted_seq is odd
+	 * while the fields are being written.
+	 */
+	std::atomic<uint32_t>                    _wanted_seq;
+	std::atomic<AudioClipCache::Clip const*> _wanted_clip;
+	std::atomic<double>                      _wanted_tempo;
+	std::atomic<double>                      _wanted_bpm;
+	std::atomic<int>                         _wanted_mode;
+	uint32_t                                 _rendered_seq; /* only used by the worker */
+
+	void select_stretched (double bpm);
+	void render_stretched (AudioClipCache::ClipPtr, double segment_tempo, double bpm, StretchMode);
+
 
 	/* computed during run */
 
@@ -641,6 +686,13 @@ class LIBARDOUR_API TriggerBoxThread
 	void set_region (TriggerBox&, uint32_t slot, boost::shared_ptr<Region>);
 	void request_delete_trigger (Trigger* t);
 
+	/* AudioTriggers that may ask for a stretched copy of their data,
+	 * see AudioTrigger::select_stretched(). Not RT-safe.
+	 */
+	void add_audio_trigger (AudioTrigger*);
+	void remove_audio_trigger (AudioTrigger*);
+
+	/* wake up the worker, RT-safe */
 	void summon();
 	void stop();
 	void wait_until_finished();
@@ -652,7 +704,8 @@ class LIBARDOUR_API TriggerBoxThread
 	enum RequestType {
 		Quit,
 		SetRegion,
-		DeleteTrigger
+		DeleteTrigger,
+		Render
 	};
 
 	struct Request {
@@ -680,6 +733,10 @@ class LIBARDOUR_API TriggerBoxThread
 	CrossThreadChannel _xthread;
 	void queue_request (Request*);
 	void delete_trigger (Trigger*);
+
+	Glib::Threads::Mutex       _audio_triggers_lock;
+	std::vector<AudioTrigger*> _audio_triggers;
+	void render_stretched ();
 };
 
 struct CueRecord {
@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <boost/bind.hpp>
+
+#include "pbd/compose.h"
+
+#include "ardour/audio_clip_cache.h"
+#include "ardour/audioregion.h"
+#include "ardour/debug.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/source.h"
+
+using namespace ARDOUR;
+
+AudioClipCache* AudioClipCache::_instance = 0;
+
+AudioClipCache::Clip::~Clip ()
+{
+	for (iterator i = begin (); i != end (); ++i) {
+		delete [] *i;
+	}
+}
+
+bool
+AudioClipCache::Key::operator< (Key const& other) const
+{
+	if (start != other.start) {
+		return start < other.start;
+	}
+	if (length != other.length) {
+		return length < other.length;
+	}
+	if (sample_rate != other.sample_rate) {
+		return sample_rate < other.sample_rate;
+	}
+	return sources < other.sources;
+}
+
+AudioClipCache&
+AudioClipCache::instance ()
+{
+	if (!_instance) {
+		_instance = new AudioClipCache;
+	}
+	return *_instance;
+}
+
+AudioClipCache::AudioClipCache ()
+	: _size (0)
+	, _use_count (0)
+{
+}
+
+static bool
+read_region (boost::shared_ptr<AudioRegion> ar, AudioClipCache::Clip& clip)
+{
+	const uint32_t nchans = ar->n_channels ();
+	for (uint32_t n = 0; n < nchans; ++n) {
+		clip.push_back (new Sample[clip.length]);
+		ar->read (clip[n], 0, clip.length, n);
+	}
+	return true;
+}
+
+AudioClipCache::ClipPtr
+AudioClipCache::get (boost::shared_ptr<AudioRegion> ar, samplecnt_t sample_rate)
+{
+	Key key;
+	key.start       = ar->start_sample ();
+	key.length      = ar->length_samples ();
+	key.sample_rate = sample_rate;
+
+	const uint32_t nchans = ar->n_channels ();
+	for (uint32_t n = 0; n < nchans; ++n) {
+		key.sources.push_back (ar->source (n)->id ());
+	}
+
+	return get (key, ar->name (), boost::bind (&read_region, ar, _1), (size_t) Config->get_clip_cache_size () << 20);
+}
+
+AudioClipCache::ClipPtr
+AudioClipCache::get (Key const& key, std::string const& name, Reader const& read, size_t limit)
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	Clips::iterator i;
+
+	/* wait while another thread decodes the same data */
+	while ((i = _clips.find (key)) != _clips.end () && i->second.loading) {
+		_loaded.wait (_lock);
+	}
+
+	if (i != _clips.end ()) {
+		DEBUG_TRACE (DEBUG::Triggers, string_compose ("clip cache hit for %1\n", name));
+		i->second.last_use = ++_use_count;
+		return i->second.clip;
+	}
+
+	/* Decoding may take a while. Other triggers can (and usually do)
+	 * ask for the same data meanwhile, they wait for this entry. Others
+	 * only need the lock to look up or add their own clip.
+	 */
+	_clips.insert (std::make_pair (key, Entry ()));
+
+	boost::shared_ptr<Clip> clip (new Clip);
+	clip->length = key.length;
+
+	lm.release ();
+
+	bool ok;
+	try {
+		ok = read (*clip);
+	} catch (...) {
+		ok = false;
+	}
+
+	lm.acquire ();
+
+	i = _clips.find (key);
+	assert (i != _clips.end () && i->second.loading);
+
+	if (!ok) {
+		/* waiting threads will try again */
+		_clips.erase (i);
+		_loaded.broadcast ();
+		return ClipPtr ();
+	}
+
+	Entry& e   = i->second;
+	e.clip     = clip;
+	e.bytes    = clip->size () * clip->length * sizeof (Sample);
+	e.last_use = ++_use_count;
+	e.loading  = false;
+	_size     += e.bytes;
+
+	_loaded.broadcast ();
+
+	DEBUG_TRACE (DEBUG::Triggers, string_compose ("clip cache: added %1 (%2 bytes), total %3\n", name, e.bytes, _size));
+
+	trim_locked (limit);
+
+	return clip;
+}
+
+void
+AudioClipCache::trim ()
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	trim_locked ((size_t) Config->get_clip_cache_size () << 20);
+}
+
+void
+AudioClipCache::clear ()
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	trim_locked (0);
+}
+
+size_t
+AudioClipCache::size () const
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	return _size;
+}
+
+void
+AudioClipCache::trim_locked (size_t limit)
+{
+	while (_size > limit) {
+		/* find the least recently used clip, that is not used by any trigger */
+		Clips::iterator lru = _clips.end ();
+		for (Clips::iterator i = _clips.begin (); i != _clips.end (); ++i) {
+			if (i->second.loading || !i->second.clip.unique ()) {
+				continue;
+			}
+			if (lru == _clips.end () || i->second.last_use < lru->second.last_use) {
+				lru = i;
+			}
+		}
+
+		if (lru == _clips.end ()) {
+			/* everything is in use */
+			break;
+		}
+
+		_size -= lru->second.bytes;
+		_clips.erase (lru);
+	}
+}
@@ -755,6 +755,9 @@ AudioSource::build_peaks_from_scratch ()
 {
 	const samplecnt_t bufsize = 65536; // 256kB per disk read for mono data is about ideal
 
+	/* every read produces complete peaks, so there are never leftovers */
+	assert (bufsize % _FPP == 0);
+
 	DEBUG_TRACE (DEBUG::Peaks, "Building peaks from scratch\n");
 
 	int ret = -1;
@@ -772,7 +775,21 @@ AudioSource::build_peaks_from_scratch ()
 		samplecnt_t cnt = _length.samples();
 
 		_peaks_built = false;
+		_peak_byte_max = 0;
+
+		/* allocate the complete file once, rather than extending it
+		 * with every write. This also allows to read peaks of parts
+		 * that are already done while building continues.
+		 */
+		const off_t peak_length = ((cnt + _FPP - 1) / _FPP) * sizeof (PeakData);
+		if (ftruncate (_peakfile_fd, peak_length)) {
+			/* not fatal, the file will grow with every write */
+			warning << string_compose (_("could not pre-allocate peakfile %1 to %2 (error: %3)"),
+			                           _peakpath, peak_length, errno) << endmsg;
+		}
+
 		boost::scoped_array<Sample> buf(new Sample[bufsize]);
+		boost::scoped_array<PeakData> peakbuf(new PeakData[bufsize / _FPP]);
 
 		while (cnt) {
 
@@ -794,10 +811,35 @@ AudioSource::build_peaks_from_scratch ()
 				goto out;
 			}
 
-			if (compute_and_write_peaks (buf.get(), current_sample, samples_read, true, false, _FPP)) {
+			/* compute peaks, the last one may be incomplete */
+			samplecnt_t npeaks = 0;
+			for (samplecnt_t n = 0; n < samples_read; n += _FPP, ++npeaks) {
+				const samplecnt_t this_time = min ((samplecnt_t) _FPP, samples_read - n);
+				peakbuf[npeaks].min = buf[n];
+				peakbuf[npeaks].max = buf[n];
+				if (this_time > 1) {
+					ARDOUR::find_peaks (&buf[n + 1], this_time - 1, &peakbuf[npeaks].min, &peakbuf[npeaks].max);
+				}
+			}
+
+			const off_t   first_peak_byte = (current_sample / _FPP) * sizeof (PeakData);
+			const ssize_t bytes_to_write  = npeaks * sizeof (PeakData);
+
+			if (lseek (_peakfile_fd, first_peak_byte, SEEK_SET) != first_peak_byte
+			    || ::write (_peakfile_fd, peakbuf.get(), bytes_to_write) != bytes_to_write) {
+				error << string_compose(_("%1: could not write peak file data (%2)"), _name, strerror (errno)) << endmsg;
+				lp.acquire();
 				break;
 			}
 
+			_peak_byte_max = max (_peak_byte_max, (off_t) (first_peak_byte + bytes_to_write));
+
+			{
+				/* let the GUI update the waveform of this part */
+				Glib::Threads::Mutex::Lock lm (_peaks_ready_lock);
+				PeakRangeReady (current_sample, samples_read); /* EMIT SIGNAL */
+			}
+
 			current_sample += samples_read;
 			cnt -= samples_read;
 
@@ -64,6 +64,7 @@ static void dumpit (const AutomationList& al, string prefix = "")
 AutomationList::AutomationList (const Evoral::Parameter& id, const Evoral::ParameterDescriptor& desc, Temporal::TimeDomain time_domain)
 	: ControlList(id, desc, time_domain)
 	, _before (0)
+	, _events_xml_count (0)
 {
 	_state = Off;
 	g_atomic_int_set (&_touching, 0);
@@ -78,6 +79,7 @@ AutomationList::AutomationList (const Evoral::Parameter& id, const Evoral::Param
 AutomationList::AutomationList (const Evoral::Parameter& id, Temporal::TimeDomain time_domain)
 	: ControlList(id, ARDOUR::ParameterDescriptor(id), time_domain)
 	, _before (0)
+	, _events_xml_count (0)
 {
 	_state = Off;
 	g_atomic_int_set (&_touching, 0);
@@ -93,6 +95,7 @@ AutomationList::AutomationList (const AutomationList& other)
 	: ControlList(other)
 	, StatefulDestructible()
 	, _before (0)
+	, _events_xml_count (0)
 {
 	_state = other._state;
 	g_atomic_int_set (&_touching, other.touching());
@@ -106,6 +109,7 @@ AutomationList::AutomationList (const AutomationList& other)
 AutomationList::AutomationList (const AutomationList& other, timepos_t const & start, timepos_t const & end)
 	: ControlList(other, start, end)
 	, _before (0)
+	, _events_xml_count (0)
 {
 	_state = other._state;
 	g_atomic_int_set (&_touching, other.touching());
@@ -122,6 +126,7 @@ AutomationList::AutomationList (const AutomationList& other, timepos_t const & s
 AutomationList::AutomationList (const XMLNode& node, Evoral::Parameter id)
 	: ControlList(id, ARDOUR::ParameterDescriptor(id), Temporal::AudioTime) /* domain may change in ::set_state */
 	, _before (0)
+	, _events_xml_count (0)
 {
 	g_atomic_int_set (&_touching, 0);
 	_interpolation = default_interpolation ();
@@ -367,23 +372,41 @@ XMLNode&
 AutomationList::serialize_events (bool need_lock)
 {
 	XMLNode* node = new XMLNode (X_("events"));
-	stringstream str;
 
 	Glib::Threads::RWLock::ReaderLock lm (Evoral::ControlList::_lock, Glib::Threads::NOT_LOCK);
 	if (need_lock) {
 		lm.acquire ();
 	}
-	for (iterator xx = _events.begin(); xx != _events.end(); ++xx) {
-		str << PBD::to_string ((*xx)->when);
-		str << ' ';
-		str << PBD::to_string ((*xx)->value);
-		str << '\n';
+
+	/* Formatting the events is the bulk of saving a session with dense
+	 * automation. Re-use the string from the previous save unless the
+	 * events were modified since. The cache is skipped if another thread
+	 * is using it (snapshot_history() may be called concurrently).
+	 */
+	Glib::Threads::Mutex::Lock cl (_events_xml_lock, Glib::Threads::TRY_LOCK);
+	std::string events;
+
+	if (cl.locked () && _events_xml_count == edit_count () && !_events_xml.empty ()) {
+		events = _events_xml;
+	} else {
+		stringstream str;
+		for (iterator xx = _events.begin(); xx != _events.end(); ++xx) {
+			str << PBD::to_string ((*xx)->when);
+			str << ' ';
+			str << PBD::to_string ((*xx)->value);
+			str << '\n';
+		}
+		events = str.str ();
+		if (cl.locked ()) {
+			_events_xml       = events;
+			_events_xml_count = edit_count ();
+		}
 	}
 
 	/* XML is a bit wierd */
 
 	XMLNode* content_node = new XMLNode (X_("foo")); /* it gets renamed by libxml when we set content */
-	content_node->set_content (str.str());
+	content_node->set_content (events);
 
 	node->add_child_nocopy (*content_node);
 
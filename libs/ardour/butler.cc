@@ -20,6 +20,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
 #include <errno.h>
 #include <fcntl.h>
 #include <unistd.h>
@@ -39,6 +40,7 @@
 #include "ardour/disk_io.h"
 #include "ardour/disk_reader.h"
 #include "ardour/io.h"
+#include "ardour/io_tasklist.h"
 #include "ardour/session.h"
 #include "ardour/track.h"
 #include "ardour/auditioner.h"
@@ -58,8 +60,13 @@ Butler::Butler(Session& s)
 	, _midi_buffer_size(0)
 	, pool_trash(16)
 	, _xthread (true)
+	, _io_tasklist (0)
 {
 	g_atomic_int_set (&should_do_transport_work, 0);
+	g_atomic_int_set (&_io_started, 0);
+	g_atomic_int_set (&_io_unfinished, 0);
+	g_atomic_int_set (&_io_preempted, 0);
+	g_atomic_int_set (&_io_errors, 0);
 	SessionEvent::pool->set_trash (&pool_trash);
 
 	/* catch future changes to parameters */
@@ -159,6 +166,8 @@ Butler::terminate_thread ()
 		queue_request (Request::Quit);
 		pthread_join (thread, &status);
 	}
+	delete _io_tasklist;
+	_io_tasklist = 0;
 }
 
 void *
@@ -175,7 +184,6 @@ Butler::thread_work ()
 	uint32_t err = 0;
 
 	bool disk_work_outstanding = false;
-	RouteList::iterator i;
 
 	while (true) {
 		DEBUG_TRACE (DEBUG::Butler, string_compose ("%1 butler main loop, disk work outstanding ? %2 @ %3\n", DEBUG_THREAD_SELF, disk_work_outstanding, g_get_monotonic_time()));
@@ -250,44 +258,11 @@ Butler::thread_work ()
 		RouteList rl_with_auditioner = *rl;
 		rl_with_auditioner.push_back (_session.the_auditioner());
 
-		DEBUG_TRACE (DEBUG::Butler, string_compose ("butler starts refill loop, twr = %1\n", transport_work_requested()));
-
-		for (i = rl_with_auditioner.begin(); !transport_work_requested() && should_run && i != rl_with_auditioner.end(); ++i) {
-
-			boost::shared_ptr<Track> tr = boost::dynamic_pointer_cast<Track> (*i);
-
-			if (!tr) {
-				continue;
-			}
-
-			boost::shared_ptr<IO> io = tr->input ();
-
-			if (io && !io->active()) {
-				/* don't read inactive tracks */
-				// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler skips inactive track %1\n", tr->name()));
-				continue;
-			}
-			// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler refills %1, playback load = %2\n", tr->name(), tr->playback_buffer_load()));
-			switch (tr->do_refill ()) {
-			case 0:
-				//DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill done %1\n", tr->name()));
-				break;
-
-			case 1:
-				DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill unfinished %1\n", tr->name()));
-				disk_work_outstanding = true;
-				break;
-
-			default:
-				error << string_compose(_("Butler read ahead failure on dstream %1"), (*i)->name()) << endmsg;
-                                std::cerr << string_compose(_("Butler read ahead failure on dstream %1"), (*i)->name()) << std::endl;
-				break;
-			}
+		reset_io_tasklist ();
 
-		}
+		DEBUG_TRACE (DEBUG::Butler, string_compose ("butler starts refill loop, twr = %1\n", transport_work_requested()));
 
-		if (i != rl_with_auditioner.begin() && i != rl_with_auditioner.end()) {
-			/* we didn't get to all the streams */
+		if (refill_tracks (rl_with_auditioner)) {
 			disk_work_outstanding = true;
 		}
 
@@ -335,14 +310,128 @@ Butler::thread_work ()
 	return (0);
 }
 
+namespace {
+	typedef std::pair<float, boost::shared_ptr<Track> > TrackLoad;
+
+	struct TrackLoadSorter {
+		bool operator() (TrackLoad const& a, TrackLoad const& b) const {
+			return a.first < b.first;
+		}
+	};
+}
+
+void
+Butler::reset_io_tasklist ()
+{
+	uint32_t n_threads = std::max<uint32_t> (1, Config->get_butler_threads ());
+	if (_io_tasklist && _io_tasklist->n_threads () == n_threads) {
+		return;
+	}
+	delete _io_tasklist;
+	_io_tasklist = new IOTaskList (n_threads);
+}
+
+/** @return true if pending disk I/O tasks should not be started */
 bool
-Butler::flush_tracks_to_disk_normal (boost::shared_ptr<RouteList> rl, uint32_t& errors)
+Butler::io_preempted ()
 {
-	bool disk_work_outstanding = false;
+	if (transport_work_requested () || !should_run) {
+		g_atomic_int_set (&_io_preempted, 1);
+		return true;
+	}
+	g_atomic_int_inc (&_io_started);
+	return false;
+}
+
+/** Refill the playback buffers of all active tracks in @param rl
+ * @return true if there is more work to do.
+ */
+bool
+Butler::refill_tracks (RouteList const& rl)
+{
+	/* refill the emptiest buffers first, those are the ones most likely
+	 * to underrun, and after a locate are required before playback
+	 * can start.
+	 */
+	std::vector<TrackLoad> loads;
+	loads.reserve (rl.size ());
+
+	for (RouteList::const_iterator i = rl.begin(); i != rl.end(); ++i) {
+		boost::shared_ptr<Track> tr = boost::dynamic_pointer_cast<Track> (*i);
+
+		if (!tr) {
+			continue;
+		}
+
+		boost::shared_ptr<IO> io = tr->input ();
+
+		if (io && !io->active()) {
+			/* don't read inactive tracks */
+			continue;
+		}
+
+		loads.push_back (TrackLoad (tr->playback_buffer_load (), tr));
+	}
+
+	std::stable_sort (loads.begin (), loads.end (), TrackLoadSorter ());
+
+	IOTaskList::TaskList tl;
+	tl.reserve (loads.size ());
+
+	for (std::vector<TrackLoad>::const_iterator i = loads.begin (); i != loads.end (); ++i) {
+		tl.push_back (boost::bind (&Butler::refill_track, this, i->second));
+	}
+
+	g_atomic_int_set (&_io_started, 0);
+	g_atomic_int_set (&_io_unfinished, 0);
+	g_atomic_int_set (&_io_preempted, 0);
+
+	_io_tasklist->process (tl);
 
-	for (RouteList::iterator i = rl->begin(); !transport_work_requested() && should_run && i != rl->end(); ++i) {
+	bool disk_work_outstanding = g_atomic_int_get (&_io_unfinished) != 0;
 
-		// cerr << "write behind for " << (*i)->name () << endl;
+	size_t started = g_atomic_int_get (&_io_started);
+
+	if (g_atomic_int_get (&_io_preempted) && started > 0 && started < tl.size ()) {
+		/* we didn't get to all the streams */
+		disk_work_outstanding = true;
+	}
+
+	return disk_work_outstanding;
+}
+
+void
+Butler::refill_track (boost::shared_ptr<Track> tr)
+{
+	if (io_preempted ()) {
+		return;
+	}
+
+	// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler refills %1, playback load = %2\n", tr->name(), tr->playback_buffer_load()));
+	switch (tr->do_refill ()) {
+	case 0:
+		//DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill done %1\n", tr->name()));
+		break;
+
+	case 1:
+		DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill unfinished %1\n", tr->name()));
+		g_atomic_int_set (&_io_unfinished, 1);
+		break;
+
+	default:
+		error << string_compose(_("Butler read ahead failure on dstream %1"), tr->name()) << endmsg;
+		std::cerr << string_compose(_("Butler read ahead failure on dstream %1"), tr->name()) << std::endl;
+		break;
+	}
+}
+
+bool
+Butler::flush_tracks_to_disk_normal (boost::shared_ptr<RouteList> rl, uint32_t& errors)
+{
+	IOTaskList::TaskList tl;
+	tl.reserve (rl->size ());
+
+	for (RouteList::iterator i = rl->begin(); i != rl->end(); ++i) {
 
 		boost::shared_ptr<Track> tr = boost::dynamic_pointer_cast<Track> (*i);
 
@@ -353,31 +442,48 @@ Butler::flush_tracks_to_disk_normal (boost::shared_ptr<RouteList> rl, uint32_t&
 		/* note that we still try to flush diskstreams attached to inactive routes
 		 */
 
-		int ret;
+		tl.push_back (boost::bind (&Butler::flush_track, this, tr));
+	}
 
-		// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler flushes track %1 capture load %2\n", tr->name(), tr->capture_buffer_load()));
-		ret = tr->do_flush (ButlerContext, false);
-		switch (ret) {
-		case 0:
-			//DEBUG_TRACE (DEBUG::Butler, string_compose ("\tflush complete for %1\n", tr->name()));
-			break;
+	g_atomic_int_set (&_io_started, 0);
+	g_atomic_int_set (&_io_unfinished, 0);
+	g_atomic_int_set (&_io_preempted, 0);
+	g_atomic_int_set (&_io_errors, 0);
 
-		case 1:
-			//DEBUG_TRACE (DEBUG::Butler, string_compose ("\tflush not finished for %1\n", tr->name()));
-			disk_work_outstanding = true;
-			break;
-
-		default:
-			errors++;
-			error << string_compose(_("Butler write-behind failure on dstream %1"), (*i)->name()) << endmsg;
-			std::cerr << string_compose(_("Butler write-behind failure on dstream %1"), (*i)->name()) << std::endl;
-			/* don't break - try to flush all streams in case they
-			   are split across disks.
-			*/
-		}
+	/* capture of all tracks is written concurrently */
+	_io_tasklist->process (tl);
+
+	errors += g_atomic_int_get (&_io_errors);
+
+	return g_atomic_int_get (&_io_unfinished) != 0;
+}
+
+void
+Butler::flush_track (boost::shared_ptr<Track> tr)
+{
+	if (io_preempted ()) {
+		return;
 	}
 
-	return disk_work_outstanding;
+	// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler flushes track %1 capture load %2\n", tr->name(), tr->capture_buffer_load()));
+	switch (tr->do_flush (ButlerContext, false)) {
+	case 0:
+		//DEBUG_TRACE (DEBUG::Butler, string_compose ("\tflush complete for %1\n", tr->name()));
+		break;
+
+	case 1:
+		//DEBUG_TRACE (DEBUG::Butler, string_compose ("\tflush not finished for %1\n", tr->name()));
+		g_atomic_int_set (&_io_unfinished, 1);
+		break;
+
+	default:
+		g_atomic_int_inc (&_io_errors);
+		error << string_compose(_("Butler write-behind failure on dstream %1"), tr->name()) << endmsg;
+		std::cerr << string_compose(_("Butler write-behind failure on dstream %1"), tr->name()) << std::endl;
+		/* don't break - try to flush all streams in case they
+		   are split across disks.
+		*/
+	}
 }
 
 void
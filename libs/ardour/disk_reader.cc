@@ -19,6 +19,8 @@
 
 #include <boost/smart_ptr/scoped_array.hpp>
 
+#include <glibmm/threads.h>
+
 #include "pbd/enumwriter.h"
 #include "pbd/memento_command.h"
 #include "pbd/playback_buffer.h"
@@ -57,6 +59,29 @@ DiskReader::Declicker DiskReader::loop_declick_in;
 DiskReader::Declicker DiskReader::loop_declick_out;
 samplecnt_t           DiskReader::loop_fade_length (0);
 
+namespace {
+	struct WorkingBuffers {
+		WorkingBuffers ()
+			: sum_buffer (new Sample[2 * 1048576])
+			, mixdown_buffer (new Sample[2 * 1048576])
+			, gain_buffer (new gain_t[2 * 1048576])
+		{}
+
+		~WorkingBuffers ()
+		{
+			delete[] sum_buffer;
+			delete[] mixdown_buffer;
+			delete[] gain_buffer;
+		}
+
+		Sample* sum_buffer;
+		Sample* mixdown_buffer;
+		gain_t* gain_buffer;
+	};
+
+	Glib::Threads::Private<WorkingBuffers> thread_working_buffers;
+}
+
 DiskReader::DiskReader (Session& s, Track& t, string const& str,  Temporal::TimeDomain td, DiskIOProcessor::Flag f)
 	: DiskIOProcessor (s, t, X_("player:") + str, f, td)
 	, overwrite_sample (0)
@@ -146,6 +171,14 @@ DiskReader::free_working_buffers ()
 	_gain_buffer    = 0;
 }
 
+void
+DiskReader::allocate_thread_working_buffers ()
+{
+	if (!thread_working_buffers.get ()) {
+		thread_working_buffers.set (new WorkingBuffers);
+	}
+}
+
 samplecnt_t
 DiskReader::default_chunk_samples ()
 {
@@ -1097,6 +1130,11 @@ int
 DiskReader::do_refill ()
 {
 	const bool reversed = !_session.transport_will_roll_forwards ();
+
+	WorkingBuffers* wb = thread_working_buffers.get ();
+	if (wb) {
+		return refill (wb->sum_buffer, wb->mixdown_buffer, wb->gain_buffer, 0, reversed);
+	}
 	return refill (_sum_buffer, _mixdown_buffer, _gain_buffer, 0, reversed);
 }
 
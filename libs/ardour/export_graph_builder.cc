@@ -29,7 +29,6 @@
 
 #include "pbd/uuid.h"
 #include "pbd/file_utils.h"
-#include "pbd/cpus.h"
 
 #include "audiographer/process_context.h"
 #include "audiographer/general/chunker.h"
@@ -41,10 +40,10 @@
 #include "audiographer/general/analyser.h"
 #include "audiographer/general/peak_reader.h"
 #include "audiographer/general/loudness_reader.h"
+#include "audiographer/general/queue.h"
 #include "audiographer/general/sample_format_converter.h"
 #include "audiographer/general/sr_converter.h"
 #include "audiographer/general/silence_trimmer.h"
-#include "audiographer/general/threader.h"
 #include "audiographer/sndfile/tmp_file.h"
 #include "audiographer/sndfile/tmp_file_rt.h"
 #include "audiographer/sndfile/tmp_file_sync.h"
@@ -70,7 +69,6 @@ namespace ARDOUR {
 
 ExportGraphBuilder::ExportGraphBuilder (Session const & session)
 	: session (session)
-	, thread_pool (hardware_concurrency())
 {
 	process_buffer_samples = session.engine().samples_per_cycle();
 }
@@ -441,9 +439,12 @@ ExportGraphBuilder::SFC::SFC (ExportGraphBuilder &parent, FileSpec const & new_c
 	_analyse = config.format->analyse();
 
 	float ntarget = (config.format->normalize_loudness () || !config.format->normalize()) ? 0.0 : config.format->normalize_dbfs();
+	/* encode on a thread of its own, concurrently with other SFCs */
+	queue.reset (new Queue<Sample> (max_samples));
 	normalizer.reset (new AudioGrapher::Normalizer (ntarget, max_samples));
 	limiter.reset (new AudioGrapher::Limiter (config.format->sample_rate(), channels, max_samples));
 
+	queue->add_output (normalizer);
 	normalizer->add_output (limiter);
 
 	boost::shared_ptr<AudioGrapher::ListedSource<float> > intermediate = limiter;
@@ -554,7 +555,7 @@ ExportGraphBuilder::SFC::set_peak_lufs (AudioGrapher::LoudnessReader const& lr)
 ExportGraphBuilder::FloatSinkPtr
 ExportGraphBuilder::SFC::sink ()
 {
-	return normalizer;
+	return queue;
 }
 
 void
@@ -582,6 +583,9 @@ ExportGraphBuilder::SFC::add_child (FileSpec const & new_config)
 void
 ExportGraphBuilder::SFC::remove_children (bool remove_out_files)
 {
+	/* the writers may still be in use by the queue's thread */
+	queue->drain ();
+
 	boost::ptr_list<Encoder>::iterator iter = children.begin ();
 
 	while (iter != children.end() ) {
@@ -640,7 +644,6 @@ ExportGraphBuilder::Intermediate::Intermediate (ExportGraphBuilder & parent, Fil
 
 	peak_reader.reset (new PeakReader ());
 	loudness_reader.reset (new LoudnessReader (config.format->sample_rate(), channels, max_samples));
-	threader.reset (new Threader<Sample> (parent.thread_pool));
 
 	int format = ExportFormatBase::F_RAW | ExportFormatBase::SF_Float;
 
@@ -687,7 +690,6 @@ ExportGraphBuilder::Intermediate::add_child (FileSpec const & new_config)
 	}
 
 	children.push_back (new SFC (parent, new_config, max_samples_out));
-	threader->add_output (children.back().sink());
 }
 
 void
@@ -731,9 +733,10 @@ ExportGraphBuilder::Intermediate::prepare_post_processing()
 		if (use_loudness) {
 			(*i).set_peak_lufs (*loudness_reader);
 		}
+		/* each SFC queues the data and processes it on its own thread */
+		tmp_file->add_output ((*i).sink());
 	}
 
-	tmp_file->add_output (threader);
 	parent.intermediates.push_back (this);
 }
 
@@ -776,12 +779,25 @@ ExportGraphBuilder::SRC::SRC (ExportGraphBuilder & parent, FileSpec const & new_
 	converter->init (parent.session.nominal_sample_rate(), format.sample_rate(), format.src_quality());
 	max_samples_out = converter->allocate_buffers (max_samples);
 
+	if (!parent._realtime) {
+		/* resample on a thread of its own, this blocks the freewheel
+		 * callback when the SRC (or any of its SFCs) falls behind.
+		 * Realtime export writes to TmpFileRt, which is asynchronous
+		 * already, and must not block.
+		 */
+		queue.reset (new Queue<Sample> (max_samples));
+		queue->add_output (converter);
+	}
+
 	add_child (new_config);
 }
 
 ExportGraphBuilder::FloatSinkPtr
 ExportGraphBuilder::SRC::sink ()
 {
+	if (queue) {
+		return queue;
+	}
 	return converter;
 }
 
@@ -798,6 +814,10 @@ ExportGraphBuilder::SRC::add_child (FileSpec const & new_config)
 void
 ExportGraphBuilder::SRC::remove_children (bool remove_out_files)
 {
+	if (queue) {
+		queue->drain ();
+	}
+
 	boost::ptr_list<SFC>::iterator sfc_iter = children.begin();
 
 	while (sfc_iter != children.end() ) {
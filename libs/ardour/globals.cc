@@ -154,6 +154,10 @@ apply_gain_to_buffer_t  ARDOUR::apply_gain_to_buffer  = 0;
 mix_buffers_with_gain_t ARDOUR::mix_buffers_with_gain = 0;
 mix_buffers_no_gain_t   ARDOUR::mix_buffers_no_gain   = 0;
 copy_vector_t           ARDOUR::copy_vector           = 0;
+apply_gain_ramp_t       ARDOUR::apply_gain_ramp       = 0;
+interleave_t            ARDOUR::interleave            = 0;
+deinterleave_t          ARDOUR::deinterleave          = 0;
+float_to_s32_t          ARDOUR::float_to_s32          = 0;
 
 PBD::Signal1<void, std::string>                    ARDOUR::BootMessage;
 PBD::Signal3<void, std::string, std::string, bool> ARDOUR::PluginScanMessage;
@@ -187,12 +191,38 @@ setup_hardware_optimization (bool try_optimization)
 {
 	bool generic_mix_functions = true;
 
+	/* these only have AVX/AVX-512 specific implementations */
+	apply_gain_ramp = default_apply_gain_ramp;
+	interleave      = default_interleave;
+	deinterleave    = default_deinterleave;
+	float_to_s32    = default_float_to_s32;
+
 	if (try_optimization) {
 		FPU* fpu = FPU::instance ();
 
 #if defined(ARCH_X86) && defined(BUILD_SSE_OPTIMIZATIONS)
 		/* We have AVX-optimized code for Windows and Linux */
 
+#ifdef FPU_AVX512F_SUPPORT
+		if (fpu->has_avx512f ()) {
+			info << "Using AVX-512 optimized routines" << endmsg;
+
+			// AVX-512 SET
+			compute_peak          = x86_avx512f_compute_peak;
+			find_peaks            = x86_avx512f_find_peaks;
+			apply_gain_to_buffer  = x86_avx512f_apply_gain_to_buffer;
+			mix_buffers_with_gain = x86_avx512f_mix_buffers_with_gain;
+			mix_buffers_no_gain   = x86_avx512f_mix_buffers_no_gain;
+			copy_vector           = x86_avx512f_copy_vector;
+			apply_gain_ramp       = x86_avx512f_apply_gain_ramp;
+			interleave            = x86_avx512f_interleave;
+			deinterleave          = x86_avx512f_deinterleave;
+			float_to_s32          = x86_avx512f_float_to_s32;
+
+			generic_mix_functions = false;
+
+		} else
+#endif
 #ifdef FPU_AVX_FMA_SUPPORT
 		if (fpu->has_fma ()) {
 			info << "Using AVX and FMA optimized routines" << endmsg;
@@ -204,6 +234,10 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = x86_fma_mix_buffers_with_gain;
 			mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 			copy_vector           = x86_sse_avx_copy_vector;
+			apply_gain_ramp       = x86_avx_apply_gain_ramp;
+			interleave            = x86_avx_interleave;
+			deinterleave          = x86_avx_deinterleave;
+			float_to_s32          = x86_avx_float_to_s32;
 
 			generic_mix_functions = false;
 
@@ -219,6 +253,10 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = x86_sse_avx_mix_buffers_with_gain;
 			mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 			copy_vector           = x86_sse_avx_copy_vector;
+			apply_gain_ramp       = x86_avx_apply_gain_ramp;
+			interleave            = x86_avx_interleave;
+			deinterleave          = x86_avx_deinterleave;
+			float_to_s32          = x86_avx_float_to_s32;
 
 			generic_mix_functions = false;
 
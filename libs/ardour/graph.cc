@@ -20,11 +20,13 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
 #include <cmath>
 #include <stdio.h>
 
 #include "pbd/compose.h"
 #include "pbd/debug_rt_alloc.h"
+#include "pbd/microseconds.h"
 #include "pbd/pthread_utils.h"
 
 #include "temporal/superclock.h"
@@ -34,6 +36,7 @@
 #include "ardour/debug.h"
 #include "ardour/graph.h"
 #include "ardour/process_thread.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/route.h"
 #include "ardour/session.h"
 #include "ardour/types.h"
@@ -59,11 +62,20 @@ alloc_allowed ()
 
 #define g_atomic_uint_get(x) static_cast<guint> (g_atomic_int_get (x))
 
+static void do_not_delete_the_queue_pointer (void*) { }
+
+Glib::Threads::Private<Graph::ThreadQueue> Graph::_thread_queue (do_not_delete_the_queue_pointer);
+
 Graph::Graph (Session& session)
 	: SessionHandleRef (session)
 	, _execution_sem ("graph_execution", 0)
 	, _callback_start_sem ("graph_start", 0)
 	, _callback_done_sem ("graph_done", 0)
+	, _work_stealing (false)
+	, _critical_path_order (false)
+	, _cycles_since_reorder (0)
+	, _predicted_critical_path (0)
+	, _actual_critical_path (0)
 	, _graph_empty (true)
 	, _current_chain (0)
 	, _pending_chain (0)
@@ -93,6 +105,11 @@ Graph::Graph (Session& session)
 #endif
 }
 
+Graph::~Graph ()
+{
+	drop_thread_queues ();
+}
+
 void
 Graph::engine_stopped ()
 {
@@ -128,6 +145,14 @@ Graph::reset_thread_list ()
 		drop_threads ();
 	}
 
+	/* one work-stealing queue per thread, large enough to hold all nodes */
+	drop_thread_queues ();
+	size_t n_nodes = std::max<size_t> (1024, _nodes_rt[_current_chain].size ());
+	for (uint32_t i = 0; i < num_threads; ++i) {
+		_thread_queues.push_back (new ThreadQueue (i));
+		_thread_queues.back ()->deque.reserve (n_nodes);
+	}
+
 	/* Allow threads to run */
 	g_atomic_int_set (&_terminate, 0);
 
@@ -160,6 +185,15 @@ Graph::session_going_away ()
 	_trigger_queue.clear ();
 }
 
+void
+Graph::drop_thread_queues ()
+{
+	for (std::vector<ThreadQueue*>::iterator i = _thread_queues.begin (); i != _thread_queues.end (); ++i) {
+		delete *i;
+	}
+	_thread_queues.clear ();
+}
+
 void
 Graph::drop_threads ()
 {
@@ -201,6 +235,11 @@ Graph::drop_threads ()
 	_callback_start_sem.reset ();
 	_callback_done_sem.reset ();
 #endif
+
+	/* a thread may have been killed while processing */
+	for (std::vector<ThreadQueue*>::iterator i = _thread_queues.begin (); i != _thread_queues.end (); ++i) {
+		(*i)->deque.clear ();
+	}
 }
 
 /* special case route removal -- called from Session::remove_routes */
@@ -213,6 +252,7 @@ Graph::clear_other_chain ()
 		if (_setup_chain != _pending_chain) {
 			for (node_list_t::iterator ni = _nodes_rt[_setup_chain].begin (); ni != _nodes_rt[_setup_chain].end (); ++ni) {
 				(*ni)->_activation_set[_setup_chain].clear ();
+				(*ni)->_activation_order[_setup_chain].clear ();
 			}
 
 			_nodes_rt[_setup_chain].clear ();
@@ -243,6 +283,9 @@ Graph::swap_process_chain ()
 			_trigger_queue.clear ();
 			/* ensure that all nodes can be queued */
 			_trigger_queue.reserve (_nodes_rt[_current_chain].size ());
+			for (std::vector<ThreadQueue*>::iterator q = _thread_queues.begin (); q != _thread_queues.end (); ++q) {
+				(*q)->deque.reserve (_nodes_rt[_current_chain].size ());
+			}
 			g_atomic_int_set (&_trigger_queue_size, 0);
 			_cleanup_cond.signal ();
 		}
@@ -262,6 +305,9 @@ Graph::prep ()
 			_current_chain = _pending_chain;
 			/* ensure that all nodes can be queued */
 			_trigger_queue.reserve (_nodes_rt[_current_chain].size ());
+			for (std::vector<ThreadQueue*>::iterator q = _thread_queues.begin (); q != _thread_queues.end (); ++q) {
+				(*q)->deque.reserve (_nodes_rt[_current_chain].size ());
+			}
 			assert (g_atomic_uint_get (&_trigger_queue_size) == 0);
 			_cleanup_cond.signal ();
 		}
@@ -283,10 +329,23 @@ Graph::prep ()
 
 	g_atomic_int_set (&_terminal_refcnt, _n_terminal_nodes[chain]);
 
+	/* Periodically re-order the graph using the DSP cost measured
+	 * during the last cycles. This is realtime safe: no memory
+	 * is allocated, and the worker threads are idle.
+	 */
+	_critical_path_order = _session.config.get_graph_critical_path ();
+	if (_critical_path_order && ++_cycles_since_reorder > 1024) {
+		order_by_critical_path (chain);
+	}
+
+	/* All other threads are idle, it is safe to switch schedulers here.
+	 * prep() is called from a process-thread, which owns a thread-queue.
+	 */
+	_work_stealing = Config->get_graph_work_stealing () && _thread_queue.get () != 0;
+
 	/* Trigger the initial nodes for processing, which are the ones at the `input' end */
 	for (i = _init_trigger_list[chain].begin (); i != _init_trigger_list[chain].end (); i++) {
-		g_atomic_int_inc (&_trigger_queue_size);
-		_trigger_queue.push_back (i->get ());
+		trigger (i->get ());
 	}
 }
 
@@ -294,7 +353,42 @@ void
 Graph::trigger (GraphNode* n)
 {
 	g_atomic_int_inc (&_trigger_queue_size);
-	_trigger_queue.push_back (n);
+	if (_work_stealing) {
+		/* Only process-threads trigger nodes, queue locally.
+		 * Idle threads will steal work from here.
+		 */
+		_thread_queue.get ()->deque.push (n);
+	} else {
+		_trigger_queue.push_back (n);
+	}
+}
+
+/** Find a node to process.
+ *
+ * With the work-stealing scheduler, the thread's own queue is used first
+ * (most recently triggered node, which is likely still in the cache).
+ * Otherwise the oldest node of another thread's queue is taken.
+ */
+bool
+Graph::pop_work (GraphNode*& n)
+{
+	if (!_work_stealing) {
+		return _trigger_queue.pop_front (n);
+	}
+
+	ThreadQueue* tq = _thread_queue.get ();
+	if (tq->deque.pop (n)) {
+		return true;
+	}
+
+	/* start with the next thread, to spread contention */
+	size_t const n_queues = _thread_queues.size ();
+	for (size_t i = 1; i < n_queues; ++i) {
+		if (_thread_queues[(tq->id + i) % n_queues]->deque.steal (n)) {
+			return true;
+		}
+	}
+	return false;
 }
 
 /** Called when a node at the `output' end of the chain (ie one that has no-one to feed)
@@ -376,6 +470,7 @@ Graph::rechain (boost::shared_ptr<RouteList> routelist, GraphEdges const& edges)
 	for (RouteList::iterator ri = routelist->begin (); ri != routelist->end (); ri++) {
 		(*ri)->_init_refcount[chain] = 0;
 		(*ri)->_activation_set[chain].clear ();
+		(*ri)->_activation_order[chain].clear ();
 		_nodes_rt[chain].push_back (*ri);
 	}
 
@@ -392,7 +487,9 @@ Graph::rechain (boost::shared_ptr<RouteList> routelist, GraphEdges const& edges)
 
 		/* Set up r's activation set */
 		for (set<GraphVertex>::iterator i = fed_from_r.begin (); i != fed_from_r.end (); ++i) {
-			r->_activation_set[chain].insert (*i);
+			if (r->_activation_set[chain].insert (*i).second) {
+				r->_activation_order[chain].push_back (i->get ());
+			}
 		}
 
 		/* r has an input if there are some incoming edges to r in the graph */
@@ -416,10 +513,74 @@ Graph::rechain (boost::shared_ptr<RouteList> routelist, GraphEdges const& edges)
 		}
 	}
 
+	if (_session.config.get_graph_critical_path ()) {
+		order_by_critical_path (chain);
+		DEBUG_TRACE (DEBUG::Graph, string_compose ("predicted critical path: %1 usec\n", _predicted_critical_path));
+	}
+
 	_pending_chain = chain;
 	dump (chain);
 }
 
+namespace {
+/* longest remaining path first */
+struct CriticalPathSorter {
+	CriticalPathSorter (int c) : chain (c) {}
+	bool operator() (GraphNode const* a, GraphNode const* b) const {
+		return a->critical_path (chain) > b->critical_path (chain);
+	}
+	bool operator() (node_ptr_t const& a, node_ptr_t const& b) const {
+		return (*this) (a.get (), b.get ());
+	}
+	int chain;
+};
+}
+
+/** Compute the critical path of every node using the measured DSP cost,
+ *  and order the initial trigger list as well as each node's activation
+ *  order so that the nodes with the longest remaining path are started first.
+ *
+ *  The node list of the given chain must be in topological order, which is
+ *  the case for the route list passed to rechain() by
+ *  Session::resort_routes_using(). This does not allocate memory and can
+ *  be called from prep().
+ */
+void
+Graph::order_by_critical_path (int chain)
+{
+	_cycles_since_reorder = 0;
+
+	/* visit downstream nodes before the nodes that feed them */
+	for (node_list_t::reverse_iterator ni = _nodes_rt[chain].rbegin (); ni != _nodes_rt[chain].rend (); ++ni) {
+		GraphNode* n = ni->get ();
+		float downstream = 0;
+		for (std::vector<GraphNode*>::const_iterator ai = n->_activation_order[chain].begin (); ai != n->_activation_order[chain].end (); ++ai) {
+			downstream = std::max (downstream, (*ai)->critical_path (chain));
+		}
+		n->_critical_path[chain] = n->dsp_cost () + downstream;
+		std::sort (n->_activation_order[chain].begin (), n->_activation_order[chain].end (), CriticalPathSorter (chain));
+	}
+
+	_init_trigger_list[chain].sort (CriticalPathSorter (chain));
+
+	if (_init_trigger_list[chain].empty ()) {
+		_predicted_critical_path = 0;
+	} else {
+		_predicted_critical_path = _init_trigger_list[chain].front ()->critical_path (chain);
+	}
+}
+
+bool
+Graph::critical_path (float& predicted_usec, float& actual_usec) const
+{
+	if (!_session.config.get_graph_critical_path ()) {
+		return false;
+	}
+	predicted_usec = _predicted_critical_path;
+	actual_usec    = _actual_critical_path;
+	return true;
+}
+
 /** Called by both the main thread and all helpers. */
 void
 Graph::run_one ()
@@ -430,7 +591,7 @@ Graph::run_one ()
 		return;
 	}
 
-	if (_trigger_queue.pop_front (to_run)) {
+	if (pop_work (to_run)) {
 		/* Wake up idle threads, but at most as many as there's
 		 * work in the trigger queue that can be processed by
 		 * other threads.
@@ -463,7 +624,7 @@ Graph::run_one ()
 		g_atomic_int_dec_and_test (&_idle_thread_cnt);
 
 		/* Try to find some work to do */
-		_trigger_queue.pop_front (to_run);
+		pop_work (to_run);
 	}
 
 	/* Process the graph-node */
@@ -476,8 +637,9 @@ Graph::run_one ()
 void
 Graph::helper_thread ()
 {
-	g_atomic_int_inc (&_n_workers);
-	guint id = g_atomic_uint_get (&_n_workers);
+	guint id = g_atomic_int_add (&_n_workers, 1) + 1;
+	assert (id < _thread_queues.size ());
+	_thread_queue.set (_thread_queues[id]);
 
 	/* This is needed for ARDOUR::Session requests called from rt-processors
 	 * in particular Lua scripts may do cross-thread calls */
@@ -526,6 +688,8 @@ Graph::main_thread ()
 
 	pt->get_buffers ();
 
+	_thread_queue.set (_thread_queues[0]);
+
 	/* Wait for initial process callback */
 again:
 	_callback_start_sem.wait ();
@@ -659,8 +823,12 @@ Graph::process_routes (pframes_t nframes, samplepos_t start_sample, samplepos_t
 	_process_need_butler = false;
 
 	DEBUG_TRACE (DEBUG::ProcessThreads, "wake graph for non-silent process\n");
+	microseconds_t t0 = PBD::get_microseconds ();
 	_callback_start_sem.signal ();
 	_callback_done_sem.wait ();
+	if (_critical_path_order) {
+		_actual_critical_path += .05f * ((PBD::get_microseconds () - t0) - _actual_critical_path);
+	}
 	DEBUG_TRACE (DEBUG::ProcessThreads, "graph execution complete\n");
 
 	need_butler = _process_need_butler;
@@ -703,12 +871,18 @@ Graph::process_one_route (Route* route)
 
 	DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 runs route %2\n", pthread_name (), route->name ()));
 
+	microseconds_t t0 = _critical_path_order ? PBD::get_microseconds () : 0;
+
 	if (_process_noroll) {
 		retval = route->no_roll (_process_nframes, _process_start_sample, _process_end_sample, _process_non_rt_pending);
 	} else {
 		retval = route->roll (_process_nframes, _process_start_sample, _process_end_sample, need_butler);
 	}
 
+	if (_critical_path_order) {
+		route->update_dsp_cost (PBD::get_microseconds () - t0);
+	}
+
 	if (retval) {
 		_process_retval = retval;
 	}
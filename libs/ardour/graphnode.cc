@@ -26,8 +26,10 @@ using namespace ARDOUR;
 
 GraphNode::GraphNode (boost::shared_ptr<Graph> graph)
 	: _graph (graph)
+	, _dsp_cost (0)
 {
 	g_atomic_int_set (&_refcount, 0);
+	_critical_path[0] = _critical_path[1] = 0;
 }
 
 GraphNode::~GraphNode ()
@@ -59,11 +61,11 @@ GraphNode::trigger ()
 void
 GraphNode::finish (int chain)
 {
-	node_set_t::iterator i;
-	bool                 feeds = false;
+	std::vector<GraphNode*>::const_iterator i;
+	bool feeds = false;
 
 	/* Notify downstream nodes that depend on this node */
-	for (i = _activation_set[chain].begin (); i != _activation_set[chain].end (); ++i) {
+	for (i = _activation_order[chain].begin (); i != _activation_order[chain].end (); ++i) {
 		(*i)->trigger ();
 		feeds = true;
 	}
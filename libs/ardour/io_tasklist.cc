@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+
+#include "pbd/error.h"
+#include "pbd/pthread_utils.h"
+
+#include "temporal/tempo.h"
+
+#include "ardour/disk_reader.h"
+#include "ardour/io_tasklist.h"
+
+#include "pbd/i18n.h"
+
+using namespace ARDOUR;
+
+IOTaskList::IOTaskList (uint32_t n_threads)
+	: _task_run_sem ("io_task_run", 0)
+	, _task_end_sem ("io_task_done", 0)
+	, _tasklist (0)
+{
+	g_atomic_int_set (&_terminate, 0);
+	g_atomic_int_set (&_next, 0);
+
+	for (uint32_t i = 1; i < n_threads; ++i) {
+		pthread_t thread_id;
+		if (pthread_create_and_store ("IOTaskList", &thread_id, _thread_run, this)) {
+			PBD::error << _("Cannot create thread for IOTaskList") << endmsg;
+			break;
+		}
+		_threads.push_back (thread_id);
+	}
+}
+
+IOTaskList::~IOTaskList ()
+{
+	g_atomic_int_set (&_terminate, 1);
+
+	for (size_t i = 0; i < _threads.size (); ++i) {
+		_task_run_sem.signal ();
+	}
+	for (std::vector<pthread_t>::const_iterator i = _threads.begin (); i != _threads.end (); ++i) {
+		pthread_join (*i, NULL);
+	}
+}
+
+/*static*/ void*
+IOTaskList::_thread_run (void* arg)
+{
+	IOTaskList* d = static_cast<IOTaskList*> (arg);
+	pthread_set_name ("IOTaskList");
+	DiskReader::allocate_thread_working_buffers ();
+	d->run ();
+	return 0;
+}
+
+void
+IOTaskList::run ()
+{
+	while (true) {
+		_task_run_sem.wait ();
+
+		if (g_atomic_int_get (&_terminate)) {
+			break;
+		}
+
+		Temporal::TempoMap::fetch ();
+
+		process_tasks ();
+
+		_task_end_sem.signal ();
+	}
+}
+
+void
+IOTaskList::process_tasks ()
+{
+	TaskList const& tl (*_tasklist);
+
+	while (true) {
+		size_t n = g_atomic_int_add (&_next, 1);
+		if (n >= tl.size ()) {
+			break;
+		}
+		tl[n] ();
+	}
+}
+
+void
+IOTaskList::process (TaskList const& tl)
+{
+	if (tl.empty ()) {
+		return;
+	}
+
+	_tasklist = &tl;
+	g_atomic_int_set (&_next, 0);
+
+	/* only wake up as many threads as there are tasks to share */
+	size_t nt = std::min (_threads.size (), tl.size () - 1);
+
+	for (size_t i = 0; i < nt; ++i) {
+		_task_run_sem.signal ();
+	}
+
+	process_tasks ();
+
+	for (size_t i = 0; i < nt; ++i) {
+		_task_end_sem.wait ();
+	}
+
+	_tasklist = 0;
+}
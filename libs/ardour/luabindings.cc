@@ -1385,6 +1385,8 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("use_copy_playlist", &Track::use_copy_playlist)
 		.addFunction ("use_new_playlist", &Track::use_new_playlist)
 		.addFunction ("find_and_use_playlist", &Track::find_and_use_playlist)
+		.addFunction ("playback_buffer_load", &Track::playback_buffer_load)
+		.addFunction ("capture_buffer_load", &Track::capture_buffer_load)
 		.endClass ()
 
 		.deriveWSPtrClass <AudioTrack, Track> ("AudioTrack")
@@ -1648,6 +1650,8 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("output_streams", &Processor::output_streams)
 		.addFunction ("input_streams", &Processor::input_streams)
 		.addFunction ("signal_latency", &Processor::signal_latency)
+		.addFunction ("reset_timing", &Processor::reset_timing)
+		.addRefFunction ("get_dsp_timing", &Processor::get_dsp_timing)
 		.endClass ()
 
 		.deriveWSPtrClass <DiskIOProcessor, Processor> ("DiskIOProcessor")
@@ -1767,6 +1771,7 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("is_channelstrip", &PluginInsert::is_channelstrip)
 		.addFunction ("clear_stats", &PluginInsert::clear_stats)
 		.addRefFunction ("get_stats", &PluginInsert::get_stats)
+		.addRefFunction ("get_plugin_dsp_timing", &PluginInsert::get_plugin_dsp_timing)
 		.endClass ()
 
 		.deriveWSPtrClass <ReadOnlyControl, PBD::StatefulDestructible> ("ReadOnlyControl")
@@ -2440,6 +2445,11 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("output_channels", &AudioBackend::output_channels)
 		.addFunction ("dsp_load", &AudioBackend::dsp_load)
 
+		.addFunction ("start_benchmark", &AudioBackend::start_benchmark)
+		.addFunction ("benchmark_running", &AudioBackend::benchmark_running)
+		.addFunction ("benchmark_report", &AudioBackend::benchmark_report)
+		.addFunction ("write_benchmark_data", &AudioBackend::write_benchmark_data)
+
 		.addFunction ("set_sample_rate", &AudioBackend::set_sample_rate)
 		.addFunction ("set_buffer_size", &AudioBackend::set_buffer_size)
 		.addFunction ("set_peridod_size", &AudioBackend::set_peridod_size)
@@ -2606,6 +2616,11 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("get_stripables", (StripableList (Session::*)() const)&Session::get_stripables)
 		.addFunction ("get_routelist", &Session::get_routelist)
 		.addFunction ("plot_process_graph", &Session::plot_process_graph)
+		.addRefFunction ("process_graph_critical_path", &Session::process_graph_critical_path)
+		.addFunction ("set_processor_timing_enabled", &Session::set_processor_timing_enabled)
+		.addFunction ("processor_timing_enabled", &Session::processor_timing_enabled)
+		.addFunction ("reset_processor_timing", &Session::reset_processor_timing)
+		.addFunction ("processors_by_dsp_load", &Session::processors_by_dsp_load)
 
 		.addFunction ("bundles", &Session::bundles)
 
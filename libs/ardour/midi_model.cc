@@ -25,6 +25,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <limits>
 #include <set>
 #include <stdexcept>
 #include <stdint.h>
@@ -60,6 +61,7 @@ using namespace PBD;
 
 MidiModel::MidiModel (boost::shared_ptr<MidiSource> s)
 	: AutomatableSequence<TimeType> (s->session(), Temporal::BeatTime)
+	, _edited_notes (false)
 {
 	set_midi_source (s);
 }
@@ -230,12 +232,85 @@ MidiModel::NoteDiffCommand::operator+= (const NoteDiffCommand& other)
 	return *this;
 }
 
+static void
+extend_note_range (Evoral::Sequence<Temporal::Beats>::NotePtr const& note, Temporal::Beats& start, Temporal::Beats& end)
+{
+	start = min (start, note->time ());
+	end   = max (end, note->end_time ());
+}
+
+/** Extend [start, end] by the on and off times of all notes that are
+ * added, removed or changed by this command, in their current state.
+ * The previous times of StartTime and Length changes are included as
+ * well, this covers notes that were truncated to resolve overlaps.
+ * @return false if a changed note has not been looked up yet.
+ */
+bool
+MidiModel::NoteDiffCommand::extend_edit_range (TimeType& start, TimeType& end) const
+{
+	for (NoteList::const_iterator i = _added_notes.begin(); i != _added_notes.end(); ++i) {
+		extend_note_range (*i, start, end);
+	}
+
+	for (NoteList::const_iterator i = _removed_notes.begin(); i != _removed_notes.end(); ++i) {
+		extend_note_range (*i, start, end);
+	}
+
+	for (set<NotePtr>::const_iterator i = side_effect_removals.begin(); i != side_effect_removals.end(); ++i) {
+		extend_note_range (*i, start, end);
+	}
+
+	/* a note may have been moved and resized, its previous length is
+	 * at most the longest previous length of any note.
+	 */
+	TimeType longest;
+
+	for (ChangeList::const_iterator i = _changes.begin(); i != _changes.end(); ++i) {
+		if (!i->note) {
+			return false;
+		}
+
+		if (i->property == Length) {
+			longest = max (longest, i->old_value.get_beats ());
+		}
+	}
+
+	for (ChangeList::const_iterator i = _changes.begin(); i != _changes.end(); ++i) {
+
+		extend_note_range (i->note, start, end);
+
+		switch (i->property) {
+		case StartTime:
+			start = min (start, i->old_value.get_beats ());
+			end   = max (end, i->old_value.get_beats () + max (i->note->length (), longest));
+			break;
+		case Length:
+			end = max (end, i->note->time () + i->old_value.get_beats ());
+			break;
+		default:
+			break;
+		}
+	}
+
+	return true;
+}
+
 void
 MidiModel::NoteDiffCommand::operator() ()
 {
+	TimeType edit_start = std::numeric_limits<TimeType>::max ();
+	TimeType edit_end;
+	bool     ranged;
+
 	{
 		MidiModel::WriteLock lock(_model->edit_lock());
 
+		/* Adding notes may silently truncate or remove other notes, unless
+		 * overlaps are allowed. Re-added notes record their side effects.
+		 */
+		ranged = (_added_notes.empty () || _model->insert_merge_policy () == InsertMergeRelax)
+			&& extend_edit_range (edit_start, edit_end);
+
 		for (NoteList::iterator i = _added_notes.begin(); i != _added_notes.end(); ++i) {
 			if (!_model->add_note_unlocked(*i)) {
 				/* failed to add it, so don't leave it in the removed list, to
@@ -322,14 +397,24 @@ MidiModel::NoteDiffCommand::operator() ()
 				cerr << "\t" << *i << ' ' << **i << endl;
 			}
 		}
+
+		ranged = ranged && extend_edit_range (edit_start, edit_end);
 	}
 
-	_model->ContentsChanged(); /* EMIT SIGNAL */
+	if (ranged) {
+		_model->notes_changed (edit_start, edit_end);
+	} else {
+		_model->ContentsChanged(); /* EMIT SIGNAL */
+	}
 }
 
 void
 MidiModel::NoteDiffCommand::undo ()
 {
+	TimeType edit_start = std::numeric_limits<TimeType>::max ();
+	TimeType edit_end;
+	bool     ranged;
+
 	{
 		MidiModel::WriteLock lock(_model->edit_lock());
 
@@ -359,6 +444,10 @@ MidiModel::NoteDiffCommand::undo ()
 			}
 		}
 
+		/* notes are re-added without recording side effects */
+		ranged = _model->insert_merge_policy () == InsertMergeRelax
+			&& extend_edit_range (edit_start, edit_end);
+
 		for (ChangeList::iterator i = _changes.begin(); i != _changes.end(); ++i) {
 			Property prop = i->property;
 
@@ -432,9 +521,15 @@ MidiModel::NoteDiffCommand::undo ()
 		for (set<NotePtr>::iterator i = side_effect_removals.begin(); i != side_effect_removals.end(); ++i) {
 			_model->add_note_unlocked (*i);
 		}
+
+		ranged = ranged && extend_edit_range (edit_start, edit_end);
 	}
 
-	_model->ContentsChanged(); /* EMIT SIGNAL */
+	if (ranged) {
+		_model->notes_changed (edit_start, edit_end);
+	} else {
+		_model->ContentsChanged(); /* EMIT SIGNAL */
+	}
 }
 
 XMLNode&
@@ -1825,3 +1920,27 @@ MidiModel::control_list_marked_dirty ()
 
 	ContentsChanged (); /* EMIT SIGNAL */
 }
+
+void
+MidiModel::notes_changed (TimeType start, TimeType end)
+{
+	_edited_start = start;
+	_edited_end   = end;
+	_edited_notes = true;
+
+	ContentsChanged (); /* EMIT SIGNAL */
+
+	_edited_notes = false;
+}
+
+bool
+MidiModel::edited_notes (TimeType& start, TimeType& end) const
+{
+	if (!_edited_notes) {
+		return false;
+	}
+
+	start = _edited_start;
+	end   = _edited_end;
+	return true;
+}
@@ -49,6 +49,14 @@ using namespace std;
 MidiPlaylist::MidiPlaylist (Session& session, const XMLNode& node, bool hidden)
 	: Playlist (session, node, DataType::MIDI, hidden)
 	, _note_mode(Sustained)
+	, _rendered_filter (0)
+	, _rendered_filter_state (0)
+	, _rendered_note_mode (Sustained)
+	, _dirty_start (max_samplepos)
+	, _dirty_end (0)
+	, _dirty_notes_start (max_samplepos)
+	, _dirty_notes_end (0)
+	, _dirty_all (false)
 {
 #ifndef NDEBUG
 	XMLProperty const * prop = node.property("type");
@@ -67,12 +75,28 @@ MidiPlaylist::MidiPlaylist (Session& session, const XMLNode& node, bool hidden)
 MidiPlaylist::MidiPlaylist (Session& session, string name, bool hidden)
 	: Playlist (session, name, DataType::MIDI, hidden)
 	, _note_mode(Sustained)
+	, _rendered_filter (0)
+	, _rendered_filter_state (0)
+	, _rendered_note_mode (Sustained)
+	, _dirty_start (max_samplepos)
+	, _dirty_end (0)
+	, _dirty_notes_start (max_samplepos)
+	, _dirty_notes_end (0)
+	, _dirty_all (false)
 {
 }
 
 MidiPlaylist::MidiPlaylist (boost::shared_ptr<const MidiPlaylist> other, string name, bool hidden)
 	: Playlist (other, name, hidden)
 	, _note_mode(other->_note_mode)
+	, _rendered_filter (0)
+	, _rendered_filter_state (0)
+	, _rendered_note_mode (Sustained)
+	, _dirty_start (max_samplepos)
+	, _dirty_end (0)
+	, _dirty_notes_start (max_samplepos)
+	, _dirty_notes_end (0)
+	, _dirty_all (false)
 {
 }
 
@@ -83,6 +107,14 @@ MidiPlaylist::MidiPlaylist (boost::shared_ptr<const MidiPlaylist> other,
                             bool                                  hidden)
 	: Playlist (other, start, dur, name, hidden)
 	, _note_mode(other->_note_mode)
+	, _rendered_filter (0)
+	, _rendered_filter_state (0)
+	, _rendered_note_mode (Sustained)
+	, _dirty_start (max_samplepos)
+	, _dirty_end (0)
+	, _dirty_notes_start (max_samplepos)
+	, _dirty_notes_end (0)
+	, _dirty_all (false)
 {
 }
 
@@ -106,11 +138,56 @@ struct EventsSortByTimeAndType {
     }
 };
 
+MidiPlaylist::RenderedRegion::RenderedRegion (boost::shared_ptr<Region> const& r)
+	: id (r->id ())
+	, source (r->source () ? r->source ()->id () : PBD::ID (0))
+	, first (r->first_sample ())
+	, last (r->last_sample ())
+	, start (r->start ())
+	, layer (r->layer ())
+	, muted (r->muted ())
+	, opaque (r->opaque ())
+{
+}
+
 void
 MidiPlaylist::remove_dependents (boost::shared_ptr<Region> region)
 {
 }
 
+bool
+MidiPlaylist::region_changed (const PropertyChange& what_changed, boost::shared_ptr<Region> region)
+{
+	if (what_changed.contains (Properties::contents)) {
+		/* note the range of the edit for the next ::render(). If more
+		 * than notes were changed, use the region's range, including
+		 * events at its end (resolved notes).
+		 */
+		boost::shared_ptr<MidiRegion> mr = boost::dynamic_pointer_cast<MidiRegion> (region);
+		samplepos_t start;
+		samplepos_t end;
+		const bool  notes_only = mr && mr->take_edited_notes (start, end);
+
+		Glib::Threads::Mutex::Lock lm (_dirty_lock);
+
+		if (what_changed.size () > 1) {
+			_dirty_all = true;
+		} else if (notes_only) {
+			_dirty_notes_start = min (_dirty_notes_start, start);
+			_dirty_notes_end   = max (_dirty_notes_end, end);
+		} else {
+			_dirty_start = min (_dirty_start, region->first_sample ());
+			_dirty_end   = max (_dirty_end, region->last_sample () + 1);
+		}
+	} else if (!what_changed.empty ()) {
+		/* anything else that went into the last ::render() */
+		Glib::Threads::Mutex::Lock lm (_dirty_lock);
+		_dirty_all = true;
+	}
+
+	return Playlist::region_changed (what_changed, region);
+}
+
 void
 MidiPlaylist::region_going_away (boost::weak_ptr<Region> region)
 {
@@ -310,6 +387,64 @@ MidiPlaylist::render (MidiChannelFilter* filter)
 		regs.push_back (*i);
 	}
 
+	/* A change of the model of regions can be rendered incrementally,
+	 * unless anything else has changed since the last render.
+	 */
+	samplepos_t dirty_start;
+	samplepos_t dirty_end;
+	samplepos_t notes_start;
+	samplepos_t notes_end;
+	bool        dirty_all;
+
+	{
+		Glib::Threads::Mutex::Lock lm (_dirty_lock);
+		dirty_start        = _dirty_start;
+		dirty_end          = _dirty_end;
+		notes_start        = _dirty_notes_start;
+		notes_end          = _dirty_notes_end;
+		dirty_all          = _dirty_all;
+		_dirty_start       = max_samplepos;
+		_dirty_end         = 0;
+		_dirty_notes_start = max_samplepos;
+		_dirty_notes_end   = 0;
+		_dirty_all         = false;
+	}
+
+	std::vector<RenderedRegion> rendered_regions;
+	rendered_regions.reserve (regs.size ());
+
+	for (vector<boost::shared_ptr<Region> >::const_iterator i = regs.begin(); i != regs.end(); ++i) {
+		rendered_regions.push_back (RenderedRegion (*i));
+	}
+
+	Temporal::TempoMap::SharedPtr tmap (Temporal::TempoMap::use ());
+	uint32_t filter_state = filter ? ((filter->get_channel_mode () << 16) | filter->get_channel_mask ()) : 0;
+
+	const bool incremental = (dirty_start <= dirty_end || notes_start <= notes_end)
+		&& !dirty_all
+		&& !_rendered.reversed ()
+		&& rendered_regions == _rendered_regions
+		&& tmap == _rendered_tempo_map
+		&& filter == _rendered_filter
+		&& filter_state == _rendered_filter_state
+		&& _note_mode == _rendered_note_mode;
+
+	_rendered_regions.swap (rendered_regions);
+	_rendered_tempo_map    = tmap;
+	_rendered_filter       = filter;
+	_rendered_filter_state = filter_state;
+	_rendered_note_mode    = _note_mode;
+
+	if (incremental) {
+		if (dirty_start <= dirty_end) {
+			render_range (regs, filter, min (dirty_start, notes_start), max (dirty_end, notes_end));
+			return;
+		}
+		if (render_notes (regs, filter, notes_start, notes_end)) {
+			return;
+		}
+	}
+
 	/* If we are reading from a single region, we can read directly into _rendered.  Otherwise,
 	   we read into a temporarily list, sort it, then write that to _rendered.
 	*/
@@ -369,6 +504,117 @@ MidiPlaylist::render (MidiChannelFilter* filter)
 	DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("---- End MidiPlaylist::render, events: %1\n", _rendered.size()));
 }
 
+void
+MidiPlaylist::render_range (std::vector<boost::shared_ptr<Region> > const& regs, MidiChannelFilter* filter, samplepos_t start, samplepos_t end)
+{
+	/* precondition: caller holds the region read lock, and nothing but
+	 * the contents of regions within [start, end] changed since the last
+	 * render.
+	 *
+	 * Regions are rendered completely, since the state of notes at the
+	 * range boundaries depends on the rest of the region, but only events
+	 * within the range are replaced. This runs without holding the lock
+	 * on _rendered, playback continues with the old data until the
+	 * range is spliced in.
+	 */
+
+	DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("---- MidiPlaylist::render_range %1 .. %2 -----\n", start, end));
+
+	Evoral::EventList<samplepos_t> evlist;
+
+	for (vector<boost::shared_ptr<Region> >::const_iterator i = regs.begin(); i != regs.end(); ++i) {
+
+		if ((*i)->first_sample () > end || (*i)->last_sample () + 1 < start) {
+			continue;
+		}
+
+		boost::shared_ptr<MidiRegion> mr = boost::dynamic_pointer_cast<MidiRegion>(*i);
+
+		if (!mr) {
+			continue;
+		}
+
+		DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("render from %1\n", mr->name()));
+		mr->render (evlist, 0, _note_mode, filter);
+	}
+
+	EventsSortByTimeAndType<samplepos_t> cmp;
+	evlist.sort (cmp);
+
+	RTMidiBuffer range;
+
+	for (Evoral::EventList<samplepos_t>::iterator e = evlist.begin(); e != evlist.end(); ++e) {
+		Evoral::Event<samplepos_t>* ev (*e);
+		if (ev->time() >= start && ev->time() <= end) {
+			range.write (ev->time(), ev->event_type(), ev->size(), ev->buffer());
+		}
+		delete ev;
+	}
+
+	RTMidiBuffer::WriteProtectRender wpr (_rendered);
+	wpr.acquire ();
+
+	_rendered.replace (start, end, range);
+
+	DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("---- End MidiPlaylist::render_range, replaced by %1 events, total: %2\n", range.size (), _rendered.size()));
+}
+
+bool
+MidiPlaylist::render_notes (std::vector<boost::shared_ptr<Region> > const& regs, MidiChannelFilter* filter, samplepos_t start, samplepos_t end)
+{
+	/* precondition: caller holds the region read lock, and nothing but
+	 * notes within [start, end] changed since the last render.
+	 *
+	 * Only note events within the range are rendered, including those of
+	 * notes that start before or end after it. All other events of the
+	 * range are unchanged and kept. As in ::render_range(), playback only
+	 * waits for the range to be spliced in.
+	 */
+
+	DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("---- MidiPlaylist::render_notes %1 .. %2 -----\n", start, end));
+
+	Evoral::EventList<samplepos_t> evlist;
+	bool                           ok = true;
+
+	/* MidiRegion::render_notes() skips regions that are not within the range */
+	for (vector<boost::shared_ptr<Region> >::const_iterator i = regs.begin(); i != regs.end() && ok; ++i) {
+
+		boost::shared_ptr<MidiRegion> mr = boost::dynamic_pointer_cast<MidiRegion>(*i);
+
+		if (!mr) {
+			continue;
+		}
+
+		DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("render notes from %1\n", mr->name()));
+		ok = mr->render_notes (evlist, start, end, filter) == 0;
+	}
+
+	EventsSortByTimeAndType<samplepos_t> cmp;
+	evlist.sort (cmp);
+
+	RTMidiBuffer notes;
+
+	for (Evoral::EventList<samplepos_t>::iterator e = evlist.begin(); e != evlist.end(); ++e) {
+		Evoral::Event<samplepos_t>* ev (*e);
+		notes.write (ev->time(), ev->event_type(), ev->size(), ev->buffer());
+		delete ev;
+	}
+
+	if (!ok) {
+		/* no model, the caller renders everything */
+		return false;
+	}
+
+	RTMidiBuffer::WriteProtectRender wpr (_rendered);
+	wpr.acquire ();
+
+	_rendered.replace_notes (start, end, notes);
+
+	DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("---- End MidiPlaylist::render_notes, %1 notes, total: %2\n", notes.size (), _rendered.size()));
+
+	return true;
+}
+
 RTMidiBuffer*
 MidiPlaylist::rendered ()
 {
@@ -39,6 +39,7 @@
 #include "pbd/basename.h"
 
 #include "ardour/automation_control.h"
+#include "ardour/midi_channel_filter.h"
 #include "ardour/midi_cursor.h"
 #include "ardour/midi_model.h"
 #include "ardour/midi_region.h"
@@ -64,6 +65,8 @@ using namespace PBD;
 MidiRegion::MidiRegion (const SourceList& srcs)
 	: Region (srcs)
 	, _ignore_shift (false)
+	, _edited_start (std::numeric_limits<Temporal::Beats>::max ())
+	, _edited_all (false)
 {
 	midi_source(0)->ModelChanged.connect_same_thread (_source_connection, boost::bind (&MidiRegion::model_changed, this));
 	model_changed ();
@@ -74,6 +77,8 @@ MidiRegion::MidiRegion (const SourceList& srcs)
 MidiRegion::MidiRegion (boost::shared_ptr<const MidiRegion> other)
 	: Region (other)
 	, _ignore_shift (false)
+	, _edited_start (std::numeric_limits<Temporal::Beats>::max ())
+	, _edited_all (false)
 {
 	assert(_name.val().find("/") == string::npos);
 	midi_source(0)->ModelChanged.connect_same_thread (_source_connection, boost::bind (&MidiRegion::model_changed, this));
@@ -84,6 +89,8 @@ MidiRegion::MidiRegion (boost::shared_ptr<const MidiRegion> other)
 MidiRegion::MidiRegion (boost::shared_ptr<const MidiRegion> other, timecnt_t const & offset)
 	: Region (other, offset)
 	, _ignore_shift (false)
+	, _edited_start (std::numeric_limits<Temporal::Beats>::max ())
+	, _edited_all (false)
 {
 
 	assert(_name.val().find("/") == string::npos);
@@ -346,6 +353,100 @@ MidiRegion::render_range (Evoral::EventSink<samplepos_t>& dst,
 	return 0;
 }
 
+static void
+write_note_event (Evoral::EventSink<samplepos_t>& dst, samplepos_t time, Evoral::Event<Temporal::Beats> const& ev, MidiChannelFilter* filter)
+{
+	if (!filter) {
+		dst.write (time, ev.event_type (), ev.size (), ev.buffer ());
+		return;
+	}
+
+	/* the filter may change the channel, see MidiSource::midi_read() */
+	Evoral::Event<Temporal::Beats> copy (ev, true);
+
+	if (!filter->filter (copy.buffer (), copy.size ())) {
+		dst.write (time, copy.event_type (), copy.size (), copy.buffer ());
+	}
+}
+
+int
+MidiRegion::render_notes (Evoral::EventSink<samplepos_t>& dst,
+                          samplepos_t                     start,
+                          samplepos_t                     end,
+                          MidiChannelFilter*              filter) const
+{
+	if (muted()) {
+		return 0; /* read nothing */
+	}
+
+	/* the bounds that ::render() passes to MidiSource::midi_read() */
+	const timepos_t       read_start   = this->start ();
+	const Temporal::Beats source_start = source_position ().beats ();
+	const Temporal::Beats region_start = (source_position () + read_start).beats ();
+	const Temporal::Beats region_end   = source_start + read_start.beats () + _length.val ().beats ();
+	const samplepos_t     resolve_at   = (source_position () + read_start + _length.val ()).samples ();
+
+	if (timepos_t (region_start).samples () > end || resolve_at < start) {
+		return 0;
+	}
+
+	boost::shared_ptr<MidiSource> src = midi_source (0);
+
+	Glib::Threads::Mutex::Lock lm (src->mutex ());
+
+	boost::shared_ptr<const MidiModel> m = src->model ();
+
+	if (!m) {
+		return -1;
+	}
+
+	Evoral::Sequence<Temporal::Beats>::ReadLock rl (m->read_lock ());
+
+	/* Notes that start before the range are scanned as well, their
+	 * note-off may be within it.
+	 */
+	for (Evoral::Sequence<Temporal::Beats>::Notes::const_iterator n = m->note_lower_bound (read_start.beats ()); n != m->notes ().end (); ++n) {
+
+		const Temporal::Beats on = source_start + (*n)->time ();
+
+		if (on >= region_end) {
+			break;
+		}
+
+		const samplepos_t on_sample = timepos_t (on).samples ();
+
+		if (on_sample > end) {
+			break;
+		}
+
+		/* midi_read() skips the note-on of notes before the region start,
+		 * but not their note-off.
+		 */
+		const bool in_region = on >= region_start;
+
+		if (in_region && on_sample >= start) {
+			write_note_event (dst, on_sample, (*n)->on_event (), filter);
+		}
+
+		const Temporal::Beats off = source_start + (*n)->end_time ();
+
+		if (off < region_end) {
+			const samplepos_t off_sample = timepos_t (off).samples ();
+			if (off_sample >= start && off_sample <= end) {
+				write_note_event (dst, off_sample, (*n)->off_event (), filter);
+			}
+		} else if (in_region && resolve_at >= start && resolve_at <= end) {
+			/* resolved by the note tracker in ::render_range(), which
+			 * tracks notes before they are filtered.
+			 */
+			uint8_t buf[3] = { (uint8_t) (MIDI_CMD_NOTE_OFF | (*n)->channel ()), (*n)->note (), 0 };
+			dst.write (resolve_at, Evoral::MIDI_EVENT, 3, buf);
+		}
+	}
+
+	return 0;
+}
+
 
 XMLNode&
 MidiRegion::state ()
@@ -469,9 +570,65 @@ MidiRegion::model_changed ()
 void
 MidiRegion::model_contents_changed ()
 {
+	{
+		Glib::Threads::Mutex::Lock lm (_edited_lock);
+		Temporal::Beats start;
+		Temporal::Beats end;
+
+		if (!model()->edited_notes (start, end)) {
+			_edited_all = true;
+		} else if (start <= end) {
+			_edited_start = min (_edited_start, start);
+			_edited_end   = max (_edited_end, end);
+		}
+	}
+
 	send_change (Properties::contents);
 }
 
+bool
+MidiRegion::take_edited_notes (samplepos_t& start, samplepos_t& end)
+{
+	Temporal::Beats edited_start;
+	Temporal::Beats edited_end;
+
+	{
+		Glib::Threads::Mutex::Lock lm (_edited_lock);
+		const bool all = _edited_all;
+
+		edited_start  = _edited_start;
+		edited_end    = _edited_end;
+		_edited_start = std::numeric_limits<Temporal::Beats>::max ();
+		_edited_end   = Temporal::Beats ();
+		_edited_all   = false;
+
+		if (all) {
+			return false;
+		}
+	}
+
+	if (edited_start > edited_end) {
+		start = max_samplepos;
+		end   = 0;
+		return true;
+	}
+
+	/* same conversion as MidiSource::midi_read() */
+	const Temporal::Beats source_start = source_position ().beats ();
+
+	start = timepos_t (source_start + edited_start).samples ();
+	end   = timepos_t (source_start + edited_end).samples ();
+
+	/* notes that are cut off by the end of the region are resolved there */
+	const samplepos_t resolve_at = (source_position () + this->start () + _length.val ()).samples ();
+
+	if (start <= resolve_at && end + 1 >= resolve_at) {
+		end = max (end, resolve_at);
+	}
+
+	return true;
+}
+
 void
 MidiRegion::model_shifted (timecnt_t distance)
 {
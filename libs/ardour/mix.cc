@@ -145,6 +145,47 @@ default_copy_vector (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pframes_t
 	memcpy(dst, src, nframes*sizeof(ARDOUR::Sample));
 }
 
+void
+default_apply_gain_ramp (ARDOUR::Sample * buf, pframes_t nframes, float gain_start, float gain_end)
+{
+	if (nframes == 0) {
+		return;
+	}
+	const float delta = (gain_end - gain_start) / (float) nframes;
+	for (pframes_t i = 0; i < nframes; i++) {
+		buf[i] *= gain_start + delta * (float) i;
+	}
+}
+
+void
+default_interleave (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pframes_t nframes, uint32_t channel, uint32_t n_channels)
+{
+	dst += channel;
+	for (pframes_t i = 0; i < nframes; i++) {
+		*dst = src[i];
+		dst += n_channels;
+	}
+}
+
+void
+default_deinterleave (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pframes_t nframes, uint32_t channel, uint32_t n_channels)
+{
+	src += channel;
+	for (pframes_t i = 0; i < nframes; i++) {
+		dst[i] = *src;
+		src += n_channels;
+	}
+}
+
+void
+default_float_to_s32 (int32_t * dst, const ARDOUR::Sample * src, pframes_t nframes)
+{
+	for (pframes_t i = 0; i < nframes; i++) {
+		const float s = min (1.f, max (-1.f, src[i]));
+		dst[i] = ((int32_t) (s * 8388607.f)) << 8;
+	}
+}
+
 #if defined (__APPLE__) && defined (BUILD_VECLIB_OPTIMIZATIONS)
 #include <Accelerate/Accelerate.h>
 
@@ -341,6 +341,7 @@ Playlist::init (bool hide)
 	_frozen                     = false;
 	_capture_insertion_underway = false;
 	_combine_ops = 0;
+	_region_index_dirty = true;
 	_end_space = timecnt_t (_type == DataType::AUDIO ? Temporal::AudioTime : Temporal::BeatTime);
 	_playlist_shift_active = false;
 
@@ -582,6 +583,8 @@ Playlist::flush_notifications (bool from_undo)
 
 	in_flush = true;
 
+	invalidate_region_index ();
+
 	if (!pending_bounds.empty () || !pending_removes.empty () || !pending_adds.empty ()) {
 		regions_changed = true;
 	}
@@ -771,6 +774,7 @@ Playlist::add_region_internal (boost::shared_ptr<Region> region, timepos_t const
 
 	regions.insert (upper_bound (regions.begin (), regions.end (), region, cmp), region);
 	all_regions.insert (region);
+	invalidate_region_index ();
 
 	if (!holding_state ()) {
 		/* layers get assigned from XML state, and are not reset during undo/redo */
@@ -826,6 +830,7 @@ Playlist::remove_region_internal (boost::shared_ptr<Region> region, ThawList& th
 		if (*i == region) {
 
 			regions.erase (i);
+			invalidate_region_index ();
 
 			if (!holding_state ()) {
 				relayer ();
@@ -1613,6 +1618,7 @@ Playlist::region_bounds_changed (const PropertyChange& what_changed, boost::shar
 
 		regions.erase (i);
 		regions.insert (upper_bound (regions.begin (), regions.end (), region, cmp), region);
+		invalidate_region_index ();
 
 		if (holding_state ()) {
 			pending_bounds.push_back (region);
@@ -1636,6 +1642,8 @@ Playlist::region_changed_proxy (const PropertyChange& what_changed, boost::weak_
 		return;
 	}
 
+	invalidate_region_index ();
+
 	/* this makes a virtual call to the right kind of playlist ... */
 
 	region_changed (what_changed, region);
@@ -1784,6 +1792,19 @@ Playlist::count_regions_at (timepos_t const & pos) const
 	RegionReadLock rlock (const_cast<Playlist*> (this));
 	uint32_t       cnt = 0;
 
+	boost::shared_ptr<RegionIntervalTree const> index = region_index ();
+
+	if (index) {
+		RegionList rl;
+		index->overlapping (pos, pos, rl);
+		for (auto const & r : rl) {
+			if (r->covers (pos)) {
+				cnt++;
+			}
+		}
+		return cnt;
+	}
+
 	for (auto const & r : regions) {
 		if (r->covers (pos)) {
 			cnt++;
@@ -1845,6 +1866,19 @@ Playlist::find_regions_at (timepos_t const & pos)
 
 	boost::shared_ptr<RegionList> rlist (new RegionList);
 
+	boost::shared_ptr<RegionIntervalTree const> index = region_index ();
+
+	if (index) {
+		RegionList candidates;
+		index->overlapping (pos, pos, candidates);
+		for (auto & r : candidates) {
+			if (r->covers (pos)) {
+				rlist->push_back (r);
+			}
+		}
+		return rlist;
+	}
+
 	for (auto & r : regions) {
 		if (r->covers (pos)) {
 			rlist->push_back (r);
@@ -1860,6 +1894,13 @@ Playlist::regions_with_start_within (Temporal::Range range)
 	RegionReadLock                rlock (this);
 	boost::shared_ptr<RegionList> rlist (new RegionList);
 
+	boost::shared_ptr<RegionIntervalTree const> index = region_index ();
+
+	if (index) {
+		index->starting_within (range.start (), range.end (), *rlist);
+		return rlist;
+	}
+
 	for (auto & r : regions) {
 		if (r->position() >= range.start() && r->position() < range.end()) {
 			rlist->push_back (r);
@@ -1896,6 +1937,19 @@ Playlist::regions_touched_locked (timepos_t const & start, timepos_t const & end
 {
 	boost::shared_ptr<RegionList> rlist (new RegionList);
 
+	boost::shared_ptr<RegionIntervalTree const> index = region_index ();
+
+	if (index) {
+		RegionList candidates;
+		index->overlapping (start, end, candidates);
+		for (auto & r : candidates) {
+			if (r->coverage (start, end) != Temporal::OverlapNone) {
+				rlist->push_back (r);
+			}
+		}
+		return rlist;
+	}
+
 	for (auto & r : regions) {
 		if (r->coverage (start, end) != Temporal::OverlapNone) {
 			rlist->push_back (r);
@@ -1970,6 +2024,14 @@ Playlist::find_next_region (timepos_t const & pos, RegionPoint point, int dir)
 	boost::shared_ptr<Region> ret;
 	timecnt_t closest = timecnt_t::max (pos.time_domain());
 
+	if (point == Start) {
+		/* regions are indexed by position */
+		boost::shared_ptr<RegionIntervalTree const> index = region_index ();
+		if (index) {
+			return dir == 1 ? index->first_starting_after (pos) : index->last_starting_before (pos);
+		}
+	}
+
 	bool end_iter = false;
 
 	for (auto const & r : regions) {
@@ -2132,12 +2194,39 @@ void
 Playlist::mark_session_dirty ()
 {
 	_cached_extent.reset ();
+	invalidate_region_index ();
 
 	if (!in_set_state && !holding_state ()) {
 		_session.set_dirty ();
 	}
 }
 
+void
+Playlist::invalidate_region_index ()
+{
+	Glib::Threads::Mutex::Lock lm (_region_index_lock);
+	_region_index_dirty = true;
+	_region_index.reset ();
+}
+
+boost::shared_ptr<RegionIntervalTree const>
+Playlist::region_index () const
+{
+	/* Caller must hold lock */
+
+	Glib::Threads::Mutex::Lock lm (_region_index_lock);
+
+	if (_region_index_dirty) {
+		_region_index_dirty = false;
+		/* a linear search is just as fast for a few regions */
+		if (regions.size () > 16 && RegionIntervalTree::usable (regions.rlist ())) {
+			_region_index.reset (new RegionIntervalTree (regions.rlist ()));
+		}
+	}
+
+	return _region_index;
+}
+
 void
 Playlist::rdiff (vector<Command*>& cmds) const
 {
@@ -877,6 +877,8 @@ PluginInsert::inplace_silence_unconnected (BufferSet& bufs, const PinMappings& o
 void
 PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t end, double speed, pframes_t nframes, samplecnt_t offset, bool with_auto)
 {
+	ProcessorTiming::Timer pt (_plugin_timing);
+
 	// TODO: atomically copy maps & _no_inplace
 	const bool no_inplace = _no_inplace;
 	PinMappings in_map (_in_map); // TODO Split case below overrides, use const& in_map
@@ -1334,6 +1336,8 @@ PluginInsert::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_sa
 		_delaybuffers.flush ();
 	}
 
+	_plugin_timing.commit ();
+
 	/* we have no idea whether the plugin generated silence or not, so mark
 	 * all buffers appropriately.
 	 */
@@ -3405,6 +3409,20 @@ PluginInsert::clear_stats ()
 	g_atomic_int_set (&_stat_reset, 1);
 }
 
+void
+PluginInsert::allocate_timing ()
+{
+	Processor::allocate_timing ();
+	_plugin_timing.allocate ();
+}
+
+void
+PluginInsert::reset_timing ()
+{
+	Processor::reset_timing ();
+	_plugin_timing.reset ();
+}
+
 std::ostream& operator<<(std::ostream& o, const ARDOUR::PluginInsert::Match& m)
 {
 	switch (m.method) {
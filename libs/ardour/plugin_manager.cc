@@ -69,6 +69,7 @@
 #include <glibmm/fileutils.h>
 
 #include "pbd/convert.h"
+#include "pbd/cpus.h"
 #include "pbd/file_utils.h"
 #include "pbd/tokenizer.h"
 #include "pbd/whitespace.h"
@@ -1785,9 +1786,17 @@ PluginManager::windows_vst_discover_from_path (string path, bool cache_only)
 	sort (plugin_objects.begin (), plugin_objects.end ());
 	plugin_objects.erase (unique (plugin_objects.begin (), plugin_objects.end ()), plugin_objects.end ());
 
+	std::set<std::string> done;
+	if (!cache_only) {
+		run_scanner_apps (Windows_VST, plugin_objects, done);
+	}
+
 	size_t n = 1;
 	size_t all_modules = plugin_objects.size ();
 	for (x = plugin_objects.begin(); x != plugin_objects.end (); ++x, ++n) {
+		if (done.find (*x) != done.end ()) {
+			continue;
+		}
 		reset_scan_cancel_state (true);
 		ARDOUR::PluginScanMessage (string_compose (_("VST2 (%1 / %2)"), n, all_modules), *x, !cache_only && !cancelled());
 		vst2_discover (*x, Windows_VST, cache_only || cancelled());
@@ -1868,9 +1877,17 @@ PluginManager::mac_vst_discover_from_path (string path, bool cache_only)
 	sort (plugin_objects.begin (), plugin_objects.end ());
 	plugin_objects.erase (unique (plugin_objects.begin (), plugin_objects.end ()), plugin_objects.end ());
 
+	std::set<std::string> done;
+	if (!cache_only) {
+		run_scanner_apps (MacVST, plugin_objects, done);
+	}
+
 	size_t n = 1;
 	size_t all_modules = plugin_objects.size ();
 	for (x = plugin_objects.begin(); x != plugin_objects.end (); ++x, ++n) {
+		if (done.find (*x) != done.end ()) {
+			continue;
+		}
 		reset_scan_cancel_state (true);
 		ARDOUR::PluginScanMessage (string_compose (_("VST2 (%1 / %2)"), n, all_modules), *x, !cache_only && !cancelled());
 		vst2_discover (*x, MacVST, cache_only || cancelled());
@@ -1928,9 +1945,17 @@ PluginManager::lxvst_discover_from_path (string path, bool cache_only)
 	sort (plugin_objects.begin (), plugin_objects.end ());
 	plugin_objects.erase (unique (plugin_objects.begin (), plugin_objects.end ()), plugin_objects.end ());
 
+	std::set<std::string> done;
+	if (!cache_only) {
+		run_scanner_apps (LXVST, plugin_objects, done);
+	}
+
 	size_t n = 1;
 	size_t all_modules = plugin_objects.size ();
 	for (x = plugin_objects.begin(); x != plugin_objects.end (); ++x, ++n) {
+		if (done.find (*x) != done.end ()) {
+			continue;
+		}
 		reset_scan_cancel_state (true);
 		ARDOUR::PluginScanMessage (string_compose (_("VST2 (%1 / %2)"), n, all_modules), *x, !cache_only && !cancelled());
 		vst2_discover (*x, LXVST, cache_only || cancelled());
@@ -2074,9 +2099,17 @@ PluginManager::vst3_discover_from_path (string const& path, bool cache_only)
 
 	find_paths_matching_filter (plugin_objects, paths, vst3_filter, 0, false, true, true);
 
+	std::set<std::string> done;
+	if (!cache_only) {
+		run_scanner_apps (VST3, plugin_objects, done);
+	}
+
 	size_t n = 1;
 	size_t all_modules = plugin_objects.size ();
 	for (vector<string>::iterator i = plugin_objects.begin(); i != plugin_objects.end (); ++i, ++n) {
+		if (done.find (*i) != done.end ()) {
+			continue;
+		}
 		reset_scan_cancel_state (true);
 		ARDOUR::PluginScanMessage (string_compose (_("VST3 (%1 / %2)"), n, all_modules), *i, !cache_only && !cancelled());
 		vst3_discover (*i, cache_only || cancelled ());
@@ -2301,6 +2334,279 @@ PluginManager::run_vst3_scanner_app (std::string bundle_path, PSLEPtr psle) cons
 
 #endif // VST3_SUPPORT
 
+#if (defined WINDOWS_VST_SUPPORT || defined MACVST_SUPPORT || defined LXVST_SUPPORT || defined VST3_SUPPORT)
+
+namespace {
+/** A scanner app, run by PluginManager::run_scanner_apps */
+struct ScanJob {
+	ScanJob (std::string const& p, std::string const& m)
+		: path (p)
+		, module (m)
+		, scanner (0)
+		, timeout (0)
+		, notime (true)
+		, skip (false)
+		, keep_running (false)
+	{}
+
+	~ScanJob () {
+		connection.disconnect ();
+		delete scanner;
+	}
+
+	std::string                               path;   ///< argument for the scanner app
+	std::string                               module; ///< blacklist and cache-file key
+	boost::shared_ptr<PluginScanLogEntry>     psle;
+	ARDOUR::SystemExec*                       scanner;
+	stringstream                              log;
+	PBD::ScopedConnection                     connection;
+	int                                       timeout; /* deciseconds */
+	bool                                      notime;
+	bool                                      skip;         ///< "cancel one" was requested for this scan
+	bool                                      keep_running; ///< "no timeout" was requested for this scan
+};
+}
+
+static void scan_job_log (std::string msg, stringstream* ss)
+{
+	*ss << msg;
+}
+
+static std::string
+scan_job_module (PluginType type, std::string const& path)
+{
+#ifdef VST3_SUPPORT
+	if (type == VST3) {
+		return module_path_vst3 (path);
+	}
+#endif
+	return path;
+}
+
+static bool
+scan_job_is_blacklisted (PluginType type, std::string const& module)
+{
+#ifdef VST3_SUPPORT
+	if (type == VST3) {
+		return vst3_is_blacklisted (module);
+	}
+#endif
+#if (defined WINDOWS_VST_SUPPORT || defined MACVST_SUPPORT || defined LXVST_SUPPORT)
+	return vst2_is_blacklisted (module);
+#else
+	return true;
+#endif
+}
+
+static void
+scan_job_blacklist (PluginType type, std::string const& module, bool yn)
+{
+#ifdef VST3_SUPPORT
+	if (type == VST3) {
+		if (yn) {
+			vst3_blacklist (module);
+		} else {
+			vst3_whitelist (module);
+		}
+		return;
+	}
+#endif
+#if (defined WINDOWS_VST_SUPPORT || defined MACVST_SUPPORT || defined LXVST_SUPPORT)
+	if (yn) {
+		vst2_blacklist (module);
+	} else {
+		vst2_whitelist (module);
+	}
+#endif
+}
+
+static std::string
+scan_job_cache_file (PluginType type, std::string const& module, bool valid)
+{
+#ifdef VST3_SUPPORT
+	if (type == VST3) {
+		return valid ? vst3_valid_cache_file (module) : vst3_cache_file (module);
+	}
+#endif
+#if (defined WINDOWS_VST_SUPPORT || defined MACVST_SUPPORT || defined LXVST_SUPPORT)
+	return valid ? vst2_valid_cache_file (module) : vst2_cache_file (module);
+#else
+	return "";
+#endif
+}
+
+/** Run the scanner app for all modules in @a paths that have no valid
+ * cache file, several at a time. This only (re-)generates cache files
+ * and the scan-log; vst2_discover() and vst3_discover() later load the
+ * cache files, in order.
+ *
+ * The scan of modules that are added to @a done was cancelled or timed
+ * out. They must not be scanned again.
+ */
+void
+PluginManager::run_scanner_apps (PluginType type, std::vector<std::string> const& paths, std::set<std::string>& done)
+{
+	std::string bin = type == VST3 ? vst3_scanner_bin_path : vst2_scanner_bin_path;
+	std::string ptn = type == VST3 ? X_("VST3") : X_("VST2");
+
+	uint32_t n_jobs = Config->get_plugin_scan_jobs ();
+	if (n_jobs == 0) {
+		n_jobs = std::min<uint32_t> (16, hardware_concurrency ());
+	}
+
+	if (bin.empty () || n_jobs < 2) {
+		return;
+	}
+
+	std::list<ScanJob*> queue;
+	for (vector<string>::const_iterator i = paths.begin(); i != paths.end (); ++i) {
+		std::string module = scan_job_module (type, *i);
+		if (module.empty () || scan_job_is_blacklisted (type, module)) {
+			continue;
+		}
+		if (!scan_job_cache_file (type, module, true).empty ()) {
+			continue;
+		}
+		queue.push_back (new ScanJob (*i, module));
+	}
+
+	if (queue.size () < 2) {
+		/* nothing to gain */
+		for (std::list<ScanJob*>::iterator i = queue.begin(); i != queue.end (); ++i) {
+			delete *i;
+		}
+		return;
+	}
+
+	DEBUG_TRACE (DEBUG::PluginManager, string_compose ("%1: scan %2 modules using %3 processes\n", ptn, queue.size (), n_jobs));
+
+	std::list<ScanJob*> running;
+	size_t n           = 0;
+	size_t all_modules = queue.size ();
+
+	while (!queue.empty () || !running.empty ()) {
+
+		while (!queue.empty () && running.size () < n_jobs && !_cancel_scan_all) {
+			ScanJob* j = queue.front ();
+			queue.pop_front ();
+
+			ARDOUR::PluginScanMessage (string_compose (_("%1 (%2 / %3)"), ptn, ++n, all_modules), j->path, true);
+
+			j->psle = scan_log_entry (type, j->path);
+			j->psle->reset ();
+			scan_job_blacklist (type, j->module, true);
+			j->psle->msg (PluginScanLogEntry::OK, string_compose ("%1 module-path '%2'", ptn, j->module));
+
+			char **argp= (char**) calloc (5, sizeof (char*));
+			argp[0] = strdup (bin.c_str ());
+			argp[1] = strdup ("-f");
+			if (Config->get_verbose_plugin_scan()) {
+				argp[2] = strdup ("-v");
+			} else {
+				argp[2] = strdup ("-f");
+			}
+			argp[3] = strdup (j->path.c_str ());
+			argp[4] = 0;
+
+			j->scanner = new ARDOUR::SystemExec (bin, argp);
+			j->scanner->ReadStdout.connect_same_thread (j->connection, boost::bind (&scan_job_log, _1, &j->log));
+
+			if (j->scanner->start (ARDOUR::SystemExec::MergeWithStdin)) {
+				j->psle->msg (PluginScanLogEntry::Error, string_compose (_("Cannot launch VST scanner app '%1': %2"), bin, strerror (errno)));
+				done.insert (j->path);
+				delete j;
+				continue;
+			}
+
+			j->timeout = _enable_scan_timeout ? 1 + Config->get_plugin_scan_timeout() : 0;
+			j->notime  = j->timeout <= 0;
+			running.push_back (j);
+		}
+
+		if (_cancel_scan_all) {
+			/* remaining modules are not scanned, vst*_discover() will log them as new */
+			for (std::list<ScanJob*>::iterator i = queue.begin(); i != queue.end (); ++i) {
+				delete *i;
+			}
+			queue.clear ();
+		}
+
+		Glib::usleep (100000);
+
+		for (std::list<ScanJob*>::iterator i = running.begin(); i != running.end ();) {
+			ScanJob* j = *i;
+
+			if (!j->scanner->is_running ()) {
+				j->psle->msg (PluginScanLogEntry::OK, j->log.str());
+				if (scan_job_cache_file (type, j->module, true).empty ()) {
+					/* scanner crashed, the module remains blacklisted */
+					j->psle->msg (PluginScanLogEntry::Error, _("Scan Failed."));
+				}
+				delete j;
+				i = running.erase (i);
+				continue;
+			}
+			++i;
+		}
+
+		/* "skip" and "no timeout" of a single plugin apply to the
+		 * oldest scan, whose timeout is displayed (see below).
+		 */
+		if (!running.empty ()) {
+			if (_cancel_scan_one) {
+				running.front ()->skip = true;
+			}
+			if (_cancel_scan_timeout_one) {
+				running.front ()->keep_running = true;
+			}
+		}
+		reset_scan_cancel_state (true);
+
+		for (std::list<ScanJob*>::iterator i = running.begin(); i != running.end ();) {
+			ScanJob* j = *i;
+
+			bool cancel     = _cancel_scan_all || j->skip;
+			bool no_timeout = _cancel_scan_timeout_all || j->keep_running;
+
+			if (!j->notime && no_timeout) {
+				j->notime  = true;
+				j->timeout = -1;
+			} else if (j->notime && !no_timeout && _enable_scan_timeout) {
+				j->notime  = false;
+				j->timeout = 1 + Config->get_plugin_scan_timeout ();
+			}
+			if (j->timeout > -864000) {
+				--j->timeout;
+			}
+
+			if (cancel || (!j->notime && j->timeout == 0)) {
+				j->scanner->terminate ();
+				j->psle->msg (PluginScanLogEntry::OK, j->log.str());
+				if (cancel) {
+					j->psle->msg (PluginScanLogEntry::New, "Scan was cancelled.");
+				} else {
+					j->psle->msg (PluginScanLogEntry::TimeOut, "Scan Timed Out.");
+				}
+				/* may be partially written */
+				g_unlink (scan_job_cache_file (type, j->module, false).c_str ());
+				scan_job_blacklist (type, j->module, false);
+				done.insert (j->path);
+				delete j;
+				i = running.erase (i);
+				continue;
+			}
+			++i;
+		}
+
+		if (!running.empty ()) {
+			/* show the oldest scan's timeout */
+			ARDOUR::PluginScanTimeout (running.front ()->timeout);
+		}
+	}
+}
+
+#endif
+
 PluginManager::PluginStatusType
 PluginManager::get_status (const PluginInfoPtr& pi) const
 {
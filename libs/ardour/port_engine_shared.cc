@@ -32,6 +32,7 @@ BackendPort::BackendPort (PortEngineSharedImpl &b, const std::string& name, Port
 	: _backend (b)
 	, _name  (name)
 	, _flags (flags)
+	, _connection_plan (new ConnectionPlan)
 {
 	_capture_latency_range.min = 0;
 	_capture_latency_range.max = 0;
@@ -96,6 +97,7 @@ void
 BackendPort::store_connection (BackendPortHandle port)
 {
 	_connections.insert (port);
+	update_connection_plan ();
 }
 
 int
@@ -125,6 +127,7 @@ void BackendPort::remove_connection (BackendPortHandle port)
 	std::set<BackendPortPtr>::iterator it = _connections.find (port);
 	assert (it != _connections.end ());
 	_connections.erase (it);
+	update_connection_plan ();
 }
 
 
@@ -136,6 +139,15 @@ void BackendPort::disconnect_all (BackendPortHandle self)
 		_backend.port_connect_callback (name(), (*it)->name(), false);
 		_connections.erase (it);
 	}
+	update_connection_plan ();
+}
+
+void
+BackendPort::update_connection_plan ()
+{
+	RCUWriter<ConnectionPlan> writer (_connection_plan);
+	boost::shared_ptr<ConnectionPlan> cp = writer.get_copy ();
+	cp->assign (_connections.begin (), _connections.end ());
 }
 
 bool
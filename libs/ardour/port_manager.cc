@@ -46,6 +46,7 @@
 #include "ardour/port_manager.h"
 #include "ardour/profile.h"
 #include "ardour/rt_tasklist.h"
+#include "ardour/runtime_functions.h"
 #include "ardour/session.h"
 #include "ardour/types_convert.h"
 
@@ -1266,12 +1267,7 @@ PortManager::cycle_end_fade_out (gain_t base_gain, gain_t gain_step, pframes_t n
 			boost::shared_ptr<AudioPort> ap = boost::dynamic_pointer_cast<AudioPort> (p->second);
 			if (ap) {
 				Sample* s = ap->engine_get_whole_audio_buffer ();
-				gain_t  g = base_gain;
-
-				for (pframes_t n = 0; n < nframes; ++n) {
-					*s++ *= g;
-					g -= gain_step;
-				}
+				apply_gain_ramp (s, nframes, base_gain, base_gain - nframes * gain_step);
 			}
 		}
 	}
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include <glibmm/timer.h>
+
+#include "ardour/processor_timing.h"
+
+using namespace ARDOUR;
+
+GATOMIC_QUAL gint ProcessorTiming::_enabled = 0;
+bool   ProcessorTiming::_use_cycle_counter = false;
+double ProcessorTiming::_ticks_per_usec    = 1.0;
+
+#define g_atomic_uint_get(x) static_cast<guint> (g_atomic_int_get (x))
+
+ProcessorTiming::ProcessorTiming ()
+	: _window (0)
+	, _start (0)
+	, _accum (0)
+	, _running (false)
+{
+	g_atomic_int_set (&_write_pos, 0);
+	g_atomic_int_set (&_reset, 0);
+	if (enabled ()) {
+		allocate ();
+	}
+}
+
+ProcessorTiming::~ProcessorTiming ()
+{
+	delete [] _window.load ();
+}
+
+/** Measure the rate of the cycle counter. If it is not usable
+ * (not available on this platform, or it wraps too fast), the
+ * microsecond clock is used instead.
+ */
+void
+ProcessorTiming::calibrate ()
+{
+	static bool calibrated = false;
+	if (calibrated) {
+		return;
+	}
+	calibrated = true;
+
+	cycles_t             c0 = get_cycles ();
+	PBD::microseconds_t  t0 = PBD::get_microseconds ();
+	Glib::usleep (20000);
+	cycles_t             c1 = get_cycles ();
+	PBD::microseconds_t  t1 = PBD::get_microseconds ();
+
+	if (c1 > c0 && t1 > t0 && sizeof (cycles_t) >= sizeof (uint64_t)) {
+		_ticks_per_usec    = (double) (c1 - c0) / (double) (t1 - t0);
+		/* a single processor must not exceed 32bit worth of ticks */
+		_use_cycle_counter = _ticks_per_usec >= 1.0 && _ticks_per_usec < 100000.0;
+	}
+
+	if (!_use_cycle_counter) {
+		_ticks_per_usec = 1.0;
+	}
+}
+
+void
+ProcessorTiming::set_enabled (bool yn)
+{
+	if (yn) {
+		calibrate ();
+	}
+	g_atomic_int_set (&_enabled, yn ? 1 : 0);
+}
+
+void
+ProcessorTiming::allocate ()
+{
+	if (_window.load ()) {
+		return;
+	}
+	uint32_t* w = new uint32_t[window_size];
+	std::fill (w, w + window_size, 0);
+	g_atomic_int_set (&_write_pos, 0);
+	/* publish the initialized buffer */
+	_window.store (w, std::memory_order_release);
+}
+
+void
+ProcessorTiming::commit ()
+{
+	uint32_t* w = _window.load (std::memory_order_acquire);
+	if (!w) {
+		_accum = 0;
+		return;
+	}
+	if (g_atomic_int_compare_and_exchange (&_reset, 1, 0)) {
+		g_atomic_int_set (&_write_pos, 0);
+		_accum = 0;
+		return;
+	}
+	if (_accum == 0) {
+		/* not enabled, or not processed this cycle */
+		return;
+	}
+	guint pos = g_atomic_uint_get (&_write_pos);
+	w[pos & (window_size - 1)] = _accum;
+	g_atomic_int_set (&_write_pos, pos + 1);
+	_accum = 0;
+}
+
+bool
+ProcessorTiming::get_stats (double& min, double& avg, double& p99, double& max) const
+{
+	uint32_t const* w = _window.load (std::memory_order_acquire);
+	if (!w) {
+		return false;
+	}
+
+	guint n = std::min (g_atomic_uint_get (&_write_pos), (guint) window_size);
+	if (n < 2) {
+		return false;
+	}
+
+	/* The process thread may overwrite the oldest entries while we copy,
+	 * the result is still a valid sample of recent cycles.
+	 */
+	std::vector<uint32_t> v (w, w + n);
+
+	uint64_t sum = 0;
+	for (std::vector<uint32_t>::const_iterator i = v.begin (); i != v.end (); ++i) {
+		sum += *i;
+	}
+
+	std::vector<uint32_t>::iterator pc = v.begin () + (n - 1) * 99 / 100;
+	std::nth_element (v.begin (), pc, v.end ());
+	p99 = *pc / _ticks_per_usec;
+
+	min = *std::min_element (v.begin (), v.end ()) / _ticks_per_usec;
+	max = *std::max_element (v.begin (), v.end ()) / _ticks_per_usec;
+	avg = sum / (double) n / _ticks_per_usec;
+	return true;
+}
@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+
+#include "ardour/region.h"
+#include "ardour/region_interval_tree.h"
+
+using namespace ARDOUR;
+using namespace Temporal;
+
+RegionIntervalTree::Entry::Entry (boost::shared_ptr<Region> const& r)
+	: position (r->position ())
+	, last (r->nt_last ())
+	, max_last (last)
+	, region (r)
+{
+}
+
+RegionIntervalTree::RegionIntervalTree (RegionList const& regions)
+{
+	_entries.reserve (regions.size ());
+
+	for (RegionList::const_iterator i = regions.begin (); i != regions.end (); ++i) {
+		_entries.push_back (Entry (*i));
+	}
+
+	/* the playlist's list is sorted by position, except during some
+	 * edit operations. Keep the playlist order of regions at the same
+	 * position.
+	 */
+	std::stable_sort (_entries.begin (), _entries.end (), EntrySortByPosition ());
+
+	if (!_entries.empty ()) {
+		build (0, _entries.size ());
+	}
+}
+
+bool
+RegionIntervalTree::usable (RegionList const& regions)
+{
+	if (regions.empty ()) {
+		return true;
+	}
+
+	const TimeDomain td = regions.front ()->position ().time_domain ();
+
+	for (RegionList::const_iterator i = regions.begin (); i != regions.end (); ++i) {
+		if ((*i)->position ().time_domain () != td || (*i)->length ().time_domain () != td) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+timepos_t
+RegionIntervalTree::build (size_t lo, size_t hi)
+{
+	const size_t mid = (lo + hi) / 2;
+	Entry&       e   = _entries[mid];
+
+	e.max_last = e.last;
+
+	if (lo < mid) {
+		e.max_last = std::max (e.max_last, build (lo, mid));
+	}
+	if (mid + 1 < hi) {
+		e.max_last = std::max (e.max_last, build (mid + 1, hi));
+	}
+
+	return e.max_last;
+}
+
+void
+RegionIntervalTree::overlapping (timepos_t const& start, timepos_t const& end, RegionList& rl) const
+{
+	if (!_entries.empty ()) {
+		overlapping (0, _entries.size (), start, end, rl);
+	}
+}
+
+void
+RegionIntervalTree::overlapping (size_t lo, size_t hi, timepos_t const& start, timepos_t const& end, RegionList& rl) const
+{
+	if (lo >= hi) {
+		return;
+	}
+
+	const size_t mid = (lo + hi) / 2;
+	Entry const& e   = _entries[mid];
+
+	if (e.max_last < start) {
+		/* everything in this subtree ends before the range */
+		return;
+	}
+
+	/* in-order traversal, to return regions sorted by position */
+	overlapping (lo, mid, start, end, rl);
+
+	if (e.position > end) {
+		/* this and all later regions start after the range */
+		return;
+	}
+
+	if (e.last >= start) {
+		rl.push_back (e.region);
+	}
+
+	overlapping (mid + 1, hi, start, end, rl);
+}
+
+size_t
+RegionIntervalTree::lower_bound (timepos_t const& pos) const
+{
+	size_t lo = 0;
+	size_t hi = _entries.size ();
+
+	while (lo < hi) {
+		const size_t mid = (lo + hi) / 2;
+		if (_entries[mid].position < pos) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+size_t
+RegionIntervalTree::upper_bound (timepos_t const& pos) const
+{
+	size_t lo = 0;
+	size_t hi = _entries.size ();
+
+	while (lo < hi) {
+		const size_t mid = (lo + hi) / 2;
+		if (_entries[mid].position <= pos) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+void
+RegionIntervalTree::starting_within (timepos_t const& start, timepos_t const& end, RegionList& rl) const
+{
+	for (size_t i = lower_bound (start); i < _entries.size () && _entries[i].position < end; ++i) {
+		rl.push_back (_entries[i].region);
+	}
+}
+
+boost::shared_ptr<Region>
+RegionIntervalTree::first_starting_after (timepos_t const& pos) const
+{
+	const size_t i = upper_bound (pos);
+	if (i < _entries.size ()) {
+		return _entries[i].region;
+	}
+	return boost::shared_ptr<Region> ();
+}
+
+boost::shared_ptr<Region>
+RegionIntervalTree::last_starting_before (timepos_t const& pos) const
+{
+	size_t i = lower_bound (pos);
+	if (i == 0) {
+		return boost::shared_ptr<Region> ();
+	}
+	--i;
+	/* go back to the first region at this position */
+	while (i > 0 && _entries[i - 1].position == _entries[i].position) {
+		--i;
+	}
+	return _entries[i].region;
+}
@@ -535,12 +535,17 @@ Route::process_output_buffers (BufferSet& bufs,
 			}
 		}
 
+		(*i)->timing ().start ();
+
 		if (speed < 0) {
 			(*i)->run (bufs, start_sample + latency, end_sample + latency, pspeed, nframes, *i != _processors.back());
 		} else {
 			(*i)->run (bufs, start_sample - latency, end_sample - latency, pspeed, nframes, *i != _processors.back());
 		}
 
+		(*i)->timing ().stop ();
+		(*i)->timing ().commit ();
+
 		bufs.set_count ((*i)->output_streams());
 
 		if (re_inject_oob_data) {
@@ -369,6 +369,120 @@ RTMidiBuffer::read (MidiBuffer& dst, samplepos_t start, samplepos_t end, MidiNot
 	return count;
 }
 
+void
+RTMidiBuffer::replace (samplepos_t start, samplepos_t end, RTMidiBuffer const& src)
+{
+	assert (!_reversed && !src._reversed);
+
+	Item foo;
+	foo.timestamp = start;
+	const size_t first = lower_bound (_data, _data + _size, foo, item_item_earlier) - _data;
+	foo.timestamp = end;
+	const size_t last = upper_bound (_data + first, _data + _size, foo, item_item_earlier) - _data;
+
+	const size_t new_size = _size - (last - first) + src._size;
+
+	if (new_size >= _capacity) {
+		resize (new_size + 1024); // XXX 1024 is completely arbitrary, see ::write()
+	}
+
+	/* move everything after the range into place, then fill the gap */
+
+	if (last < _size && first + src._size != last) {
+		memmove (&_data[first + src._size], &_data[last], (_size - last) * sizeof (Item));
+	}
+
+	for (size_t n = 0; n < src._size; ++n) {
+
+		Item const& item (src._data[n]);
+
+		assert (item.timestamp >= start && item.timestamp <= end);
+
+		_data[first + n] = item;
+
+		if (item.bytes[0]) {
+			uint32_t offset = item.offset & ~(1<<(CHAR_BIT-1));
+			Blob const* blob = reinterpret_cast<Blob const*> (&src._pool[offset]);
+			uint32_t off = store_blob (blob->size, blob->data);
+			_data[first + n].offset = (off | (1<<(CHAR_BIT-1)));
+		}
+	}
+
+	_size = new_size;
+}
+
+static bool
+item_is_note (ARDOUR::RTMidiBuffer::Item const & item)
+{
+	if (item.bytes[0]) {
+		return false;
+	}
+
+	switch (item.bytes[1] & 0xf0) {
+	case MIDI_CMD_NOTE_ON:
+	case MIDI_CMD_NOTE_OFF:
+		return true;
+	default:
+		return false;
+	}
+}
+
+void
+RTMidiBuffer::replace_notes (samplepos_t start, samplepos_t end, RTMidiBuffer const& notes)
+{
+	assert (!_reversed && !notes._reversed);
+
+	Item foo;
+	foo.timestamp = start;
+	const size_t first = lower_bound (_data, _data + _size, foo, item_item_earlier) - _data;
+	foo.timestamp = end;
+	const size_t last = upper_bound (_data + first, _data + _size, foo, item_item_earlier) - _data;
+
+	/* merge the remaining events of the range with the new notes, in the
+	 * order used by MidiPlaylist::render() for simultaneous events.
+	 */
+
+	RTMidiBuffer range;
+	size_t       n = 0;
+
+	for (size_t i = first; i < last; ++i) {
+
+		Item const& item (_data[i]);
+
+		if (item_is_note (item)) {
+			continue;
+		}
+
+		uint32_t       size;
+		uint8_t const* addr = bytes (item, size);
+
+		for (; n < notes._size; ++n) {
+			Item const& note (notes._data[n]);
+
+			assert (item_is_note (note));
+
+			if (note.timestamp > item.timestamp) {
+				break;
+			}
+			if (note.timestamp == item.timestamp && !MidiBuffer::second_simultaneous_midi_byte_is_first (addr[0], note.bytes[1])) {
+				break;
+			}
+
+			range.write (note.timestamp, Evoral::MIDI_EVENT, Evoral::midi_event_size (note.bytes[1]), &note.bytes[1]);
+		}
+
+		range.write (item.timestamp, Evoral::MIDI_EVENT, size, addr);
+	}
+
+	for (; n < notes._size; ++n) {
+		Item const& note (notes._data[n]);
+		assert (item_is_note (note));
+		range.write (note.timestamp, Evoral::MIDI_EVENT, Evoral::midi_event_size (note.bytes[1]), &note.bytes[1]);
+	}
+
+	replace (start, end, range);
+}
+
 uint32_t
 RTMidiBuffer::alloc_blob (uint32_t size)
 {
@@ -62,6 +62,7 @@
 #include "ardour/analyser.h"
 #include "ardour/async_midi_port.h"
 #include "ardour/audio_buffer.h"
+#include "ardour/audio_clip_cache.h"
 #include "ardour/audio_port.h"
 #include "ardour/audio_track.h"
 #include "ardour/audioengine.h"
@@ -239,6 +240,7 @@ Session::Session (AudioEngine &eng,
 	, _state_of_the_state (StateOfTheState (CannotSave | InitialConnecting | Loading))
 	, _save_queued (false)
 	, _save_queued_pending (false)
+	, _pending_save_thread (0)
 	, _last_roll_location (0)
 	, _last_roll_or_reversal_location (0)
 	, _last_record_location (0)
@@ -763,6 +765,9 @@ Session::destroy ()
 		sources.clear ();
 	}
 
+	/* decoded trigger clips of this session's sources are no longer used */
+	AudioClipCache::instance().clear ();
+
 	/* not strictly necessary, but doing it here allows the shared_ptr debugging to work */
 	_playlists.reset ();
 
@@ -6191,6 +6196,97 @@ Session::plot_process_graph (std::string const& file_name) const {
 	return _process_graph ? _process_graph->plot (file_name) : false;
 }
 
+bool
+Session::process_graph_critical_path (float& predicted_usec, float& actual_usec) const {
+	return _process_graph ? _process_graph->critical_path (predicted_usec, actual_usec) : false;
+}
+
+static void
+allocate_processor_timing_cb (boost::weak_ptr<Processor> wp)
+{
+	boost::shared_ptr<Processor> p = wp.lock ();
+	if (p) {
+		p->allocate_timing ();
+	}
+}
+
+static void
+reset_processor_timing_cb (boost::weak_ptr<Processor> wp)
+{
+	boost::shared_ptr<Processor> p = wp.lock ();
+	if (p) {
+		p->reset_timing ();
+	}
+}
+
+void
+Session::set_processor_timing_enabled (bool yn)
+{
+	if (yn) {
+		/* processors created from now on allocate their buffer on construction */
+		boost::shared_ptr<RouteList> rl = routes.reader ();
+		for (RouteList::iterator i = rl->begin (); i != rl->end (); ++i) {
+			(*i)->foreach_processor (&allocate_processor_timing_cb);
+		}
+	}
+	ProcessorTiming::set_enabled (yn);
+}
+
+bool
+Session::processor_timing_enabled () const
+{
+	return ProcessorTiming::enabled ();
+}
+
+void
+Session::reset_processor_timing ()
+{
+	boost::shared_ptr<RouteList> rl = routes.reader ();
+	for (RouteList::iterator i = rl->begin (); i != rl->end (); ++i) {
+		(*i)->foreach_processor (&reset_processor_timing_cb);
+	}
+}
+
+namespace {
+struct ProcessorDSPLoad {
+	ProcessorDSPLoad (boost::shared_ptr<Processor> p, double l) : proc (p), p99 (l) {}
+	bool operator< (ProcessorDSPLoad const& other) const { return p99 > other.p99; }
+	boost::shared_ptr<Processor> proc;
+	double p99;
+};
+
+void
+collect_processor_dsp_load (boost::weak_ptr<Processor> wp, std::vector<ProcessorDSPLoad>* rv)
+{
+	boost::shared_ptr<Processor> p = wp.lock ();
+	double min, avg, p99, max;
+	if (p && p->get_dsp_timing (min, avg, p99, max)) {
+		rv->push_back (ProcessorDSPLoad (p, p99));
+	}
+}
+}
+
+std::list<boost::shared_ptr<Processor> >
+Session::processors_by_dsp_load (uint32_t max_count) const
+{
+	std::vector<ProcessorDSPLoad> pl;
+	boost::shared_ptr<RouteList> rl = routes.reader ();
+	for (RouteList::iterator i = rl->begin (); i != rl->end (); ++i) {
+		(*i)->foreach_processor (boost::bind (&collect_processor_dsp_load, _1, &pl));
+	}
+
+	std::stable_sort (pl.begin (), pl.end ());
+
+	std::list<boost::shared_ptr<Processor> > rv;
+	for (std::vector<ProcessorDSPLoad>::const_iterator i = pl.begin (); i != pl.end (); ++i) {
+		if (max_count > 0 && rv.size () >= max_count) {
+			break;
+		}
+		rv.push_back (i->proc);
+	}
+	return rv;
+}
+
 void
 Session::add_automation_list(AutomationList *al)
 {
@@ -676,6 +676,17 @@ Session::maybe_write_autosave()
 void
 Session::remove_pending_capture_state ()
 {
+	/* no pending save may be started meanwhile */
+	Glib::Threads::Mutex::Lock lm (save_state_lock);
+	remove_pending_capture_state_locked ();
+}
+
+void
+Session::remove_pending_capture_state_locked ()
+{
+	/* do not let a pending save re-create the file */
+	wait_for_pending_save ();
+
 	std::string pending_state_file_path(_session_dir->root_path());
 
 	pending_state_file_path = Glib::build_filename (pending_state_file_path, legalize_for_path (_current_snapshot_name) + pending_suffix);
@@ -749,6 +760,77 @@ Session::remove_state (string snapshot_name)
 	StateSaved (snapshot_name); /* EMIT SIGNAL */
 }
 
+/** Write @p tree to @p tmp_path and rename it to @p xml_path,
+ * optionally flushing the file to disk first.
+ * @return true on success
+ */
+static bool
+write_state_file (XMLTree const& tree, std::string const& tmp_path, std::string const& xml_path, bool sync)
+{
+#ifndef NDEBUG
+	cerr << "actually writing state to " << tmp_path << endl;
+#endif
+
+	if (!tree.write (tmp_path)) {
+		error << string_compose (_("state could not be saved to %1"), tmp_path) << endmsg;
+		if (g_remove (tmp_path.c_str()) != 0) {
+			error << string_compose(_("Could not remove temporary session file at path \"%1\" (%2)"),
+					tmp_path, g_strerror (errno)) << endmsg;
+		}
+		return false;
+	}
+
+#ifndef PLATFORM_WINDOWS
+	if (sync) {
+		int fd = ::g_open (tmp_path.c_str (), O_RDONLY, 0);
+		if (fd >= 0) {
+			::fsync (fd);
+			::close (fd);
+		}
+	}
+#endif
+
+#ifndef NDEBUG
+	cerr << "renaming state to " << xml_path << endl;
+#endif
+
+	if (::g_rename (tmp_path.c_str(), xml_path.c_str()) != 0) {
+		error << string_compose (_("could not rename temporary session file %1 to %2 (%3)"),
+				tmp_path, xml_path, g_strerror(errno)) << endmsg;
+		if (g_remove (tmp_path.c_str()) != 0) {
+			error << string_compose(_("Could not remove temporary session file at path \"%1\" (%2)"),
+					tmp_path, g_strerror (errno)) << endmsg;
+		}
+		return false;
+	}
+
+	return true;
+}
+
+/** Thread function for pending saves, takes ownership of @p tree */
+static void
+write_pending_state (XMLTree* tree, std::string tmp_path, std::string xml_path, std::string backup_path)
+{
+	if (write_state_file (*tree, tmp_path, xml_path, true) && !backup_path.empty ()) {
+		if (!copy_file (xml_path, backup_path)) {
+			error << string_compose(_("Could not save backup file at path \"%1\" (%2)"),
+					backup_path, g_strerror (errno)) << endmsg;
+		}
+	}
+	delete tree;
+}
+
+void
+Session::wait_for_pending_save ()
+{
+	/* must be called with save_state_lock held */
+	if (_pending_save_thread) {
+		_pending_save_thread->join ();
+		delete _pending_save_thread;
+		_pending_save_thread = 0;
+	}
+}
+
 /** @param snapshot_name Name to save under, without .ardour / .pending prefix */
 int
 Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot, bool template_only, bool for_archive, bool only_used_assets)
@@ -775,6 +857,9 @@ Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot
 		lx.acquire ();
 	}
 
+	/* a previous pending save may still be writing the file */
+	wait_for_pending_save ();
+
 	if (!_writable || cannot_save()) {
 		return 1;
 	}
@@ -829,6 +914,7 @@ Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot
 		tree.set_root (&get_template());
 	} else {
 		tree.set_root (&state (false, fork_state, only_used_assets));
+		tree.set_binary (Config->get_save_binary_state ());
 	}
 
 	if (snapshot_name.empty()) {
@@ -861,38 +947,15 @@ Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot
 	std::string tmp_path(_session_dir->root_path());
 	tmp_path = Glib::build_filename (tmp_path, legalize_for_path (snapshot_name) + temp_suffix);
 
-#ifndef NDEBUG
-	cerr << "actually writing state to " << tmp_path << endl;
-#endif
-
-	if (!tree.write (tmp_path)) {
-		error << string_compose (_("state could not be saved to %1"), tmp_path) << endmsg;
-		if (g_remove (tmp_path.c_str()) != 0) {
-			error << string_compose(_("Could not remove temporary session file at path \"%1\" (%2)"),
-					tmp_path, g_strerror (errno)) << endmsg;
-		}
-		return -1;
-
-	} else {
-
-#ifndef NDEBUG
-		cerr << "renaming state to " << xml_path << endl;
-#endif
-
-		if (::g_rename (tmp_path.c_str(), xml_path.c_str()) != 0) {
-			error << string_compose (_("could not rename temporary session file %1 to %2 (%3)"),
-					tmp_path, xml_path, g_strerror(errno)) << endmsg;
-			if (g_remove (tmp_path.c_str()) != 0) {
-				error << string_compose(_("Could not remove temporary session file at path \"%1\" (%2)"),
-						tmp_path, g_strerror (errno)) << endmsg;
-			}
-			return -1;
-		}
-	}
+	if (pending) {
+		/* a pending save is a backup, or some other non-user-initiated save.
+		 * The state is complete, leave writing and syncing the file to
+		 * a background thread, so that periodic saves do not block the GUI.
+		 */
+		std::string backup_path;
 
-	//Mixbus auto-backup mechanism
-	if(Profile->get_mixbus()) {
-		if (pending) {  //"pending" save means it's a backup, or some other non-user-initiated save;  a good time to make a backup
+		//Mixbus auto-backup mechanism
+		if(Profile->get_mixbus()) {
 			// make a serialized safety backup
 			// (will make one periodically but only one per hour is left on disk)
 			// these backup files go into a separated folder
@@ -902,17 +965,28 @@ Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot
 			time (&n);
 			localtime_r (&n, &local_time);
 			strftime (timebuf, sizeof(timebuf), "%y-%m-%d.%H", &local_time);
-			std::string save_path(session_directory().backup_path());
-			save_path += G_DIR_SEPARATOR;
-			save_path += legalize_for_path(_current_snapshot_name);
-			save_path += "-";
-			save_path += timebuf;
-			save_path += statefile_suffix;
-			if (!copy_file (xml_path, save_path)) {
-					error << string_compose(_("Could not save backup file at path \"%1\" (%2)"),
-							save_path, g_strerror (errno)) << endmsg;
-			}
+			backup_path = session_directory().backup_path();
+			backup_path += G_DIR_SEPARATOR;
+			backup_path += legalize_for_path(_current_snapshot_name);
+			backup_path += "-";
+			backup_path += timebuf;
+			backup_path += statefile_suffix;
+		}
+
+		XMLTree* pending_tree = new XMLTree;
+		pending_tree->set_binary (tree.binary ());
+		pending_tree->set_root (tree.root ());
+		tree.set_root (0);
+
+		assert (!_pending_save_thread);
+		_pending_save_thread = PBD::Thread::create (boost::bind (&write_pending_state, pending_tree, tmp_path, xml_path, backup_path), "SaveState");
+
+		if (!_pending_save_thread) {
+			write_pending_state (pending_tree, tmp_path, xml_path, backup_path);
 		}
+
+	} else if (!write_state_file (tree, tmp_path, xml_path, false)) {
+		return -1;
 	}
 
 	if (!pending && !for_archive) {
@@ -932,7 +1006,7 @@ Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot
 #endif
 
 	if (!pending && !for_archive && ! template_only) {
-		remove_pending_capture_state ();
+		remove_pending_capture_state_locked ();
 	}
 
 	return 0;
@@ -4632,6 +4706,71 @@ Session::parse_stateful_loading_version (const std::string& version)
 	}
 }
 
+/** Same as the libxml2 based lookup in Session::get_info_from_path,
+ * for binary session files, which are read as XMLTree.
+ */
+static int
+get_info_from_node (XMLNode const& root, int version, float& sample_rate, SampleFormat& data_format, std::string& program_version, XMLNode* engine_hints)
+{
+	bool found_sr = false;
+	bool found_data_format = false;
+
+	if (root.get_property ("sample-rate", sample_rate)) {
+		found_sr = true;
+	}
+
+	if ((version / 1000L) > (CURRENT_SESSION_FILE_VERSION / 1000L)) {
+		return -1;
+	}
+
+	if ((version / 1000L) <= 2) {
+		/* sample-format '0' is implicit */
+		data_format = FormatFloat;
+		found_data_format = true;
+	}
+
+	XMLNode const* pv = root.child ("ProgramVersion");
+	if (pv && pv->get_property ("modified-with", program_version)) {
+		size_t sep = program_version.find_first_of ("-");
+		if (sep != string::npos) {
+			program_version = program_version.substr (0, sep);
+		}
+	}
+
+	XMLNode const* hints = root.child ("EngineHints");
+	if (engine_hints && hints) {
+		std::string val;
+		if (hints->get_property ("backend", val)) {
+			engine_hints->set_property ("backend", val);
+		}
+		if (hints->get_property ("input-device", val)) {
+			engine_hints->set_property ("input-device", val);
+		}
+		if (hints->get_property ("output-device", val)) {
+			engine_hints->set_property ("output-device", val);
+		}
+	}
+
+	XMLNode const* config = root.child ("Config");
+	if (config) {
+		XMLNodeList const& children (config->children ());
+		for (XMLNodeConstIterator i = children.begin (); i != children.end (); ++i) {
+			std::string val;
+			if (!(*i)->has_property_with_value ("name", "native-file-data-format") || !(*i)->get_property ("value", val)) {
+				continue;
+			}
+			try {
+				SampleFormat fmt = (SampleFormat) string_2_enum (val, fmt);
+				data_format = fmt;
+				found_data_format = true;
+			} catch (PBD::unknown_enumeration& e) {}
+			break;
+		}
+	}
+
+	return (found_sr && found_data_format) ? 0 : 1;
+}
+
 int
 Session::get_info_from_path (const string& xmlpath, float& sample_rate, SampleFormat& data_format, std::string& program_version, XMLNode* engine_hints)
 {
@@ -4649,6 +4788,15 @@ Session::get_info_from_path (const string& xmlpath, float& sample_rate, SampleFo
 		return -1;
 	}
 
+	if (XMLTree::is_binary_file (xmlpath)) {
+		XMLTree tree;
+		if (!tree.read (xmlpath)) {
+			return -1;
+		}
+		tree.root ()->get_property ("version", version);
+		return get_info_from_node (*tree.root (), parse_stateful_loading_version (version), sample_rate, data_format, program_version, engine_hints);
+	}
+
 	xmlParserCtxtPtr ctxt = xmlNewParserCtxt();
 	if (ctxt == NULL) {
 		return -1;
@@ -26,14 +26,21 @@
 #include "libardour-config.h"
 #endif
 
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <cerrno>
 #include <climits>
 #include <cstdarg>
 #include <fcntl.h>
+#include <unistd.h>
 
 #include <sys/stat.h>
 
+#ifndef PLATFORM_WINDOWS
+#include <sys/mman.h>
+#endif
+
 #include <glib.h>
 #include "pbd/gstdio_compat.h"
 
@@ -41,6 +48,7 @@
 #include <glibmm/fileutils.h>
 #include <glibmm/miscutils.h>
 
+#include "ardour/rc_configuration.h"
 #include "ardour/runtime_functions.h"
 #include "ardour/sndfilesource.h"
 #include "ardour/sndfile_helpers.h"
@@ -323,12 +331,20 @@ SndFileSource::init_sndfile ()
 
 	memset (&_info, 0, sizeof(_info));
 
+	_map_addr        = 0;
+	_map_length      = 0;
+	_map_data_offset = 0;
+	_map_last_read   = -1;
+	_map_direction   = 0;
+
 	AudioFileSource::HeaderPositionOffsetChanged.connect_same_thread (header_position_connection, boost::bind (&SndFileSource::handle_header_position_change, this));
 }
 
 void
 SndFileSource::close ()
 {
+	unmap_file ();
+
 	if (_sndfile) {
 		sf_close (_sndfile);
 		_sndfile = 0;
@@ -467,11 +483,236 @@ SndFileSource::open ()
                                 _broadcast_info = 0;
                         }
                 }
-        }
+        } else {
+		map_file ();
+	}
 
 	return 0;
 }
 
+static inline uint32_t
+le32 (uint8_t const* p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline uint16_t
+le16 (uint8_t const* p)
+{
+	return p[0] | (p[1] << 8);
+}
+
+/** Locate the sample data of a 32bit float WAV or RF64 file.
+ * @return offset of the first sample in the file, or 0 if the file
+ * is not of that format.
+ */
+static size_t
+float_wav_data_offset (uint8_t const* buf, size_t len, int channels)
+{
+	if (len < 12) {
+		return 0;
+	}
+	if (memcmp (buf, "RIFF", 4) && memcmp (buf, "RF64", 4) && memcmp (buf, "BW64", 4)) {
+		return 0;
+	}
+	if (memcmp (buf + 8, "WAVE", 4)) {
+		return 0;
+	}
+
+	bool is_float = false;
+	size_t pos    = 12;
+
+	while (pos + 8 <= len) {
+		uint8_t const* chunk = buf + pos;
+		uint32_t       size  = le32 (chunk + 4);
+
+		if (!memcmp (chunk, "fmt ", 4)) {
+			if (size < 16 || pos + 8 + size > len) {
+				return 0;
+			}
+			uint16_t tag = le16 (chunk + 8);
+			if (tag == 0xfffe /* WAVE_FORMAT_EXTENSIBLE */ && size >= 40) {
+				tag = le16 (chunk + 32);
+			}
+			is_float = tag == 0x0003 /* WAVE_FORMAT_IEEE_FLOAT */
+				&& le16 (chunk + 10) == channels
+				&& le16 (chunk + 22) == 32;
+		} else if (!memcmp (chunk, "data", 4)) {
+			return is_float ? pos + 8 : 0;
+		}
+
+		/* chunks are word-aligned */
+		pos += 8 + (size_t) size + (size & 1);
+	}
+	return 0;
+}
+
+void
+SndFileSource::map_file ()
+{
+#ifndef PLATFORM_WINDOWS
+	if (_map_addr || !Config->get_mmap_audio_sources ()) {
+		return;
+	}
+
+	if (G_BYTE_ORDER != G_LITTLE_ENDIAN) {
+		return;
+	}
+
+	switch (_info.format & SF_FORMAT_TYPEMASK) {
+		case SF_FORMAT_WAV:
+		case SF_FORMAT_WAVEX:
+		case SF_FORMAT_RF64:
+			break;
+		default:
+			return;
+	}
+
+	if ((_info.format & SF_FORMAT_SUBMASK) != SF_FORMAT_FLOAT || _info.channels < 1) {
+		return;
+	}
+
+	GStatBuf statbuf;
+	if (g_stat (_path.c_str (), &statbuf) != 0 || statbuf.st_size <= 0) {
+		return;
+	}
+
+	if (sizeof (void*) < 8 && statbuf.st_size > 0x20000000) {
+		/* do not exhaust the address-space on 32bit systems */
+		return;
+	}
+
+	int fd = ::open (_path.c_str (), O_RDONLY);
+	if (fd == -1) {
+		return;
+	}
+
+	size_t   len  = statbuf.st_size;
+	uint8_t* addr = (uint8_t*) mmap (0, len, PROT_READ, MAP_SHARED, fd, 0);
+	::close (fd);
+
+	if (addr == MAP_FAILED) {
+		return;
+	}
+
+	size_t off = float_wav_data_offset (addr, len, _info.channels);
+
+	if (off == 0 || off + (size_t) _info.frames * _info.channels * sizeof (float) > len) {
+		munmap (addr, len);
+		return;
+	}
+
+	_map_addr        = addr;
+	_map_length      = len;
+	_map_data_offset = off;
+	_map_last_read   = -1;
+	_map_direction   = 0;
+#endif
+}
+
+void
+SndFileSource::unmap_file ()
+{
+#ifndef PLATFORM_WINDOWS
+	if (_map_addr) {
+		munmap (_map_addr, _map_length);
+	}
+#endif
+	_map_addr   = 0;
+	_map_length = 0;
+}
+
+/** Tell the kernel which part of the file will be needed next.
+ *
+ * The direction is deduced from successive reads, the amount
+ * to read ahead scales with the transport speed.
+ */
+void
+SndFileSource::advise_read_ahead (samplepos_t start, samplecnt_t cnt) const
+{
+#ifndef PLATFORM_WINDOWS
+	int direction = 0;
+	if (_map_last_read >= 0) {
+		if (start >= _map_last_read && start <= _map_last_read + 2 * cnt) {
+			direction = 1;
+		} else if (start < _map_last_read && start + 2 * cnt >= _map_last_read) {
+			direction = -1;
+		}
+	}
+	_map_last_read = start;
+
+	if (direction != _map_direction) {
+		/* forward playback benefits from the kernel's own read-ahead,
+		 * for reverse playback and random access it only wastes I/O.
+		 */
+		madvise (_map_addr, _map_length, direction > 0 ? MADV_SEQUENTIAL : MADV_RANDOM);
+		_map_direction = direction;
+	}
+
+	if (direction == 0) {
+		return;
+	}
+
+	const double      speed = std::min (8.0, std::max (1.0, fabs (_session.transport_speed ())));
+	const samplecnt_t ahead = cnt * speed;
+	const size_t      bpf   = _info.channels * sizeof (float);
+
+	samplepos_t s = direction > 0 ? start + cnt : std::max<samplepos_t> (0, start - ahead);
+	samplepos_t e = direction > 0 ? std::min<samplepos_t> (_info.frames, start + cnt + ahead) : start;
+
+	if (e <= s) {
+		return;
+	}
+
+	const size_t page = sysconf (_SC_PAGESIZE);
+	size_t       from = (_map_data_offset + s * bpf) & ~(page - 1);
+	size_t       to   = _map_data_offset + e * bpf;
+
+	madvise (_map_addr + from, to - from, MADV_WILLNEED);
+#endif
+}
+
+/** Read directly from the memory-mapped file, this is used instead of
+ * libsndfile for read-only 32bit float WAV and RF64 files.
+ */
+samplecnt_t
+SndFileSource::read_mapped (Sample* dst, samplepos_t start, samplecnt_t cnt) const
+{
+	samplecnt_t file_cnt;
+
+	if (start >= _info.frames) {
+		file_cnt = 0;
+	} else if (start + cnt > _info.frames) {
+		file_cnt = _info.frames - start;
+	} else {
+		file_cnt = cnt;
+	}
+
+	if (file_cnt != cnt) {
+		memset (dst + file_cnt, 0, sizeof (Sample) * (cnt - file_cnt));
+	}
+
+	if (file_cnt == 0) {
+		return cnt;
+	}
+
+	advise_read_ahead (start, file_cnt);
+
+	float const* src = (float const*) (_map_addr + _map_data_offset) + start * _info.channels;
+
+	if (_info.channels == 1) {
+		memcpy (dst, src, sizeof (Sample) * file_cnt);
+	} else {
+		deinterleave (dst, src, file_cnt, _channel, _info.channels);
+	}
+
+	if (_gain != 1.f) {
+		apply_gain_to_buffer (dst, file_cnt, _gain);
+	}
+
+	return file_cnt;
+}
+
 SndFileSource::~SndFileSource ()
 {
 	close ();
@@ -490,7 +731,6 @@ SndFileSource::read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) c
 	assert (cnt >= 0);
 
 	samplecnt_t nread;
-	float *ptr;
 	samplecnt_t real_cnt;
 	samplepos_t file_cnt;
 
@@ -505,6 +745,10 @@ SndFileSource::read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) c
 		return 0;
         }
 
+	if (_map_addr) {
+		return read_mapped (dst, start, cnt);
+	}
+
         if (start > _length.samples()) {
 
 		/* read starts beyond end of data, just memset to zero */
@@ -561,21 +805,13 @@ SndFileSource::read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) c
 	Sample* interleave_buf = get_interleave_buffer (real_cnt);
 
 	nread = sf_read_float (_sndfile, interleave_buf, real_cnt);
-	ptr = interleave_buf + _channel;
 	nread /= _info.channels;
 
 	/* stride through the interleaved data */
+	deinterleave (dst, interleave_buf, nread, _channel, _info.channels);
 
 	if (_gain != 1.f) {
-		for (samplecnt_t n = 0; n < nread; ++n) {
-			dst[n] = *ptr * _gain;
-			ptr += _info.channels;
-		}
-	} else {
-		for (samplecnt_t n = 0; n < nread; ++n) {
-			dst[n] = *ptr;
-			ptr += _info.channels;
-		}
+		apply_gain_to_buffer (dst, nread, _gain);
 	}
 
 	return nread;
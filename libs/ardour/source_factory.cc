@@ -25,6 +25,7 @@
 #endif
 
 #include "pbd/convert.h"
+#include "pbd/cpus.h"
 #include "pbd/error.h"
 
 #include "ardour/audio_playlist_source.h"
@@ -103,8 +104,8 @@ peak_thread_work ()
 int
 SourceFactory::peak_work_queue_length ()
 {
-	// ideally we'd loop over the queue and check for duplicates
-	// and existing valid peak-files..
+	// duplicates are not queued, but this still includes
+	// existing valid peak-files..
 	return SourceFactory::files_with_peaks.size () + active_threads;
 }
 
@@ -115,7 +116,14 @@ SourceFactory::init ()
 		return;
 	}
 	peak_thread_run = true;
-	for (int n = 0; n < 2; ++n) {
+
+	/* Building peaks is partly I/O and partly decoding (compressed
+	 * formats) and peak computation. Build several files in parallel
+	 * to keep both the disk and CPU busy.
+	 */
+	const uint32_t n_threads = std::max<uint32_t> (2, std::min<uint32_t> (8, hardware_concurrency ()));
+
+	for (uint32_t n = 0; n < n_threads; ++n) {
 		peak_thread_pool.push_back (PBD::Thread::create (&peak_thread_work));
 	}
 }
@@ -130,7 +138,9 @@ SourceFactory::terminate ()
 	PeaksToBuild.broadcast ();
 	for (auto& t : peak_thread_pool) {
 		t->join ();
+		delete t;
 	}
+	peak_thread_pool.clear ();
 }
 
 int
@@ -142,8 +152,14 @@ SourceFactory::setup_peakfile (boost::shared_ptr<Source> s, bool async)
 		// immediately set 'peakfile-path' for empty and NoPeakFile sources
 		if (async && !as->empty () && !(as->flags () & Source::NoPeakFile)) {
 			Glib::Threads::Mutex::Lock lm (peak_building_lock);
+			for (auto const& f : files_with_peaks) {
+				if (f.lock () == as) {
+					/* already queued */
+					return 0;
+				}
+			}
 			files_with_peaks.push_back (boost::weak_ptr<AudioSource> (as));
-			PeaksToBuild.broadcast ();
+			PeaksToBuild.signal ();
 
 		} else {
 			if (as->setup_peakfile ()) {
@@ -0,0 +1,217 @@
+#include <atomic>
+
+#include <glibmm/threads.h>
+#include <glibmm/timer.h>
+#include <sigc++/bind.h>
+
+#include "audio_clip_cache_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (AudioClipCacheTest);
+
+using namespace ARDOUR;
+
+static const samplecnt_t clip_length = 1024;
+static const size_t      clip_bytes  = clip_length * sizeof (Sample);
+
+static std::atomic<int> n_reads;
+
+static bool
+read_ramp (AudioClipCache::Clip& clip)
+{
+	++n_reads;
+	clip.push_back (new Sample[clip.length]);
+	for (samplecnt_t s = 0; s < clip.length; ++s) {
+		clip[0][s] = s / (float) clip.length;
+	}
+	return true;
+}
+
+static bool
+read_fail (AudioClipCache::Clip&)
+{
+	++n_reads;
+	return false;
+}
+
+/* a reader that blocks until the gate is opened */
+static Glib::Threads::Mutex gate_lock;
+static Glib::Threads::Cond  gate_cond;
+static bool                 gate_open;
+static bool                 gate_entered;
+static bool                 gate_timeout;
+
+static bool
+wait_for (bool const& flag)
+{
+	/* gate_lock must be held */
+	const gint64 end_time = g_get_monotonic_time () + 10 * G_TIME_SPAN_SECOND;
+	while (!flag) {
+		if (!gate_cond.wait_until (gate_lock, end_time)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool
+read_gated (AudioClipCache::Clip& clip)
+{
+	{
+		Glib::Threads::Mutex::Lock lm (gate_lock);
+		gate_entered = true;
+		gate_cond.broadcast ();
+		if (!wait_for (gate_open)) {
+			gate_timeout = true;
+		}
+	}
+	return read_ramp (clip);
+}
+
+AudioClipCache::ClipPtr
+AudioClipCacheTest::get (AudioClipCache& cache, uint64_t source, size_t limit, Reader read)
+{
+	AudioClipCache::Key key;
+	key.sources.push_back (PBD::ID (source));
+	key.start       = 0;
+	key.length      = clip_length;
+	key.sample_rate = 48000;
+
+	return cache.get (key, "test", read, limit);
+}
+
+void
+AudioClipCacheTest::get_in_thread (AudioClipCache* cache, uint64_t source, Reader read, AudioClipCache::ClipPtr* result)
+{
+	*result = get (*cache, source, 100 * clip_bytes, read);
+}
+
+void
+AudioClipCacheTest::refcountTest ()
+{
+	AudioClipCache cache;
+	n_reads = 0;
+
+	AudioClipCache::ClipPtr a = get (cache, 1, 0, read_ramp);
+	CPPUNIT_ASSERT (a);
+	CPPUNIT_ASSERT_EQUAL (1, n_reads.load ());
+	CPPUNIT_ASSERT_EQUAL ((size_t) 1, a->size ());
+	CPPUNIT_ASSERT_EQUAL (clip_length, a->length);
+	CPPUNIT_ASSERT_EQUAL (clip_bytes, cache.size ());
+
+	/* the same data is shared */
+	AudioClipCache::ClipPtr b = get (cache, 1, 0, read_ramp);
+	CPPUNIT_ASSERT (a == b);
+	CPPUNIT_ASSERT_EQUAL (1, n_reads.load ());
+
+	/* clips that are in use are kept, even if the cache is over its limit */
+	cache.clear ();
+	CPPUNIT_ASSERT_EQUAL (clip_bytes, cache.size ());
+
+	a.reset ();
+	cache.clear ();
+	CPPUNIT_ASSERT_EQUAL (clip_bytes, cache.size ());
+	CPPUNIT_ASSERT (get (cache, 1, 0, read_ramp) == b);
+	CPPUNIT_ASSERT_EQUAL (1, n_reads.load ());
+
+	/* unused clips are dropped */
+	b.reset ();
+	cache.clear ();
+	CPPUNIT_ASSERT_EQUAL ((size_t) 0, cache.size ());
+
+	CPPUNIT_ASSERT (get (cache, 1, 0, read_ramp));
+	CPPUNIT_ASSERT_EQUAL (2, n_reads.load ());
+
+	/* failures are not cached */
+	CPPUNIT_ASSERT (!get (cache, 2, 0, read_fail));
+	CPPUNIT_ASSERT (!get (cache, 2, 0, read_fail));
+	CPPUNIT_ASSERT_EQUAL (4, n_reads.load ());
+}
+
+void
+AudioClipCacheTest::evictTest ()
+{
+	AudioClipCache cache;
+	n_reads = 0;
+
+	const size_t limit = 3 * clip_bytes;
+
+	for (uint64_t s = 1; s <= 3; ++s) {
+		CPPUNIT_ASSERT (get (cache, s, limit, read_ramp));
+	}
+	CPPUNIT_ASSERT_EQUAL (3, n_reads.load ());
+	CPPUNIT_ASSERT_EQUAL (limit, cache.size ());
+
+	/* use 1 again, 2 is now the least recently used clip */
+	CPPUNIT_ASSERT (get (cache, 1, limit, read_ramp));
+	CPPUNIT_ASSERT_EQUAL (3, n_reads.load ());
+
+	AudioClipCache::ClipPtr in_use = get (cache, 3, limit, read_ramp);
+
+	CPPUNIT_ASSERT (get (cache, 4, limit, read_ramp));
+	CPPUNIT_ASSERT_EQUAL (4, n_reads.load ());
+	CPPUNIT_ASSERT_EQUAL (limit, cache.size ());
+
+	/* 1, 3 and 4 are still cached */
+	CPPUNIT_ASSERT (get (cache, 1, limit, read_ramp));
+	CPPUNIT_ASSERT (get (cache, 4, limit, read_ramp));
+	CPPUNIT_ASSERT_EQUAL (4, n_reads.load ());
+
+	/* 2 was dropped */
+	CPPUNIT_ASSERT (get (cache, 2, limit, read_ramp));
+	CPPUNIT_ASSERT_EQUAL (5, n_reads.load ());
+	CPPUNIT_ASSERT_EQUAL (limit, cache.size ());
+
+	/* 3 is in use and stays, although it is the least recently used
+	 * clip, 1 was dropped instead.
+	 */
+	CPPUNIT_ASSERT (get (cache, 3, limit, read_ramp) == in_use);
+	CPPUNIT_ASSERT_EQUAL (5, n_reads.load ());
+	CPPUNIT_ASSERT (get (cache, 1, limit, read_ramp));
+	CPPUNIT_ASSERT_EQUAL (6, n_reads.load ());
+}
+
+void
+AudioClipCacheTest::concurrentTest ()
+{
+	AudioClipCache cache;
+	n_reads = 0;
+
+	gate_open    = false;
+	gate_entered = false;
+	gate_timeout = false;
+
+	AudioClipCache::ClipPtr first;
+	AudioClipCache::ClipPtr second;
+
+	/* decode clip 1 in a thread, which blocks while decoding */
+	Glib::Threads::Thread* t1 = Glib::Threads::Thread::create (sigc::bind (sigc::ptr_fun (&AudioClipCacheTest::get_in_thread), &cache, 1, &read_gated, &first));
+
+	{
+		Glib::Threads::Mutex::Lock lm (gate_lock);
+		CPPUNIT_ASSERT (wait_for (gate_entered));
+	}
+
+	/* other clips can be used meanwhile */
+	CPPUNIT_ASSERT (get (cache, 2, 100 * clip_bytes, read_ramp));
+	CPPUNIT_ASSERT_EQUAL (1, n_reads.load ());
+
+	/* another request for clip 1 waits for the first one */
+	Glib::Threads::Thread* t2 = Glib::Threads::Thread::create (sigc::bind (sigc::ptr_fun (&AudioClipCacheTest::get_in_thread), &cache, 1, &read_ramp, &second));
+
+	Glib::usleep (50000);
+
+	{
+		Glib::Threads::Mutex::Lock lm (gate_lock);
+		gate_open = true;
+		gate_cond.broadcast ();
+	}
+
+	t1->join ();
+	t2->join ();
+
+	CPPUNIT_ASSERT (!gate_timeout);
+	CPPUNIT_ASSERT (first);
+	CPPUNIT_ASSERT (first == second);
+	CPPUNIT_ASSERT_EQUAL (2, n_reads.load ());
+	CPPUNIT_ASSERT_EQUAL (2 * clip_bytes, cache.size ());
+}
@@ -0,0 +1,24 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "ardour/audio_clip_cache.h"
+
+class AudioClipCacheTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (AudioClipCacheTest);
+	CPPUNIT_TEST (refcountTest);
+	CPPUNIT_TEST (evictTest);
+	CPPUNIT_TEST (concurrentTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void refcountTest ();
+	void evictTest ();
+	void concurrentTest ();
+
+private:
+	typedef bool (*Reader) (ARDOUR::AudioClipCache::Clip&);
+
+	static ARDOUR::AudioClipCache::ClipPtr get (ARDOUR::AudioClipCache&, uint64_t source, size_t limit, Reader);
+	static void get_in_thread (ARDOUR::AudioClipCache*, uint64_t source, Reader, ARDOUR::AudioClipCache::ClipPtr*);
+};
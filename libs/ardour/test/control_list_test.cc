@@ -0,0 +1,53 @@
+#include <cmath>
+#include <stdio.h>
+
+#include "evoral/ControlList.h"
+#include "evoral/Curve.h"
+
+#include "control_list_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (ControlListTest);
+
+using namespace Evoral;
+using namespace Temporal;
+
+static timepos_t
+at (double x)
+{
+	return timepos_t::from_superclock (llrint (x));
+}
+
+void
+ControlListTest::manyPointLinear ()
+{
+	float vec[1024];
+
+	ControlList cl (Parameter (0), ParameterDescriptor (), AudioTime);
+
+	cl.create_curve ();
+
+	/* add points with varying distance, some segments are shorter than one step */
+	double x = 0;
+	for (int i = 0; i < 64; ++i) {
+		cl.fast_simple_add (at (x), (i % 7) * .5);
+		x += (i % 3) ? 3.0 : 37.0;
+	}
+
+	/* vector evaluation must match point-wise evaluation */
+	cl.curve ().get_vector (at (10), at (1033), vec, 1024);
+	for (int i = 0; i < 1024; ++i) {
+		char msg[64];
+		snprintf (msg, 64, "at i=%d", i);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE (msg, cl.unlocked_eval (at (10 + i)), vec[i], 1e-6);
+	}
+
+	/* sparse evaluation, skipping over many points. The max slope is 1,
+	 * and positions may differ by less than one from the rounded ones.
+	 */
+	cl.curve ().get_vector (at (0), at (x), vec, 100);
+	for (int i = 0; i < 100; ++i) {
+		char msg[64];
+		snprintf (msg, 64, "step at i=%d", i);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE (msg, cl.unlocked_eval (at (floor (i * x / 99.0))), vec[i], 1.0);
+	}
+}
@@ -0,0 +1,12 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class ControlListTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (ControlListTest);
+	CPPUNIT_TEST (manyPointLinear);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void manyPointLinear ();
+};
@@ -1,4 +1,5 @@
 #include <cassert>
+#include <vector>
 #include "pbd/compose.h"
 #include "pbd/fpu.h"
 #include "pbd/malign.h"
@@ -20,11 +21,22 @@ FPUTest::setUp ()
 	cache_aligned_malloc ((void**) &_comp1, sizeof (float) * _size);
 	cache_aligned_malloc ((void**) &_comp2, sizeof (float) * _size);
 
+	reset ();
+
+	/* functions without optimized implementation */
+	apply_gain_ramp = default_apply_gain_ramp;
+	interleave      = default_interleave;
+	deinterleave    = default_deinterleave;
+	float_to_s32    = default_float_to_s32;
+}
+
+void
+FPUTest::reset ()
+{
 	for (size_t i = 0; i < _size; ++i) {
 		_test1[i] = _comp1[i] = 3.0 / (i + 1.0);
 		_test2[i] = _comp2[i] = 2.5 / (i + 1.0);
 	}
-
 }
 
 void
@@ -83,6 +95,39 @@ FPUTest::run (size_t align_max, float const max_diff)
 			CPPUNIT_ASSERT_MESSAGE (string_compose ("Find peaks not aligned off: %1 cnt: %2", off, cnt), fabsf (pk_test - pk_comp) < 2e-6 && fabsf (pk_test_max - pk_comp_max) < 2e-6);
 		}
 	}
+
+	reset ();
+
+	std::vector<int32_t> i_test (align_max * 2);
+	std::vector<int32_t> i_comp (align_max * 2);
+
+	for (size_t off = 0; off < align_max; ++off) {
+		for (size_t cnt = 1; cnt < align_max; ++cnt) {
+			/* gain ramp */
+			apply_gain_ramp (&_test1[off], cnt, 0.25, 1.0);
+			default_apply_gain_ramp (&_comp1[off], cnt, 0.25, 1.0);
+			compare (string_compose ("Gain Ramp not aligned off: %1 cnt: %2", off, cnt), off + cnt, max_diff);
+
+			/* float to int, the first samples of _test2 exceed [-1, +1] */
+			float_to_s32 (&i_test[off], &_test2[off], cnt);
+			default_float_to_s32 (&i_comp[off], &_comp2[off], cnt);
+			CPPUNIT_ASSERT_MESSAGE (string_compose ("Float to s32 not aligned off: %1 cnt: %2", off, cnt), i_test == i_comp);
+
+			for (uint32_t n_chn = 1; n_chn < 5; ++n_chn) {
+				for (uint32_t chn = 0; chn < n_chn; ++chn) {
+					/* interleave */
+					interleave (&_test1[off], &_test2[off], cnt, chn, n_chn);
+					default_interleave (&_comp1[off], &_comp2[off], cnt, chn, n_chn);
+					compare (string_compose ("Interleave not aligned off: %1 cnt: %2 chn: %3/%4", off, cnt, chn, n_chn), off + cnt * n_chn);
+
+					/* deinterleave */
+					deinterleave (&_test1[off], &_test2[off], cnt, chn, n_chn);
+					default_deinterleave (&_comp1[off], &_comp2[off], cnt, chn, n_chn);
+					compare (string_compose ("Deinterleave not aligned off: %1 cnt: %2 chn: %3/%4", off, cnt, chn, n_chn), off + cnt);
+				}
+			}
+		}
+	}
 }
 
 void
@@ -99,6 +144,40 @@ FPUTest::compare (std::string msg, size_t cnt, float max_diff)
 
 #if defined(ARCH_X86) && defined(BUILD_SSE_OPTIMIZATIONS)
 
+#ifdef FPU_AVX512F_SUPPORT
+void
+FPUTest::avx512fTest ()
+{
+	PBD::FPU* fpu = PBD::FPU::instance ();
+	if (!fpu->has_avx512f ()) {
+		printf ("AVX-512 is not available at run-time\n");
+		return;
+	}
+
+#if ( defined(__x86_64__) || defined(_M_X64) )
+	size_t align_max = 64;
+#else
+	size_t align_max = 16;
+#endif
+	CPPUNIT_ASSERT_MESSAGE ("Aligned Malloc", (((intptr_t)_test1) % align_max) == 0);
+	CPPUNIT_ASSERT_MESSAGE ("Aligned Malloc", (((intptr_t)_test2) % align_max) == 0);
+
+	compute_peak          = x86_avx512f_compute_peak;
+	find_peaks            = x86_avx512f_find_peaks;
+	apply_gain_to_buffer  = x86_avx512f_apply_gain_to_buffer;
+	mix_buffers_with_gain = x86_avx512f_mix_buffers_with_gain;
+	mix_buffers_no_gain   = x86_avx512f_mix_buffers_no_gain;
+	copy_vector           = x86_avx512f_copy_vector;
+	apply_gain_ramp       = x86_avx512f_apply_gain_ramp;
+	interleave            = x86_avx512f_interleave;
+	deinterleave          = x86_avx512f_deinterleave;
+	float_to_s32          = x86_avx512f_float_to_s32;
+
+	/* gain-ramp and mix w/gain use fused multiply-add */
+	run (align_max, 4 * FLT_EPSILON);
+}
+#endif
+
 void
 FPUTest::avxFmaTest ()
 {
@@ -122,6 +201,10 @@ FPUTest::avxFmaTest ()
 	mix_buffers_with_gain = x86_fma_mix_buffers_with_gain;
 	mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 	copy_vector           = x86_sse_avx_copy_vector;
+	apply_gain_ramp       = x86_avx_apply_gain_ramp;
+	interleave            = x86_avx_interleave;
+	deinterleave          = x86_avx_deinterleave;
+	float_to_s32          = x86_avx_float_to_s32;
 
 	run (align_max, FLT_EPSILON);
 }
@@ -149,6 +232,10 @@ FPUTest::avxTest ()
 	mix_buffers_with_gain = x86_sse_avx_mix_buffers_with_gain;
 	mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 	copy_vector           = x86_sse_avx_copy_vector;
+	apply_gain_ramp       = x86_avx_apply_gain_ramp;
+	interleave            = x86_avx_interleave;
+	deinterleave          = x86_avx_deinterleave;
+	float_to_s32          = x86_avx_float_to_s32;
 
 	run (align_max);
 }
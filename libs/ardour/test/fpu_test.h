@@ -10,6 +10,9 @@ class FPUTest : public CppUnit::TestFixture
 	CPPUNIT_TEST (sseTest);
 	CPPUNIT_TEST (avxTest);
 	CPPUNIT_TEST (avxFmaTest);
+#ifdef FPU_AVX512F_SUPPORT
+	CPPUNIT_TEST (avx512fTest);
+#endif
 #elif defined ARM_NEON_SUPPORT
 	CPPUNIT_TEST (neonTest);
 #elif defined(__APPLE__) && defined(BUILD_VECLIB_OPTIMIZATIONS)
@@ -25,6 +28,9 @@ public:
 
 #if defined(ARCH_X86) && defined(BUILD_SSE_OPTIMIZATIONS)
 	void avxFmaTest ();
+#ifdef FPU_AVX512F_SUPPORT
+	void avx512fTest ();
+#endif
 	void avxTest ();
 	void sseTest ();
 #elif defined ARM_NEON_SUPPORT
@@ -38,6 +44,7 @@ public:
 private:
 	void run (size_t, float const max_diff = 0);
 	void compare (std::string, size_t, float const max_diff = 0);
+	void reset ();
 
 	ARDOUR::compute_peak_t          compute_peak;
 	ARDOUR::find_peaks_t            find_peaks;
@@ -45,6 +52,10 @@ private:
 	ARDOUR::mix_buffers_with_gain_t mix_buffers_with_gain;
 	ARDOUR::mix_buffers_no_gain_t   mix_buffers_no_gain;
 	ARDOUR::copy_vector_t           copy_vector;
+	ARDOUR::apply_gain_ramp_t       apply_gain_ramp;
+	ARDOUR::interleave_t            interleave;
+	ARDOUR::deinterleave_t          deinterleave;
+	ARDOUR::float_to_s32_t          float_to_s32;
 
 	size_t _size;
 
@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "pbd/compose.h"
+
+#include "ardour/midi_model.h"
+#include "ardour/midi_playlist.h"
+#include "ardour/midi_region.h"
+#include "ardour/midi_source.h"
+#include "ardour/playlist_factory.h"
+#include "ardour/region_factory.h"
+#include "ardour/rt_midibuffer.h"
+#include "ardour/session.h"
+
+#include "midi_playlist_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MidiPlaylistTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+typedef Temporal::Beats                        Beats;
+typedef MidiModel::NoteDiffCommand             NoteDiffCommand;
+typedef vector<pair<samplepos_t, vector<uint8_t> > > Events;
+
+/* An edit of a region's notes only renders the notes within the edited
+ * range. Compare the result with a full render of a copy of the playlist.
+ */
+
+static MidiModel::NotePtr
+new_note (Beats const & time, Beats const & length, uint8_t pitch)
+{
+	return MidiModel::NotePtr (new Evoral::Note<Beats> (0, time, length, pitch, 100));
+}
+
+/** @return the events of @p buf, sorted by time and then by their
+ *  bytes, since both renders may write simultaneous events in a
+ *  different order.
+ */
+static Events
+events_of (RTMidiBuffer& buf)
+{
+	Events ev;
+
+	for (size_t n = 0; n < buf.size (); ++n) {
+		uint32_t size;
+		uint8_t const* data = buf.bytes (buf[n], size);
+		if (n > 0) {
+			CPPUNIT_ASSERT (buf[n - 1].timestamp <= buf[n].timestamp);
+		}
+		ev.push_back (make_pair (buf[n].timestamp, vector<uint8_t> (data, data + size)));
+	}
+
+	std::sort (ev.begin (), ev.end ());
+	return ev;
+}
+
+void
+MidiPlaylistTest::setUp ()
+{
+	TestNeedingSession::setUp ();
+
+	_playlist = boost::dynamic_pointer_cast<MidiPlaylist> (PlaylistFactory::create (DataType::MIDI, *_session, "test"));
+	_source = _session->create_midi_source_for_session ("test");
+
+	{
+		Source::Lock lm (_source->mutex ());
+		_source->load_model (lm);
+	}
+
+	_model = _source->model ();
+	CPPUNIT_ASSERT (_model);
+
+	/* notes at and across the start and end of the regions that the
+	 * tests add, in beats within the source.
+	 */
+	NoteDiffCommand* cmd = _model->new_note_diff_command ("initial notes");
+	cmd->add (new_note (Beats (0, 0), Beats (1, 0), 60));
+	cmd->add (new_note (Beats (1, 0), Beats (2, 0), 62));
+	cmd->add (new_note (Beats (2, 0), Beats (0, 960), 64));
+	cmd->add (new_note (Beats (5, 0), Beats (2, 0), 65));
+	cmd->add (new_note (Beats (8, 0), Beats (1, 0), 67));
+	cmd->add (new_note (Beats (14, 0), Beats (4, 0), 69));
+	cmd->add (new_note (Beats (16, 0), Beats (1, 0), 71));
+	cmd->add (new_note (Beats (20, 0), Beats (1, 0), 72));
+	_model->apply_command (*_session, cmd);
+}
+
+void
+MidiPlaylistTest::tearDown ()
+{
+	_playlist.reset ();
+	_model.reset ();
+	_source.reset ();
+
+	TestNeedingSession::tearDown ();
+}
+
+void
+MidiPlaylistTest::add_region (int start, int length, int position)
+{
+	PropertyList plist;
+	plist.add (Properties::start, timepos_t (Beats (start, 0)));
+	plist.add (Properties::length, timecnt_t (Beats (length, 0)));
+
+	boost::shared_ptr<Region> r = RegionFactory::create (_source, plist);
+	r->set_name (string_compose ("mr%1", _playlist->n_regions ()));
+	_playlist->add_region (r, timepos_t (Beats (position, 0)));
+}
+
+void
+MidiPlaylistTest::check_render (string const & what)
+{
+	_playlist->render (0);
+	Events const incremental (events_of (*_playlist->rendered ()));
+
+	boost::shared_ptr<MidiPlaylist> full = boost::dynamic_pointer_cast<MidiPlaylist> (PlaylistFactory::create (_playlist, "full", true));
+	full->render (0);
+	Events const expected (events_of (*full->rendered ()));
+
+	CPPUNIT_ASSERT_MESSAGE (what, !expected.empty ());
+	CPPUNIT_ASSERT_EQUAL_MESSAGE (what, expected.size (), incremental.size ());
+	CPPUNIT_ASSERT_MESSAGE (what, expected == incremental);
+}
+
+void
+MidiPlaylistTest::edit_notes ()
+{
+	check_render ("initial render");
+
+	MidiModel::NotePtr const inside = new_note (Beats (3, 0), Beats (1, 0), 70);
+	NoteDiffCommand* cmd = _model->new_note_diff_command ("add");
+	cmd->add (inside);
+	_model->apply_command (*_session, cmd);
+	check_render ("add a note");
+
+	cmd = _model->new_note_diff_command ("add at region starts");
+	cmd->add (new_note (Beats (0, 0), Beats (0, 480), 61));
+	cmd->add (new_note (Beats (2, 0), Beats (1, 0), 66));
+	cmd->add (new_note (Beats (8, 0), Beats (0, 960), 68));
+	_model->apply_command (*_session, cmd);
+	check_render ("add notes at the start of regions");
+
+	cmd = _model->new_note_diff_command ("add at region ends");
+	cmd->add (new_note (Beats (5, 0), Beats (1, 0), 73));
+	cmd->add (new_note (Beats (15, 0), Beats (1, 0), 74));
+	cmd->add (new_note (Beats (16, 0), Beats (2, 0), 75));
+	_model->apply_command (*_session, cmd);
+	check_render ("add notes at and across the end of regions");
+
+	MidiModel::NotePtr removed;
+	{
+		MidiModel::ReadLock lm (_model->read_lock ());
+		removed = *_model->note_lower_bound (Beats (1, 0));
+	}
+	CPPUNIT_ASSERT_EQUAL ((uint8_t) 62, removed->note ());
+	cmd = _model->new_note_diff_command ("remove");
+	cmd->remove (removed);
+	_model->apply_command (*_session, cmd);
+	check_render ("remove a note");
+
+	cmd = _model->new_note_diff_command ("move");
+	cmd->change (inside, NoteDiffCommand::StartTime, Beats (12, 0));
+	_model->apply_command (*_session, cmd);
+	check_render ("move a note across a region start");
+
+	cmd = _model->new_note_diff_command ("move");
+	cmd->change (inside, NoteDiffCommand::StartTime, Beats (0, 0));
+	_model->apply_command (*_session, cmd);
+	check_render ("move a note back to a region start");
+
+	cmd = _model->new_note_diff_command ("move and resize");
+	cmd->change (inside, NoteDiffCommand::StartTime, Beats (6, 0));
+	cmd->change (inside, NoteDiffCommand::Length, Beats (0, 480));
+	_model->apply_command (*_session, cmd);
+	check_render ("move and shorten a note");
+
+	cmd = _model->new_note_diff_command ("length");
+	cmd->change (inside, NoteDiffCommand::Length, Beats (17, 0));
+	_model->apply_command (*_session, cmd);
+	check_render ("extend a note across region ends");
+
+	_session->undo (1);
+	check_render ("undo");
+
+	cmd = _model->new_note_diff_command ("add at the ends of the range");
+	cmd->add (new_note (Beats (0, 0), Beats (1, 0), 50));
+	cmd->add (new_note (Beats (20, 0), Beats (1, 0), 51));
+	_model->apply_command (*_session, cmd);
+	check_render ("add notes at both ends of the range");
+
+	cmd = _model->new_note_diff_command ("remove and add");
+	cmd->remove (inside);
+	cmd->add (new_note (Beats (10, 0), Beats (6, 0), 52));
+	_model->apply_command (*_session, cmd);
+	check_render ("remove and add notes");
+
+	_session->undo (2);
+	check_render ("undo two edits");
+}
+
+void
+MidiPlaylistTest::singleRegionTest ()
+{
+	add_region (0, 16, 4);
+	edit_notes ();
+}
+
+void
+MidiPlaylistTest::multipleRegionsTest ()
+{
+	/* one region contains another, the third is trimmed at both ends */
+	add_region (0, 16, 4);
+	add_region (8, 8, 10);
+	add_region (2, 4, 24);
+	edit_notes ();
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <string>
+
+#include <boost/shared_ptr.hpp>
+
+#include "test_needing_session.h"
+
+namespace ARDOUR {
+	class MidiModel;
+	class MidiPlaylist;
+	class MidiRegion;
+	class MidiSource;
+}
+
+class MidiPlaylistTest : public TestNeedingSession
+{
+	CPPUNIT_TEST_SUITE (MidiPlaylistTest);
+	CPPUNIT_TEST (singleRegionTest);
+	CPPUNIT_TEST (multipleRegionsTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void setUp ();
+	void tearDown ();
+
+	void singleRegionTest ();
+	void multipleRegionsTest ();
+
+private:
+	/** @param start Start within the source, in beats.
+	 *  @param length Length in beats.
+	 *  @param position Position in the playlist, in beats.
+	 */
+	void add_region (int start, int length, int position);
+	void edit_notes ();
+	void check_render (std::string const & what);
+
+	boost::shared_ptr<ARDOUR::MidiPlaylist> _playlist;
+	boost::shared_ptr<ARDOUR::MidiSource> _source;
+	boost::shared_ptr<ARDOUR::MidiModel> _model;
+};
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "pbd/compose.h"
+
+#include "ardour/playlist.h"
+#include "ardour/region.h"
+#include "ardour/region_factory.h"
+#include "playlist_region_index_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (PlaylistRegionIndexTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+/* The playlist uses an index once it has more than a few regions,
+ * compare its lookups to a linear search of all regions.
+ */
+
+void
+PlaylistRegionIndexTest::setUp ()
+{
+	AudioRegionTest::setUp ();
+
+	/* 64 regions, partially overlapping, with some long ones */
+	for (int i = 0; i < 64; ++i) {
+		boost::shared_ptr<Region> r = RegionFactory::create (_r[i % 16], true);
+		r->set_length (timecnt_t ((i % 5) == 0 ? 1000 : 20 + (i % 7) * 10));
+		_playlist->add_region (r, timepos_t ((i * 37) % 1500));
+	}
+}
+
+void
+PlaylistRegionIndexTest::check_lookups ()
+{
+	boost::shared_ptr<RegionList> all = _playlist->region_list ();
+
+	for (samplepos_t p = 0; p < 2600; p += 13) {
+		timepos_t const pos (p);
+		timepos_t const end (p + 50);
+
+		RegionList at;
+		RegionList touched;
+		RegionList starting;
+		for (auto const & r : *all) {
+			if (r->covers (pos)) {
+				at.push_back (r);
+			}
+			if (r->coverage (pos, end) != Temporal::OverlapNone) {
+				touched.push_back (r);
+			}
+			if (r->position () >= pos && r->position () < end) {
+				starting.push_back (r);
+			}
+		}
+
+		string const msg = string_compose ("at %1", p);
+		CPPUNIT_ASSERT_MESSAGE (msg, at == *_playlist->regions_at (pos));
+		CPPUNIT_ASSERT_MESSAGE (msg, touched == *_playlist->regions_touched (pos, end));
+		CPPUNIT_ASSERT_MESSAGE (msg, starting == *_playlist->regions_with_start_within (Temporal::Range (pos, end)));
+		CPPUNIT_ASSERT_EQUAL_MESSAGE (msg, (uint32_t) at.size (), _playlist->count_regions_at (pos));
+
+		boost::shared_ptr<Region> next;
+		boost::shared_ptr<Region> prev;
+		for (auto const & r : *all) {
+			if (!next && r->position () > pos) {
+				next = r;
+			}
+			if (r->position () < pos && (!prev || r->position () > prev->position ())) {
+				prev = r;
+			}
+		}
+		CPPUNIT_ASSERT_MESSAGE (msg, next == _playlist->find_next_region (pos, Start, 1));
+		CPPUNIT_ASSERT_MESSAGE (msg, prev == _playlist->find_next_region (pos, Start, -1));
+	}
+}
+
+void
+PlaylistRegionIndexTest::lookupTest ()
+{
+	check_lookups ();
+}
+
+/* The index has to follow changes of the regions */
+void
+PlaylistRegionIndexTest::changeTest ()
+{
+	check_lookups ();
+
+	boost::shared_ptr<RegionList> all = _playlist->region_list ();
+	boost::shared_ptr<Region> r = all->front ();
+
+	r->set_position (timepos_t (2000));
+	check_lookups ();
+
+	r->set_length (timecnt_t (500));
+	check_lookups ();
+
+	_playlist->remove_region (r);
+	check_lookups ();
+
+	_playlist->split (timepos_t (700));
+	check_lookups ();
+
+	_playlist->freeze ();
+	_playlist->add_region (RegionFactory::create (_r[0], true), timepos_t (5));
+	check_lookups ();
+	_playlist->thaw ();
+	check_lookups ();
+}
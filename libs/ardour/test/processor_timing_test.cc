@@ -0,0 +1,100 @@
+#include "ardour/processor_timing.h"
+
+#include "processor_timing_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (ProcessorTimingTest);
+
+using namespace ARDOUR;
+
+void
+ProcessorTimingTest::statsTest ()
+{
+	ProcessorTiming t;
+	double min, avg, p99, max;
+
+	/* no buffer */
+	t.add (10);
+	t.commit ();
+	CPPUNIT_ASSERT (!t.get_stats (min, avg, p99, max));
+
+	t.allocate ();
+
+	/* a single cycle is not enough */
+	t.add (10);
+	t.commit ();
+	CPPUNIT_ASSERT (!t.get_stats (min, avg, p99, max));
+
+	/* cycles without any time are not stored */
+	t.commit ();
+
+	for (uint32_t i = 2; i <= 100; ++i) {
+		t.add (i);
+		t.commit ();
+	}
+
+	/* 10, 2 .. 100 */
+	const double tpu = ProcessorTiming::ticks_per_usec ();
+	CPPUNIT_ASSERT (t.get_stats (min, avg, p99, max));
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (2 / tpu, min, 1e-9);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (100 / tpu, max, 1e-9);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL ((5049 + 10) / 100. / tpu, avg, 1e-9);
+	/* element 98 of 100 sorted values */
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (99 / tpu, p99, 1e-9);
+}
+
+void
+ProcessorTimingTest::wrapTest ()
+{
+	ProcessorTiming t;
+	double min, avg, p99, max;
+
+	t.allocate ();
+
+	/* the first 1000 cycles are overwritten */
+	for (uint32_t i = 0; i < 1000; ++i) {
+		t.add (1000);
+		t.commit ();
+	}
+	for (uint32_t i = 1; i <= ProcessorTiming::window_size; ++i) {
+		t.add (i);
+		t.commit ();
+	}
+
+	const double tpu = ProcessorTiming::ticks_per_usec ();
+	CPPUNIT_ASSERT (t.get_stats (min, avg, p99, max));
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (1 / tpu, min, 1e-9);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (ProcessorTiming::window_size / tpu, max, 1e-9);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL ((ProcessorTiming::window_size + 1) / 2. / tpu, avg, 1e-9);
+}
+
+void
+ProcessorTimingTest::resetTest ()
+{
+	ProcessorTiming t;
+	double min, avg, p99, max;
+
+	t.allocate ();
+
+	for (uint32_t i = 1; i <= 10; ++i) {
+		t.add (i);
+		t.commit ();
+	}
+	CPPUNIT_ASSERT (t.get_stats (min, avg, p99, max));
+
+	/* the reset is performed by the next commit */
+	t.reset ();
+	t.add (5);
+	t.commit ();
+	CPPUNIT_ASSERT (!t.get_stats (min, avg, p99, max));
+
+	t.add (20);
+	t.commit ();
+	t.add (40);
+	t.commit ();
+
+	const double tpu = ProcessorTiming::ticks_per_usec ();
+	CPPUNIT_ASSERT (t.get_stats (min, avg, p99, max));
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (20 / tpu, min, 1e-9);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (40 / tpu, max, 1e-9);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (30 / tpu, avg, 1e-9);
+}
@@ -0,0 +1,16 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class ProcessorTimingTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (ProcessorTimingTest);
+	CPPUNIT_TEST (statsTest);
+	CPPUNIT_TEST (wrapTest);
+	CPPUNIT_TEST (resetTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void statsTest ();
+	void wrapTest ();
+	void resetTest ();
+};
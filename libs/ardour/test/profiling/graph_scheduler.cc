@@ -0,0 +1,114 @@
+#include <iostream>
+#include <cstdlib>
+
+#include <glibmm/miscutils.h>
+
+#include "pbd/compose.h"
+#include "pbd/timing.h"
+
+#include "ardour/ardour.h"
+#include "ardour/audioengine.h"
+#include "ardour/audio_port.h"
+#include "ardour/audio_track.h"
+#include "ardour/io.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/route.h"
+#include "ardour/session.h"
+#include "ardour/utils.h"
+
+#include "test_ui.h"
+#include "test_util.h"
+
+using namespace std;
+using namespace PBD;
+using namespace ARDOUR;
+
+static const char* localedir = LOCALEDIR;
+
+/* Compare the per-cycle overhead of the two process-graph schedulers.
+ *
+ * A synthetic session with <tracks> mono tracks (no plugins) feeding
+ * <busses> busses is created, so that the time spent in Session::process
+ * is dominated by graph scheduling rather than by DSP.
+ */
+
+static void
+run_cycles (Session* session, int n_cycles, bool work_stealing)
+{
+	Config->set_graph_work_stealing (work_stealing);
+
+	pframes_t nframes = session->engine ().samples_per_cycle ();
+	TimingStats stats;
+
+	{
+		Glib::Threads::Mutex::Lock lm (AudioEngine::instance ()->process_lock ());
+
+		/* warm up */
+		for (int i = 0; i < 256; ++i) {
+			session->process (nframes);
+		}
+
+		for (int i = 0; i < n_cycles; ++i) {
+			stats.start ();
+			session->process (nframes);
+			stats.update ();
+		}
+	}
+
+	microseconds_t min, max;
+	double avg, dev;
+	if (stats.get_stats (min, max, avg, dev)) {
+		size_t n_routes = session->get_routes ()->size ();
+		cout << string_compose ("%1: %2 cycles of %3 samples, %4 routes, %5 threads\n",
+		                        work_stealing ? "work-stealing" : "shared-queue ",
+		                        n_cycles, nframes, n_routes, how_many_dsp_threads ());
+		cout << string_compose ("  per cycle [us]: min: %1 max: %2 avg: %3 dev: %4 | per route avg: %5\n",
+		                        min, max, avg, dev, avg / n_routes);
+	}
+}
+
+int
+main (int argc, char* argv[])
+{
+	int n_tracks = argc > 1 ? atoi (argv[1]) : 200;
+	int n_busses = argc > 2 ? atoi (argv[2]) : 8;
+	int n_cycles = argc > 3 ? atoi (argv[3]) : 16384;
+
+	if (n_tracks < 1 || n_busses < 1 || n_cycles < 2) {
+		cerr << argv[0] << ": [tracks] [busses] [cycles]\n";
+		exit (EXIT_FAILURE);
+	}
+
+	ARDOUR::init (true, localedir);
+	TestUI* test_ui = new TestUI ();
+
+	/* use all available CPU cores */
+	Config->set_processor_usage (0);
+
+	create_and_start_dummy_backend ();
+
+	std::string dir = Glib::build_filename (new_test_output_dir ("graph"), "graph_scheduler");
+	Session* session = new Session (*AudioEngine::instance (), dir, "graph_scheduler");
+	AudioEngine::instance ()->set_session (session);
+
+	RouteList busses = session->new_audio_route (1, 1, 0, n_busses, "Bus", PresentationInfo::AudioBus, PresentationInfo::max_order);
+	list<boost::shared_ptr<AudioTrack> > tracks = session->new_audio_track (1, 1, 0, n_tracks, "Track", PresentationInfo::max_order, Normal, false);
+
+	/* round-robin track outputs to the busses */
+	int n = 0;
+	for (list<boost::shared_ptr<AudioTrack> >::iterator t = tracks.begin (); t != tracks.end (); ++t, ++n) {
+		RouteList::iterator b = busses.begin ();
+		std::advance (b, n % n_busses);
+		(*t)->output ()->disconnect (0);
+		(*t)->output ()->connect ((*t)->output ()->audio (0), (*b)->input ()->audio (0)->name (), 0);
+	}
+
+	run_cycles (session, n_cycles, false);
+	run_cycles (session, n_cycles, true);
+
+	delete session;
+	stop_and_destroy_backend ();
+	delete test_ui;
+	ARDOUR::cleanup ();
+	return 0;
+}
@@ -0,0 +1,243 @@
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <fcntl.h>
+#include <getopt.h>
+#include <limits.h>
+#include <unistd.h>
+
+#include <boost/bind.hpp>
+
+#include "pbd/g_atomic_compat.h"
+#include "pbd/microseconds.h"
+
+#include "ardour/ardour.h"
+#include "ardour/io_tasklist.h"
+
+using namespace std;
+using namespace PBD;
+using namespace ARDOUR;
+
+static const char* localedir = LOCALEDIR;
+
+/* Compare serial disk I/O (one file after another, as the butler used
+ * to do) with parallel I/O using ARDOUR::IOTaskList, the same way the
+ * Butler uses it: one task per file, processed by the calling thread
+ * and (n_threads - 1) I/O threads.
+ *
+ * Every round reads (or with -w writes) one block of every file, and
+ * corresponds to one butler pass over all tracks. The time per round
+ * is what matters for refilling buffers after a locate, and for
+ * keeping up with capture of many tracks.
+ *
+ * See tools/run-iotask-test.sh
+ */
+
+struct File {
+	int   fd;
+	off_t pos;
+	off_t size;
+	char* buf; /* tasks may run concurrently, each has its own buffer */
+};
+
+static size_t            block_size = 64 * 1024 * 4;
+static bool              do_write   = false;
+static bool              do_sync    = false;
+static GATOMIC_QUAL gint io_errors;
+
+static void
+do_io (File* f)
+{
+	ssize_t rv;
+	if (do_write) {
+		rv = pwrite (f->fd, f->buf, block_size, f->pos);
+		if (do_sync) {
+			fdatasync (f->fd);
+		}
+	} else {
+		if (f->pos + (off_t) block_size > f->size) {
+			f->pos = 0;
+		}
+		rv = pread (f->fd, f->buf, block_size, f->pos);
+	}
+	if (rv != (ssize_t) block_size) {
+		g_atomic_int_inc (&io_errors);
+	}
+	f->pos += block_size;
+}
+
+static void
+usage (char const* name)
+{
+	fprintf (stderr, "%s [ -b BLOCKSIZE ] [ -l FILELIMIT ] [ -n NTHREADS ] [ -r ROUNDS ] [ -w ] [ -s ] [ -q ] filename-template\n", name);
+}
+
+int
+main (int argc, char* argv[])
+{
+	char optstring[] = "b:l:n:r:wsq";
+	int  max_files   = -1;
+	int  nthreads    = 1;
+	int  rounds      = 100;
+	bool quiet       = false;
+
+	const struct option longopts[] = {
+		{ "blocksize", 1, 0, 'b' },
+		{ "limit", 1, 0, 'l' },
+		{ "nthreads", 1, 0, 'n' },
+		{ "rounds", 1, 0, 'r' },
+		{ "write", 0, 0, 'w' },
+		{ "sync", 0, 0, 's' },
+		{ "quiet", 0, 0, 'q' },
+		{ 0, 0, 0, 0 }
+	};
+
+	int option_index = 0;
+	int c            = 0;
+
+	while (1) {
+		if ((c = getopt_long (argc, argv, optstring, longopts, &option_index)) == -1) {
+			break;
+		}
+
+		switch (c) {
+		case 'b':
+			block_size = atoi (optarg);
+			break;
+		case 'l':
+			max_files = atoi (optarg);
+			break;
+		case 'n':
+			nthreads = std::max (1, atoi (optarg));
+			break;
+		case 'r':
+			rounds = std::max (1, atoi (optarg));
+			break;
+		case 'w':
+			do_write = true;
+			break;
+		case 's':
+			do_sync = true;
+			break;
+		case 'q':
+			quiet = true;
+			break;
+		default:
+			usage (argv[0]);
+			return 0;
+		}
+	}
+
+	if (optind >= argc) {
+		usage (argv[0]);
+		return 1;
+	}
+
+	char const* name_template = argv[optind];
+
+	std::vector<File> files;
+
+	for (int n = 1; max_files < 0 || n <= max_files; ++n) {
+		char path[PATH_MAX + 1];
+		snprintf (path, sizeof (path), name_template, n);
+
+		if (!do_write && access (path, R_OK) != 0) {
+			break;
+		}
+		if (do_write && max_files < 0 && n > 128) {
+			break;
+		}
+
+		File f;
+		f.fd = open (path, do_write ? (O_WRONLY | O_CREAT | O_TRUNC) : O_RDONLY, 0644);
+		if (f.fd < 0) {
+			fprintf (stderr, "Could not open file #%d @ %s (%s)\n", n, path, strerror (errno));
+			return 1;
+		}
+		f.pos  = 0;
+		f.size = lseek (f.fd, 0, SEEK_END);
+		if (!do_write && f.size < (off_t) block_size) {
+			fprintf (stderr, "file is shorter than blocksize #%d @ %s\n", n, path);
+			return 1;
+		}
+		f.buf = (char*) calloc (1, block_size);
+		files.push_back (f);
+	}
+
+	if (files.empty ()) {
+		fprintf (stderr, "No matching files found for %s\n", name_template);
+		return 1;
+	}
+
+	if (!quiet) {
+		printf ("# %s %d files using %d thread(s), blocksize %lu\n",
+		        do_write ? "Writing" : "Reading", (int) files.size (), nthreads, (unsigned long) block_size);
+	}
+
+	ARDOUR::init (true, localedir);
+
+	std::vector<double> elapsed;
+
+	{
+		IOTaskList io_tasklist (nthreads);
+
+		IOTaskList::TaskList tl;
+		for (std::vector<File>::iterator f = files.begin (); f != files.end (); ++f) {
+			tl.push_back (boost::bind (&do_io, &(*f)));
+		}
+
+		elapsed.reserve (rounds);
+
+		for (int r = 0; r < rounds; ++r) {
+			microseconds_t before = get_microseconds ();
+
+			g_atomic_int_set (&io_errors, 0);
+			io_tasklist.process (tl);
+
+			double dt = (get_microseconds () - before) / 1e6;
+			elapsed.push_back (dt);
+
+			if (g_atomic_int_get (&io_errors)) {
+				fprintf (stderr, "I/O error in round %d\n", r);
+				break;
+			}
+
+			if (!quiet) {
+				printf ("# round %d: %.4f sec, bandwidth %.3f MB/sec\n", r, dt, files.size () * block_size / 1048576.0 / dt);
+			}
+		}
+	}
+
+	for (size_t n = 0; n < files.size (); ++n) {
+		close (files[n].fd);
+		free (files[n].buf);
+	}
+
+	ARDOUR::cleanup ();
+
+	if (elapsed.empty ()) {
+		return 1;
+	}
+
+	double total = 0;
+	for (size_t i = 0; i < elapsed.size (); ++i) {
+		total += elapsed[i];
+	}
+	std::sort (elapsed.begin (), elapsed.end ());
+
+	const double avg = total / elapsed.size ();
+	const double p99 = elapsed[(elapsed.size () - 1) * 99 / 100];
+	const double max = elapsed.back ();
+	const double bw  = elapsed.size () * files.size () * block_size / 1048576.0 / total;
+
+	printf ("# Round time [sec] Avg: %.4f P99: %.4f Max: %.4f || Avg: %.3f MB/sec\n", avg, p99, max, bw);
+	printf ("# Sus Track count: %d @ 48000SPS\n", (int) floor (files.size () * block_size / (4 * 48000. * max)));
+	printf ("%d %lu %.5f %.5f %.5f %.4f\n", nthreads, (unsigned long) block_size, avg, p99, max, bw);
+
+	return 0;
+}
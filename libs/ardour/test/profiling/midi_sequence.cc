@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "pbd/microseconds.h"
+
+#include "temporal/beats.h"
+#include "temporal/types.h"
+
+#include "evoral/Control.h"
+#include "evoral/ControlList.h"
+#include "evoral/Event.h"
+#include "evoral/ParameterDescriptor.h"
+#include "evoral/Sequence.h"
+#include "evoral/TypeMap.h"
+#include "evoral/midi_events.h"
+
+#include "ardour/ardour.h"
+
+#include "test_util.h"
+
+using namespace std;
+using namespace PBD;
+using namespace Evoral;
+
+static const char* localedir = LOCALEDIR;
+
+/* Measure loading, iterating and editing an Evoral::Sequence with many
+ * notes. Loading appends note on/off pairs in time order, the same way
+ * a MIDI model is loaded from a SMF.
+ *
+ * Usage: midi_sequence [n-notes] [n-edits]
+ */
+
+typedef Temporal::Beats Time;
+
+class BenchTypeMap : public TypeMap {
+public:
+	bool          type_is_midi (uint32_t) const { return true; }
+	uint8_t       parameter_midi_type (const Parameter&) const { return MIDI_CMD_CONTROL; }
+	ParameterType midi_parameter_type (const uint8_t*, uint32_t) const { return 0; }
+	std::string   to_symbol (const Parameter&) const { return "control"; }
+
+	ParameterDescriptor descriptor (const Parameter&) const {
+		ParameterDescriptor desc;
+		desc.upper      = 127;
+		desc.rangesteps = 128;
+		return desc;
+	}
+};
+
+class BenchSequence : public Sequence<Time> {
+public:
+	BenchSequence (TypeMap& map) : Sequence<Time> (map) {}
+
+	boost::shared_ptr<Control> control_factory (const Parameter& param) {
+		ParameterDescriptor desc;
+		desc.upper      = 127;
+		desc.rangesteps = 128;
+		boost::shared_ptr<ControlList> list (new ControlList (param, desc, Temporal::BeatTime));
+		return boost::shared_ptr<Control> (new Control (param, desc, list));
+	}
+};
+
+struct NoteEvent {
+	Time    time;
+	uint8_t buf[3];
+
+	bool operator< (NoteEvent const& other) const {
+		/* note-offs first, so that repeated notes do not overlap */
+		return time < other.time || (time == other.time && (buf[0] & 0xf0) == MIDI_CMD_NOTE_OFF && (other.buf[0] & 0xf0) != MIDI_CMD_NOTE_OFF);
+	}
+};
+
+int
+main (int argc, char* argv[])
+{
+	int n_notes = argc > 1 ? atoi (argv[1]) : 100000;
+	int n_edits = argc > 2 ? atoi (argv[2]) : 10000;
+
+	if (n_notes < 1 || n_edits < 1) {
+		cerr << argv[0] << ": [n-notes] [n-edits]\n";
+		exit (EXIT_FAILURE);
+	}
+
+	ARDOUR::init (true, localedir);
+
+	/* dense, overlapping notes on all channels, roughly what a large
+	 * orchestral piece looks like.
+	 */
+	vector<NoteEvent> events;
+	events.reserve (2 * n_notes);
+
+	seed_test_random ();
+	for (int i = 0; i < n_notes; ++i) {
+		const uint8_t chn   = rand () % 16;
+		const uint8_t pitch = 24 + rand () % 80;
+		const Time    start (Time::ticks ((int64_t) i * 64 + rand () % 64));
+		const Time    len (Time::ticks (32 + rand () % (4 * Temporal::ticks_per_beat)));
+
+		NoteEvent on  = { start, { (uint8_t) (MIDI_CMD_NOTE_ON | chn), pitch, (uint8_t) (1 + rand () % 127) } };
+		NoteEvent off = { start + len, { (uint8_t) (MIDI_CMD_NOTE_OFF | chn), pitch, 64 } };
+		events.push_back (on);
+		events.push_back (off);
+	}
+
+	std::stable_sort (events.begin (), events.end ());
+
+	BenchTypeMap  type_map;
+	BenchSequence seq (type_map);
+
+	printf ("# %d notes, %d edits\n", n_notes, n_edits);
+
+	/* load */
+	microseconds_t t0 = get_microseconds ();
+	seq.start_write ();
+	for (vector<NoteEvent>::iterator e = events.begin (); e != events.end (); ++e) {
+		Event<Time> ev (MIDI_EVENT, e->time, 3, e->buf, false);
+		seq.append (ev, next_event_id ());
+	}
+	seq.end_write (Sequence<Time>::ResolveStuckNotes, events.back ().time);
+	microseconds_t t1 = get_microseconds ();
+
+	printf ("%-24s %10.3f MEvents/sec (%zu notes)\n", "load", mops (events.size (), t0, t1), seq.notes ().size ());
+
+	/* copy */
+	t0 = get_microseconds ();
+	{
+		BenchSequence copy (seq);
+	}
+	t1 = get_microseconds ();
+
+	printf ("%-24s %10.3f MNotes/sec\n", "copy", mops (seq.notes ().size (), t0, t1));
+
+	/* iterate over all events, in order */
+	size_t n_events = 0;
+	t0 = get_microseconds ();
+	for (Sequence<Time>::const_iterator i = seq.begin (); i != seq.end (); ++i) {
+		++n_events;
+	}
+	t1 = get_microseconds ();
+
+	printf ("%-24s %10.3f MEvents/sec (%zu events)\n", "iterate", mops (n_events, t0, t1), n_events);
+
+	/* seek: start iterating at random positions */
+	const Time seq_end = events.back ().time;
+	t0 = get_microseconds ();
+	for (int i = 0; i < n_edits; ++i) {
+		Sequence<Time>::const_iterator it = seq.begin (Time::ticks (rand () % std::max<int64_t> (1, seq_end.to_ticks ())));
+		if (it != seq.end ()) {
+			++n_events;
+		}
+	}
+	t1 = get_microseconds ();
+
+	printf ("%-24s %10.3f MSeeks/sec\n", "seek", mops (n_edits, t0, t1));
+
+	/* edit: remove and re-add random notes, check for overlaps */
+	vector<Sequence<Time>::NotePtr> victims;
+	victims.reserve (n_edits);
+	for (Sequence<Time>::Notes::const_iterator n = seq.notes ().begin (); n != seq.notes ().end () && victims.size () < (size_t) n_edits; ++n) {
+		if (rand () % 4 == 0) {
+			victims.push_back (*n);
+		}
+	}
+
+	t0 = get_microseconds ();
+	{
+		Sequence<Time>::WriteLock lock (seq.write_lock ());
+		for (vector<Sequence<Time>::NotePtr>::iterator n = victims.begin (); n != victims.end (); ++n) {
+			seq.remove_note_unlocked (*n);
+		}
+		for (vector<Sequence<Time>::NotePtr>::iterator n = victims.begin (); n != victims.end (); ++n) {
+			(*n)->set_time ((*n)->time () + Time::ticks (7));
+			seq.add_note_unlocked (*n);
+		}
+	}
+	t1 = get_microseconds ();
+
+	printf ("%-24s %10.3f MEdits/sec\n", "remove + add", mops (2 * victims.size (), t0, t1));
+
+	size_t n_overlaps = 0;
+	t0 = get_microseconds ();
+	for (vector<Sequence<Time>::NotePtr>::iterator n = victims.begin (); n != victims.end (); ++n) {
+		if (seq.overlaps (*n, *n)) {
+			++n_overlaps;
+		}
+	}
+	t1 = get_microseconds ();
+
+	printf ("%-24s %10.3f MLookups/sec (%zu overlaps)\n", "overlaps", mops (victims.size (), t0, t1), n_overlaps);
+
+	ARDOUR::cleanup ();
+
+	return n_events == 0 ? 1 : 0;
+}
@@ -0,0 +1,220 @@
+#include <algorithm>
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "pbd/fpu.h"
+#include "pbd/malign.h"
+#include "pbd/microseconds.h"
+
+#include "ardour/mix.h"
+#include "ardour/runtime_functions.h"
+
+using namespace std;
+using namespace PBD;
+using namespace ARDOUR;
+
+/* Compare the throughput of the runtime-dispatched DSP functions
+ * (ardour/runtime_functions.h) for all implementations that are
+ * available on this CPU, with the plain C version as reference.
+ *
+ * Usage: mix_functions [buffer-size] [iterations]
+ */
+
+struct Kernels {
+	const char*             name;
+	compute_peak_t          compute_peak;
+	find_peaks_t            find_peaks;
+	apply_gain_to_buffer_t  apply_gain_to_buffer;
+	mix_buffers_with_gain_t mix_buffers_with_gain;
+	mix_buffers_no_gain_t   mix_buffers_no_gain;
+	copy_vector_t           copy_vector;
+	apply_gain_ramp_t       apply_gain_ramp;
+	interleave_t            interleave;
+	deinterleave_t          deinterleave;
+	float_to_s32_t          float_to_s32;
+};
+
+static const char* kernel_names[] = {
+	"compute_peak",
+	"find_peaks",
+	"apply_gain_to_buffer",
+	"mix_buffers_with_gain",
+	"mix_buffers_no_gain",
+	"copy_vector",
+	"apply_gain_ramp",
+	"interleave (stereo)",
+	"deinterleave (stereo)",
+	"float_to_s32",
+};
+
+static const int n_kernels = sizeof (kernel_names) / sizeof (kernel_names[0]);
+
+static float*   buf1;
+static float*   buf2;
+static float*   ibuf;
+static int32_t* sbuf;
+
+static void
+run_kernel (Kernels const& k, int which, pframes_t n)
+{
+	float a = 0;
+	float b = 0;
+
+	switch (which) {
+		case 0:
+			a = k.compute_peak (buf1, n, a);
+			break;
+		case 1:
+			k.find_peaks (buf1, n, &a, &b);
+			break;
+		case 2:
+			k.apply_gain_to_buffer (buf1, n, 1.f);
+			break;
+		case 3:
+			k.mix_buffers_with_gain (buf1, buf2, n, .5f);
+			break;
+		case 4:
+			k.mix_buffers_no_gain (buf1, buf2, n);
+			break;
+		case 5:
+			k.copy_vector (buf1, buf2, n);
+			break;
+		case 6:
+			k.apply_gain_ramp (buf1, n, 1.f, 1.f);
+			break;
+		case 7:
+			k.interleave (ibuf, buf1, n, 1, 2);
+			break;
+		case 8:
+			k.deinterleave (buf1, ibuf, n, 1, 2);
+			break;
+		case 9:
+			k.float_to_s32 (sbuf, buf1, n);
+			break;
+	}
+}
+
+int
+main (int argc, char* argv[])
+{
+	pframes_t n_samples  = argc > 1 ? atoi (argv[1]) : 1024;
+	int       iterations = argc > 2 ? atoi (argv[2]) : 100000;
+
+	if (n_samples < 1 || iterations < 1) {
+		cerr << argv[0] << ": [buffer-size] [iterations]\n";
+		exit (EXIT_FAILURE);
+	}
+
+	cache_aligned_malloc ((void**) &buf1, sizeof (float) * n_samples);
+	cache_aligned_malloc ((void**) &buf2, sizeof (float) * n_samples);
+	cache_aligned_malloc ((void**) &ibuf, sizeof (float) * n_samples * 2);
+	cache_aligned_malloc ((void**) &sbuf, sizeof (int32_t) * n_samples);
+
+	for (pframes_t i = 0; i < n_samples; ++i) {
+		buf1[i] = buf2[i] = ibuf[2 * i] = ibuf[2 * i + 1] = (float) ((int) (i % 97) - 48) / 50.f;
+	}
+
+	vector<Kernels> variants;
+
+	Kernels k = {
+		"default",
+		default_compute_peak, default_find_peaks, default_apply_gain_to_buffer,
+		default_mix_buffers_with_gain, default_mix_buffers_no_gain, default_copy_vector,
+		default_apply_gain_ramp, default_interleave, default_deinterleave, default_float_to_s32
+	};
+	variants.push_back (k);
+
+#if defined(ARCH_X86) && defined(BUILD_SSE_OPTIMIZATIONS)
+	FPU* fpu = FPU::instance ();
+
+	if (fpu->has_sse ()) {
+		k.name                  = "SSE";
+		k.compute_peak          = x86_sse_compute_peak;
+		k.find_peaks            = x86_sse_find_peaks;
+		k.apply_gain_to_buffer  = x86_sse_apply_gain_to_buffer;
+		k.mix_buffers_with_gain = x86_sse_mix_buffers_with_gain;
+		k.mix_buffers_no_gain   = x86_sse_mix_buffers_no_gain;
+		variants.push_back (k);
+	}
+	if (fpu->has_avx ()) {
+		k.name                  = "AVX";
+		k.compute_peak          = x86_sse_avx_compute_peak;
+		k.find_peaks            = x86_sse_avx_find_peaks;
+		k.apply_gain_to_buffer  = x86_sse_avx_apply_gain_to_buffer;
+		k.mix_buffers_with_gain = x86_sse_avx_mix_buffers_with_gain;
+		k.mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
+		k.copy_vector           = x86_sse_avx_copy_vector;
+		k.apply_gain_ramp       = x86_avx_apply_gain_ramp;
+		k.interleave            = x86_avx_interleave;
+		k.deinterleave          = x86_avx_deinterleave;
+		k.float_to_s32          = x86_avx_float_to_s32;
+		variants.push_back (k);
+	}
+#ifdef FPU_AVX_FMA_SUPPORT
+	if (fpu->has_avx () && fpu->has_fma ()) {
+		k.name                  = "AVX/FMA";
+		k.mix_buffers_with_gain = x86_fma_mix_buffers_with_gain;
+		variants.push_back (k);
+	}
+#endif
+#ifdef FPU_AVX512F_SUPPORT
+	if (fpu->has_avx512f ()) {
+		k.name                  = "AVX-512";
+		k.compute_peak          = x86_avx512f_compute_peak;
+		k.find_peaks            = x86_avx512f_find_peaks;
+		k.apply_gain_to_buffer  = x86_avx512f_apply_gain_to_buffer;
+		k.mix_buffers_with_gain = x86_avx512f_mix_buffers_with_gain;
+		k.mix_buffers_no_gain   = x86_avx512f_mix_buffers_no_gain;
+		k.copy_vector           = x86_avx512f_copy_vector;
+		k.apply_gain_ramp       = x86_avx512f_apply_gain_ramp;
+		k.interleave            = x86_avx512f_interleave;
+		k.deinterleave          = x86_avx512f_deinterleave;
+		k.float_to_s32          = x86_avx512f_float_to_s32;
+		variants.push_back (k);
+	}
+#endif
+#elif defined ARM_NEON_SUPPORT
+	if (FPU::instance ()->has_neon ()) {
+		k.name                  = "NEON";
+		k.compute_peak          = arm_neon_compute_peak;
+		k.find_peaks            = arm_neon_find_peaks;
+		k.apply_gain_to_buffer  = arm_neon_apply_gain_to_buffer;
+		k.mix_buffers_with_gain = arm_neon_mix_buffers_with_gain;
+		k.mix_buffers_no_gain   = arm_neon_mix_buffers_no_gain;
+		k.copy_vector           = arm_neon_copy_vector;
+		variants.push_back (k);
+	}
+#endif
+
+	printf ("# %d iterations of %d samples, throughput in MSamples/sec\n", iterations, n_samples);
+	printf ("%-24s", "#");
+	for (vector<Kernels>::const_iterator v = variants.begin (); v != variants.end (); ++v) {
+		printf (" %10s", v->name);
+	}
+	printf ("\n");
+
+	for (int which = 0; which < n_kernels; ++which) {
+		printf ("%-24s", kernel_names[which]);
+		for (vector<Kernels>::const_iterator v = variants.begin (); v != variants.end (); ++v) {
+			/* warm up */
+			for (int i = 0; i < 64; ++i) {
+				run_kernel (*v, which, n_samples);
+			}
+			microseconds_t t0 = get_microseconds ();
+			for (int i = 0; i < iterations; ++i) {
+				run_kernel (*v, which, n_samples);
+			}
+			microseconds_t t1 = get_microseconds ();
+			printf (" %10.1f", (double) n_samples * iterations / (double) std::max<microseconds_t> (1, t1 - t0));
+		}
+		printf ("\n");
+	}
+
+	cache_aligned_free (buf1);
+	cache_aligned_free (buf2);
+	cache_aligned_free (ibuf);
+	cache_aligned_free (sbuf);
+	return 0;
+}
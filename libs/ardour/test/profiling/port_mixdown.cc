@@ -0,0 +1,108 @@
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+
+#include "pbd/compose.h"
+#include "pbd/microseconds.h"
+#include "pbd/timing.h"
+
+#include "ardour/ardour.h"
+#include "ardour/audioengine.h"
+#include "ardour/port.h"
+
+#include "test_ui.h"
+#include "test_util.h"
+
+using namespace std;
+using namespace PBD;
+using namespace ARDOUR;
+
+static const char* localedir = LOCALEDIR;
+
+/* Measure the backend's port mixdown: <outputs> audio ports are
+ * connected round-robin to <inputs> audio ports of the dummy backend,
+ * and the time to collect the buffers of all inputs is reported per
+ * cycle, as well as the time spent to connect and disconnect the ports.
+ */
+
+int
+main (int argc, char* argv[])
+{
+	int n_outputs = argc > 1 ? atoi (argv[1]) : 1000;
+	int n_inputs  = argc > 2 ? atoi (argv[2]) : 8;
+	int n_cycles  = argc > 3 ? atoi (argv[3]) : 16384;
+
+	if (n_outputs < 1 || n_inputs < 1 || n_cycles < 2) {
+		cerr << argv[0] << ": [outputs] [inputs] [cycles]\n";
+		exit (EXIT_FAILURE);
+	}
+
+	ARDOUR::init (true, localedir);
+	TestUI* test_ui = new TestUI ();
+
+	create_and_start_dummy_backend ();
+
+	AudioEngine* engine = AudioEngine::instance ();
+	pframes_t nframes = engine->samples_per_cycle ();
+
+	vector<boost::shared_ptr<Port> > outputs;
+	vector<boost::shared_ptr<Port> > inputs;
+
+	for (int i = 0; i < n_outputs; ++i) {
+		outputs.push_back (engine->register_output_port (DataType::AUDIO, string_compose ("out %1", i)));
+	}
+	for (int i = 0; i < n_inputs; ++i) {
+		inputs.push_back (engine->register_input_port (DataType::AUDIO, string_compose ("in %1", i)));
+	}
+
+	microseconds_t t0 = get_microseconds ();
+	for (int i = 0; i < n_outputs; ++i) {
+		engine->connect (outputs[i]->name (), inputs[i % n_inputs]->name ());
+	}
+	microseconds_t t1 = get_microseconds ();
+
+	TimingStats stats;
+
+	{
+		Glib::Threads::Mutex::Lock lm (engine->process_lock ());
+		PortEngine& port_engine (engine->port_engine ());
+
+		/* warm up */
+		for (int c = 0; c < 256; ++c) {
+			for (int i = 0; i < n_inputs; ++i) {
+				port_engine.get_buffer (inputs[i]->port_handle (), nframes);
+			}
+		}
+
+		for (int c = 0; c < n_cycles; ++c) {
+			stats.start ();
+			for (int i = 0; i < n_inputs; ++i) {
+				port_engine.get_buffer (inputs[i]->port_handle (), nframes);
+			}
+			stats.update ();
+		}
+	}
+
+	microseconds_t t2 = get_microseconds ();
+	for (int i = 0; i < n_outputs; ++i) {
+		engine->disconnect (outputs[i]->name (), inputs[i % n_inputs]->name ());
+	}
+	microseconds_t t3 = get_microseconds ();
+
+	microseconds_t min, max;
+	double avg, dev;
+	if (stats.get_stats (min, max, avg, dev)) {
+		cout << string_compose ("%1 outputs -> %2 inputs, %3 cycles of %4 samples\n", n_outputs, n_inputs, n_cycles, nframes);
+		cout << string_compose ("  mixdown per cycle [us]: min: %1 max: %2 avg: %3 dev: %4 | per connection avg: %5\n",
+		                        min, max, avg, dev, avg / n_outputs);
+		cout << string_compose ("  connect: %1 us, disconnect: %2 us\n", t1 - t0, t3 - t2);
+	}
+
+	outputs.clear ();
+	inputs.clear ();
+
+	stop_and_destroy_backend ();
+	delete test_ui;
+	ARDOUR::cleanup ();
+	return 0;
+}
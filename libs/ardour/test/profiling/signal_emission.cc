@@ -0,0 +1,171 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include <pthread.h>
+
+#include <boost/bind.hpp>
+#include <glibmm/threads.h>
+
+#include "pbd/g_atomic_compat.h"
+#include "pbd/microseconds.h"
+#include "pbd/signals.h"
+
+using namespace std;
+using namespace PBD;
+
+/* Compare the throughput of PBD::Signal emission from several threads
+ * at once, while another thread keeps connecting and disconnecting a
+ * slot, with the locked-copy scheme that PBD::Signal used before its
+ * list of slots became immutable.
+ *
+ * Usage: signal_emission [max-threads] [emissions-per-thread] [slots]
+ */
+
+/* copy the slots with the lock held, and lock again before calling
+ * each one to check that it is still connected.
+ */
+class LockedSignal
+{
+public:
+	typedef std::map<int, boost::function<void()> > Slots;
+
+	void connect (int id, boost::function<void()> f) {
+		Glib::Threads::Mutex::Lock lm (_mutex);
+		_slots[id] = f;
+	}
+
+	void disconnect (int id) {
+		Glib::Threads::Mutex::Lock lm (_mutex);
+		_slots.erase (id);
+	}
+
+	void operator() () {
+		Slots s;
+		{
+			Glib::Threads::Mutex::Lock lm (_mutex);
+			s = _slots;
+		}
+		for (Slots::const_iterator i = s.begin (); i != s.end (); ++i) {
+			bool still_there = false;
+			{
+				Glib::Threads::Mutex::Lock lm (_mutex);
+				still_there = _slots.find (i->first) != _slots.end ();
+			}
+			if (still_there) {
+				(i->second) ();
+			}
+		}
+	}
+
+private:
+	Glib::Threads::Mutex _mutex;
+	Slots                _slots;
+};
+
+static int n_emissions = 100000;
+static int n_connected = 8;
+
+static void
+count_call (GATOMIC_QUAL gint* cnt)
+{
+	g_atomic_int_inc (cnt);
+}
+
+struct EmitterThread
+{
+	EmitterThread () : sig (0), lsig (0) {}
+
+	void run () {
+		for (int i = 0; i < n_emissions; ++i) {
+			if (sig) {
+				(*sig) ();
+			} else {
+				(*lsig) ();
+			}
+		}
+	}
+
+	static void* launch (void* arg) {
+		static_cast<EmitterThread*> (arg)->run ();
+		return 0;
+	}
+
+	Signal0<void>* sig;
+	LockedSignal*  lsig;
+};
+
+/* @return emissions per second */
+static double
+contended_emission (Signal0<void>* sig, LockedSignal* lsig, int n_threads, GATOMIC_QUAL gint* cnt)
+{
+	vector<EmitterThread> emitters (n_threads);
+	vector<pthread_t>     threads (n_threads);
+
+	microseconds_t start = get_microseconds ();
+
+	for (int i = 0; i < n_threads; ++i) {
+		emitters[i].sig  = sig;
+		emitters[i].lsig = lsig;
+		if (pthread_create (&threads[i], NULL, EmitterThread::launch, &emitters[i])) {
+			cerr << "cannot create thread\n";
+			exit (EXIT_FAILURE);
+		}
+	}
+
+	/* keep changing the list of slots while the emitters run */
+	for (int i = 0; i < 1000; ++i) {
+		if (sig) {
+			ScopedConnection c;
+			sig->connect_same_thread (c, boost::bind (&count_call, cnt));
+		} else {
+			lsig->connect (n_connected, boost::bind (&count_call, cnt));
+			lsig->disconnect (n_connected);
+		}
+	}
+
+	for (int i = 0; i < n_threads; ++i) {
+		pthread_join (threads[i], NULL);
+	}
+
+	microseconds_t elapsed = std::max<microseconds_t> (1, get_microseconds () - start);
+	return (double) n_threads * n_emissions * 1e6 / elapsed;
+}
+
+int
+main (int argc, char* argv[])
+{
+	int max_threads = argc > 1 ? atoi (argv[1]) : 8;
+	n_emissions     = argc > 2 ? atoi (argv[2]) : 100000;
+	n_connected     = argc > 3 ? atoi (argv[3]) : 8;
+
+	if (max_threads < 1 || n_emissions < 1 || n_connected < 0) {
+		cerr << argv[0] << ": [max-threads] [emissions-per-thread] [slots]\n";
+		exit (EXIT_FAILURE);
+	}
+
+	GATOMIC_QUAL gint cnt = 0;
+
+	Signal0<void> sig;
+	LockedSignal  lsig;
+
+	ScopedConnectionList clist;
+	for (int i = 0; i < n_connected; ++i) {
+		sig.connect_same_thread (clist, boost::bind (&count_call, &cnt));
+		lsig.connect (i, boost::bind (&count_call, &cnt));
+	}
+
+	printf ("# emissions/sec of a signal with %d slots\n", n_connected);
+	printf ("# threads locked-copy PBD::Signal\n");
+
+	for (int n_threads = 1; n_threads <= max_threads; n_threads *= 2) {
+		double locked   = contended_emission (0, &lsig, n_threads, &cnt);
+		double lockfree = contended_emission (&sig, 0, n_threads, &cnt);
+		printf ("%d %.0f %.0f\n", n_threads, locked, lockfree);
+	}
+
+	return 0;
+}
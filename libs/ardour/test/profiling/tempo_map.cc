@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "pbd/microseconds.h"
+
+#include "temporal/tempo.h"
+#include "temporal/types.h"
+
+#include "ardour/ardour.h"
+
+#include "test_util.h"
+
+using namespace std;
+using namespace PBD;
+using namespace Temporal;
+
+static const char* localedir = LOCALEDIR;
+
+/* Measure the throughput of tempo map conversions on a map with many
+ * tempo changes. The published map uses its lookup table, a private
+ * copy of it (as used while editing the map) walks the list of points.
+ *
+ * Usage: tempo_map [n-tempos] [iterations]
+ */
+
+static vector<superclock_t> sclocks;
+static vector<Beats>        beats;
+static vector<BBT_Time>     bbts;
+
+static int64_t sink = 0;
+
+static const char* conversion_names[] = {
+	"superclock_at (Beats)",
+	"superclock_at (BBT_Time)",
+	"quarters_at_superclock",
+	"quarters_at (BBT_Time)",
+	"bbt_at (timepos_t)",
+	"bbt_at (Beats)",
+	"tempo_at (superclock_t)",
+	"metric_at (Beats)",
+};
+
+static const int n_conversions = sizeof (conversion_names) / sizeof (conversion_names[0]);
+
+static void
+run_conversion (TempoMap const& map, int which)
+{
+	const size_t n = sclocks.size ();
+
+	switch (which) {
+		case 0:
+			for (size_t i = 0; i < n; ++i) { sink += map.superclock_at (beats[i]); }
+			break;
+		case 1:
+			for (size_t i = 0; i < n; ++i) { sink += map.superclock_at (bbts[i]); }
+			break;
+		case 2:
+			for (size_t i = 0; i < n; ++i) { sink += map.quarters_at_superclock (sclocks[i]).to_ticks (); }
+			break;
+		case 3:
+			for (size_t i = 0; i < n; ++i) { sink += map.quarters_at (bbts[i]).to_ticks (); }
+			break;
+		case 4:
+			for (size_t i = 0; i < n; ++i) { sink += map.bbt_at (timepos_t::from_superclock (sclocks[i])).bars; }
+			break;
+		case 5:
+			for (size_t i = 0; i < n; ++i) { sink += map.bbt_at (beats[i]).bars; }
+			break;
+		case 6:
+			for (size_t i = 0; i < n; ++i) { sink += map.tempo_at (sclocks[i]).superclocks_per_note_type (); }
+			break;
+		case 7:
+			for (size_t i = 0; i < n; ++i) { sink += map.metric_at (beats[i]).superclocks_per_note_type (); }
+			break;
+	}
+}
+
+int
+main (int argc, char* argv[])
+{
+	int n_tempos   = argc > 1 ? atoi (argv[1]) : 1000;
+	int iterations = argc > 2 ? atoi (argv[2]) : 10;
+
+	if (n_tempos < 1 || iterations < 1) {
+		cerr << argv[0] << ": [n-tempos] [iterations]\n";
+		exit (EXIT_FAILURE);
+	}
+
+	ARDOUR::init (true, localedir);
+
+	/* the map is rather verbose while it is being modified */
+	cerr.setstate (ios::failbit);
+
+	TempoMap::SharedPtr tmap (TempoMap::write_copy ());
+	for (int n = 1; n <= n_tempos; ++n) {
+		tmap->set_tempo (Tempo (80 + (n * 7) % 100, 4), timepos_t (Beats (2 * n, 0)));
+	}
+	TempoMap::update (tmap);
+
+	cerr.clear ();
+
+	TempoMap::SharedPtr published (TempoMap::use ());
+	TempoMap const      plain (*published);
+
+	/* positions spread over the whole map, in pseudo-random order */
+	const int64_t n_ticks = (int64_t) 2 * (n_tempos + 1) * ticks_per_beat;
+	const size_t  n_pos   = 10000;
+
+	seed_test_random ();
+	for (size_t i = 0; i < n_pos; ++i) {
+		Beats b (Beats::ticks (((int64_t) rand () * RAND_MAX + rand ()) % n_ticks));
+		beats.push_back (b);
+		sclocks.push_back (plain.superclock_at (b));
+		bbts.push_back (plain.bbt_at (b));
+	}
+
+	printf ("# %d tempo changes, %d x %d conversions, throughput in MConversions/sec\n", n_tempos, iterations, (int) n_pos);
+	printf ("%-28s %10s %10s\n", "#", "list-walk", "lookup");
+
+	for (int which = 0; which < n_conversions; ++which) {
+		TempoMap const* maps[2] = { &plain, published.get () };
+		printf ("%-28s", conversion_names[which]);
+		for (int m = 0; m < 2; ++m) {
+			/* warm up */
+			run_conversion (*maps[m], which);
+			microseconds_t t0 = get_microseconds ();
+			for (int i = 0; i < iterations; ++i) {
+				run_conversion (*maps[m], which);
+			}
+			microseconds_t t1 = get_microseconds ();
+			printf (" %10.3f", mops (n_pos * iterations, t0, t1));
+		}
+		printf ("\n");
+	}
+
+	ARDOUR::cleanup ();
+
+	return sink == 42 ? 1 : 0;
+}
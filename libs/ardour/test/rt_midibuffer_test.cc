@@ -0,0 +1,112 @@
+#include <cstring>
+#include <vector>
+
+#include "ardour/rt_midibuffer.h"
+
+#include "rt_midibuffer_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (RTMidiBufferTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+static void
+write_notes (RTMidiBuffer& buf, samplepos_t start, samplepos_t end, samplecnt_t step, uint8_t note)
+{
+	for (samplepos_t t = start; t <= end; t += step) {
+		uint8_t on[3] = { 0x90, note, 0x40 };
+		buf.write (t, Evoral::MIDI_EVENT, 3, on);
+	}
+}
+
+static void
+check_sorted (RTMidiBuffer& buf)
+{
+	for (size_t n = 1; n < buf.size (); ++n) {
+		CPPUNIT_ASSERT (buf[n - 1].timestamp <= buf[n].timestamp);
+	}
+}
+
+void
+RTMidiBufferTest::replaceTest ()
+{
+	RTMidiBuffer buf;
+	write_notes (buf, 0, 99000, 1000, 60);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 100, buf.size ());
+
+	/* grow the range: 11 events in [10000, 20000] by 21 */
+	RTMidiBuffer more;
+	write_notes (more, 10000, 20000, 500, 61);
+	buf.replace (10000, 20000, more);
+
+	CPPUNIT_ASSERT_EQUAL ((size_t) 110, buf.size ());
+	check_sorted (buf);
+
+	for (size_t n = 0; n < buf.size (); ++n) {
+		uint32_t size;
+		uint8_t const* data = buf.bytes (buf[n], size);
+		CPPUNIT_ASSERT_EQUAL ((uint32_t) 3, size);
+		const bool inside = buf[n].timestamp >= 10000 && buf[n].timestamp <= 20000;
+		CPPUNIT_ASSERT_EQUAL (inside ? (uint8_t) 61 : (uint8_t) 60, data[1]);
+	}
+
+	/* shrink it, and remove a range at the end */
+	RTMidiBuffer less;
+	write_notes (less, 15000, 15000, 1, 62);
+	buf.replace (10000, 20000, less);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 90, buf.size ());
+
+	RTMidiBuffer none;
+	buf.replace (90000, 200000, none);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 80, buf.size ());
+	CPPUNIT_ASSERT_EQUAL ((samplepos_t) 89000, buf[buf.size () - 1].timestamp);
+	check_sorted (buf);
+
+	/* sysex (blob) data is copied */
+	RTMidiBuffer sysex;
+	uint8_t sx[6] = { 0xf0, 0x7e, 0x7f, 0x06, 0x01, 0xf7 };
+	sysex.write (500, Evoral::MIDI_EVENT, sizeof (sx), sx);
+	buf.replace (500, 500, sysex);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 81, buf.size ());
+
+	uint32_t size;
+	uint8_t const* data = buf.bytes (buf[1], size);
+	CPPUNIT_ASSERT_EQUAL ((samplepos_t) 500, buf[1].timestamp);
+	CPPUNIT_ASSERT_EQUAL ((uint32_t) sizeof (sx), size);
+	CPPUNIT_ASSERT (memcmp (data, sx, size) == 0);
+}
+
+void
+RTMidiBufferTest::replaceNotesTest ()
+{
+	RTMidiBuffer buf;
+	for (samplepos_t t = 0; t < 10000; t += 1000) {
+		uint8_t cc[3] = { 0xb0, 7, 0x40 };
+		buf.write (t, Evoral::MIDI_EVENT, 3, cc);
+	}
+	write_notes (buf, 0, 9500, 500, 60);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 30, buf.size ());
+
+	/* controllers in the range are kept, notes are replaced */
+	RTMidiBuffer notes;
+	write_notes (notes, 3000, 3000, 1, 61);
+	write_notes (notes, 4250, 5000, 750, 61);
+	buf.replace_notes (3000, 5000, notes);
+
+	CPPUNIT_ASSERT_EQUAL ((size_t) 28, buf.size ());
+	check_sorted (buf);
+
+	size_t n_notes = 0;
+	for (size_t n = 0; n < buf.size (); ++n) {
+		uint32_t size;
+		uint8_t const* data = buf.bytes (buf[n], size);
+		if (data[0] == 0xb0) {
+			CPPUNIT_ASSERT_EQUAL ((samplepos_t) 0, buf[n].timestamp % 1000);
+			continue;
+		}
+		const bool inside = buf[n].timestamp >= 3000 && buf[n].timestamp <= 5000;
+		CPPUNIT_ASSERT_EQUAL (inside ? (uint8_t) 61 : (uint8_t) 60, data[1]);
+		++n_notes;
+	}
+	CPPUNIT_ASSERT_EQUAL ((size_t) 18, n_notes);
+}
@@ -0,0 +1,14 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class RTMidiBufferTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (RTMidiBufferTest);
+	CPPUNIT_TEST (replaceTest);
+	CPPUNIT_TEST (replaceNotesTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void replaceTest ();
+	void replaceNotesTest ();
+};
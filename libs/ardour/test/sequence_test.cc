@@ -0,0 +1,229 @@
+#include <algorithm>
+#include <vector>
+
+#include "evoral/Control.h"
+#include "evoral/ControlList.h"
+#include "evoral/Event.h"
+#include "evoral/Sequence.h"
+#include "evoral/TypeMap.h"
+#include "evoral/midi_events.h"
+
+#include "sequence_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (SequenceTest);
+
+using namespace std;
+using namespace Evoral;
+
+typedef Temporal::Beats         Time;
+typedef Sequence<Time>::NotePtr NotePtr;
+typedef Sequence<Time>::Notes   Notes;
+
+class SequenceTestTypeMap : public TypeMap {
+public:
+	bool          type_is_midi (uint32_t) const { return true; }
+	uint8_t       parameter_midi_type (const Parameter&) const { return MIDI_CMD_CONTROL; }
+	ParameterType midi_parameter_type (const uint8_t*, uint32_t) const { return 0; }
+	std::string   to_symbol (const Parameter&) const { return "control"; }
+
+	ParameterDescriptor descriptor (const Parameter&) const {
+		ParameterDescriptor desc;
+		desc.upper      = 127;
+		desc.rangesteps = 128;
+		return desc;
+	}
+};
+
+class TestSequence : public Sequence<Time> {
+public:
+	TestSequence (TypeMap const& map) : Sequence<Time> (map) {}
+	TestSequence (TestSequence const& other) : ControlSet (other), Sequence<Time> (other) {}
+
+	boost::shared_ptr<Control> control_factory (const Parameter& param) {
+		ParameterDescriptor desc;
+		desc.upper      = 127;
+		desc.rangesteps = 128;
+		boost::shared_ptr<ControlList> list (new ControlList (param, desc, Temporal::BeatTime));
+		return boost::shared_ptr<Control> (new Control (param, desc, list));
+	}
+};
+
+static void
+append_note (TestSequence& seq, Time const& t, uint8_t cmd, uint8_t pitch, uint8_t velocity)
+{
+	uint8_t buf[3] = { cmd, pitch, velocity };
+	Event<Time> ev (MIDI_EVENT, t, 3, buf, false);
+	seq.append (ev, next_event_id ());
+}
+
+static vector<NotePtr>
+notes_of (Sequence<Time> const& seq)
+{
+	return vector<NotePtr> (seq.notes ().begin (), seq.notes ().end ());
+}
+
+/** Add, find and remove notes that only differ in length and velocity */
+void
+SequenceTest::equalNotesTest ()
+{
+	SequenceTestTypeMap map;
+	TestSequence        seq (map);
+
+	Sequence<Time>::WriteLock lock (seq.write_lock ());
+
+	vector<NotePtr> same;
+	for (int i = 0; i < 4; ++i) {
+		same.push_back (NotePtr (new Note<Time> (0, Time (1, 0), Time (i + 1, 0), 60, 100 + i)));
+		CPPUNIT_ASSERT (seq.add_note_unlocked (same.back ()));
+	}
+
+	NotePtr other (new Note<Time> (0, Time (1, 0), Time (1, 0), 61, 100));
+	CPPUNIT_ASSERT (seq.add_note_unlocked (other));
+
+	CPPUNIT_ASSERT_EQUAL ((size_t) 5, seq.notes ().size ());
+
+	/* equal notes are kept in the order they were added */
+	vector<NotePtr> n (notes_of (seq));
+	for (int i = 0; i < 4; ++i) {
+		CPPUNIT_ASSERT (n[i] == same[i]);
+		CPPUNIT_ASSERT (seq.contains (same[i]));
+	}
+
+	CPPUNIT_ASSERT (seq.overlaps (same[0], same[0]));
+	CPPUNIT_ASSERT (!seq.overlaps (other, other));
+
+	/* remove the exact note, not the first one with the same time and pitch */
+	seq.remove_note_unlocked (same[1]);
+
+	CPPUNIT_ASSERT_EQUAL ((size_t) 4, seq.notes ().size ());
+	CPPUNIT_ASSERT (!seq.contains (same[1]));
+	CPPUNIT_ASSERT (seq.contains (same[0]));
+	CPPUNIT_ASSERT (seq.contains (same[2]));
+	CPPUNIT_ASSERT (seq.contains (same[3]));
+
+	n = notes_of (seq);
+	CPPUNIT_ASSERT (n[0] == same[0]);
+	CPPUNIT_ASSERT (n[1] == same[2]);
+	CPPUNIT_ASSERT (n[2] == same[3]);
+
+	/* the pitch index must agree with the time index */
+	Notes by_pitch;
+	seq.get_notes (by_pitch, Sequence<Time>::PitchEqual, 60);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 3, by_pitch.size ());
+	CPPUNIT_ASSERT (std::find (by_pitch.begin (), by_pitch.end (), same[1]) == by_pitch.end ());
+
+	/* a note whose time was changed after it was added is found by ID */
+	same[2]->set_time (Time (7, 0));
+	seq.remove_note_unlocked (same[2]);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 3, seq.notes ().size ());
+	by_pitch.clear ();
+	seq.get_notes (by_pitch, Sequence<Time>::PitchEqual, 60);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 2, by_pitch.size ());
+
+	seq.remove_note_unlocked (same[0]);
+	seq.remove_note_unlocked (same[3]);
+	seq.remove_note_unlocked (other);
+	CPPUNIT_ASSERT (seq.notes ().empty ());
+}
+
+/** Notes are inserted at the end of the time index, which must result in
+ * the same order as a plain insert, whatever order notes are added in.
+ */
+void
+SequenceTest::insertOrderTest ()
+{
+	SequenceTestTypeMap map;
+	TestSequence        seq (map);
+
+	Sequence<Time>::WriteLock lock (seq.write_lock ());
+
+	static const int times[] = { 5, 3, 3, 9, 0, 5, 1, 3, 9, 2 };
+	static const int n_times = sizeof (times) / sizeof (times[0]);
+
+	vector<NotePtr> added;
+	for (int i = 0; i < n_times; ++i) {
+		added.push_back (NotePtr (new Note<Time> (i % 2, Time (times[i], 0), Time (0, 10), 40 + i, 100)));
+		CPPUNIT_ASSERT (seq.add_note_unlocked (added.back ()));
+	}
+
+	vector<NotePtr> expected (added);
+	std::stable_sort (expected.begin (), expected.end (), Sequence<Time>::note_time_comparator);
+
+	vector<NotePtr> n (notes_of (seq));
+	CPPUNIT_ASSERT_EQUAL (expected.size (), n.size ());
+	for (size_t i = 0; i < n.size (); ++i) {
+		CPPUNIT_ASSERT (n[i] == expected[i]);
+	}
+
+	for (int i = 0; i < n_times; ++i) {
+		CPPUNIT_ASSERT (seq.note_lower_bound (Time (times[i], 0)) != seq.notes ().end ());
+		CPPUNIT_ASSERT ((*seq.note_lower_bound (Time (times[i], 0)))->time () == Time (times[i], 0));
+	}
+	CPPUNIT_ASSERT (seq.note_lower_bound (Time (10, 0)) == seq.notes ().end ());
+}
+
+/** Load note on/off pairs, as from a SMF, including repeated pitches */
+void
+SequenceTest::appendTest ()
+{
+	SequenceTestTypeMap map;
+	TestSequence        seq (map);
+
+	seq.start_write ();
+
+	append_note (seq, Time (0, 0),   MIDI_CMD_NOTE_ON,  60, 100);
+	append_note (seq, Time (0, 0),   MIDI_CMD_NOTE_ON,  64, 101);
+	/* overlapping notes of the same pitch are resolved first-in first-out */
+	append_note (seq, Time (0, 0),   MIDI_CMD_NOTE_ON,  62, 102);
+	append_note (seq, Time (0, 960), MIDI_CMD_NOTE_ON,  62, 103);
+	append_note (seq, Time (1, 0),   MIDI_CMD_NOTE_OFF, 60, 64);
+	append_note (seq, Time (1, 0),   MIDI_CMD_NOTE_OFF, 62, 64);
+	append_note (seq, Time (1, 0),   MIDI_CMD_NOTE_ON,  60, 104);
+	append_note (seq, Time (2, 0),   MIDI_CMD_NOTE_OFF, 64, 64);
+	append_note (seq, Time (2, 0),   MIDI_CMD_NOTE_OFF, 62, 64);
+	/* two notes with equal time and pitch */
+	append_note (seq, Time (2, 0),   MIDI_CMD_NOTE_ON,  62, 105);
+	append_note (seq, Time (2, 0),   MIDI_CMD_NOTE_ON,  62, 106);
+	append_note (seq, Time (3, 0),   MIDI_CMD_NOTE_OFF, 60, 64);
+	append_note (seq, Time (3, 0),   MIDI_CMD_NOTE_OFF, 62, 64);
+	append_note (seq, Time (4, 0),   MIDI_CMD_NOTE_OFF, 62, 64);
+
+	seq.end_write (Sequence<Time>::Relax, Time (4, 0));
+
+	struct Expected {
+		Time    time;
+		Time    length;
+		uint8_t pitch;
+		uint8_t velocity;
+	} const expected[] = {
+		{ Time (0, 0),   Time (1, 0),   60, 100 },
+		{ Time (0, 0),   Time (2, 0),   64, 101 },
+		{ Time (0, 0),   Time (1, 0),   62, 102 },
+		{ Time (0, 960), Time (1, 960), 62, 103 },
+		{ Time (1, 0),   Time (2, 0),   60, 104 },
+		{ Time (2, 0),   Time (1, 0),   62, 105 },
+		{ Time (2, 0),   Time (2, 0),   62, 106 },
+	};
+	const size_t n_expected = sizeof (expected) / sizeof (expected[0]);
+
+	vector<NotePtr> n (notes_of (seq));
+	CPPUNIT_ASSERT_EQUAL (n_expected, n.size ());
+
+	for (size_t i = 0; i < n_expected; ++i) {
+		CPPUNIT_ASSERT (n[i]->time () == expected[i].time);
+		CPPUNIT_ASSERT (n[i]->length () == expected[i].length);
+		CPPUNIT_ASSERT_EQUAL (expected[i].pitch, n[i]->note ());
+		CPPUNIT_ASSERT_EQUAL (expected[i].velocity, n[i]->velocity ());
+		CPPUNIT_ASSERT (seq.contains (n[i]));
+	}
+
+	/* a copy has new notes, in the same order */
+	TestSequence copy (seq);
+	vector<NotePtr> c (notes_of (copy));
+	CPPUNIT_ASSERT_EQUAL (n_expected, c.size ());
+
+	for (size_t i = 0; i < n_expected; ++i) {
+		CPPUNIT_ASSERT (c[i] != n[i]);
+		CPPUNIT_ASSERT (*c[i] == *n[i]);
+	}
+}
@@ -0,0 +1,16 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class SequenceTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (SequenceTest);
+	CPPUNIT_TEST (equalNotesTest);
+	CPPUNIT_TEST (insertOrderTest);
+	CPPUNIT_TEST (appendTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void equalNotesTest ();
+	void insertOrderTest ();
+	void appendTest ();
+};
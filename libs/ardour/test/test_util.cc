@@ -17,6 +17,8 @@
  * with this program; if not, write to the Free Software Foundation, Inc.,
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
+#include <algorithm>
+#include <cstdlib>
 #include <sstream>
 
 #include <glibmm/fileutils.h>
@@ -152,6 +154,18 @@ get_test_sample_rate ()
 	return 44100;
 }
 
+void
+seed_test_random ()
+{
+	srand (0x5eed);
+}
+
+double
+mops (size_t n, microseconds_t start, microseconds_t end)
+{
+	return (double) n / (double) std::max<microseconds_t> (1, end - start);
+}
+
 void
 get_utf8_test_strings (std::vector<std::string>& result)
 {
@@ -23,6 +23,7 @@
 #include <string>
 #include <list>
 
+#include "pbd/microseconds.h"
 #include "pbd/search_path.h"
 
 class XMLNode;
@@ -45,4 +46,10 @@ extern ARDOUR::Session* load_session (std::string, std::string);
 
 void get_utf8_test_strings (std::vector<std::string>& results);
 
+/** seed rand(), so that every profiling run uses the same data */
+extern void seed_test_random ();
+
+/** @return million operations per second, for @p n operations in [@p start, @p end) */
+extern double mops (size_t n, PBD::microseconds_t start, PBD::microseconds_t end);
+
 #endif
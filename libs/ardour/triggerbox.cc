@@ -1231,11 +1231,30 @@ AudioTrigger::AudioTrigger (uint32_t n, TriggerBox& b)
 	, got_stretcher_padding (false)
 	, to_pad (0)
 	, to_drop (0)
+	, _stretched (0)
+	, _stretched_in_use (0)
+	, _prestretched (0)
+	, _select_stretched (false)
+	, _wanted_seq (0)
+	, _wanted_clip (0)
+	, _wanted_tempo (0)
+	, _wanted_bpm (0)
+	, _wanted_mode (Trigger::Crisp)
+	, _rendered_seq (0)
 {
+	if (TriggerBox::worker) {
+		TriggerBox::worker->add_audio_trigger (this);
+	}
 }
 
 AudioTrigger::~AudioTrigger ()
 {
+	if (TriggerBox::worker) {
+		TriggerBox::worker->remove_audio_trigger (this);
+	}
+	for (std::vector<Stretched*>::iterator i = _stretched_all.begin(); i != _stretched_all.end(); ++i) {
+		delete *i;
+	}
 	drop_data ();
 	delete _stretcher;
 }
@@ -1719,6 +1738,21 @@ AudioTrigger::reset_stretcher ()
 	to_drop = 0;
 }
 
+//map our internal enum to a rubberband option
+static RubberBand::RubberBandStretcher::Option
+transients_option (Trigger::StretchMode sm)
+{
+	using namespace RubberBand;
+
+	switch (sm) {
+		case Trigger::Mixed  : return RubberBandStretcher::OptionTransientsMixed;
+		case Trigger::Smooth : return RubberBandStretcher::OptionTransientsSmooth;
+		default:
+			break;
+	}
+	return RubberBandStretcher::OptionTransientsCrisp;
+}
+
 void
 AudioTrigger::setup_stretcher ()
 {
@@ -1732,16 +1766,8 @@ AudioTrigger::setup_stretcher ()
 	boost::shared_ptr<AudioRegion> ar (boost::dynamic_pointer_cast<AudioRegion> (_region));
 	const uint32_t nchans = std::min (_box.input_streams().n_audio(), ar->n_channels());
 
-	//map our internal enum to a rubberband option
-	RubberBandStretcher::Option ro;
-	switch (_stretch_mode) {
-		case Trigger::Crisp  : ro = RubberBandStretcher::OptionTransientsCrisp; break;
-		case Trigger::Mixed  : ro = RubberBandStretcher::OptionTransientsMixed; break;
-		case Trigger::Smooth : ro = RubberBandStretcher::OptionTransientsSmooth; break;
-	}
-
 	RubberBandStretcher::Options options = RubberBandStretcher::Option (RubberBandStretcher::OptionProcessRealTime |
-	                                                                    ro);
+	                                                                    transients_option (_stretch_mode));
 
 	delete _stretcher;
 	_stretcher = new RubberBandStretcher (_box.session().sample_rate(), nchans, options, 1.0, 1.0);
@@ -1749,35 +1775,213 @@ AudioTrigger::setup_stretcher ()
 }
 
 void
-AudioTrigger::drop_data ()
+AudioTrigger::render_wanted_stretch ()
+{
+	/* This is called from the TriggerBoxThread. Read a consistent
+	 * request, the process thread may update it at any time.
+	 */
+	uint32_t                    seq;
+	AudioClipCache::Clip const* clip;
+	double                      segment_tempo;
+	double                      bpm;
+	StretchMode                 sm;
+
+	do {
+		seq = _wanted_seq.load ();
+		if (seq & 1) {
+			/* being written, the writer summons us again when done */
+			return;
+		}
+		clip          = _wanted_clip.load ();
+		segment_tempo = _wanted_tempo.load ();
+		bpm           = _wanted_bpm.load ();
+		sm            = (StretchMode) _wanted_mode.load ();
+	} while (seq != _wanted_seq.load ());
+
+	if (seq == _rendered_seq) {
+		return;
+	}
+
+	_rendered_seq = seq;
+
+	/* data.clip is only changed by this thread, so the request is
+	 * obsolete unless it is about the current data.
+	 */
+	if (!clip || clip != data.clip.get()) {
+		return;
+	}
+
+	render_stretched (data.clip, segment_tempo, bpm, sm);
+}
+
+void
+AudioTrigger::render_stretched (AudioClipCache::ClipPtr clip, double segment_tempo, double bpm, StretchMode sm)
 {
-	for (auto& d : data) {
-		delete [] d;
+	/* This is called from the TriggerBoxThread. Since all the data is
+	 * available, the stretcher can run in offline mode: it studies the
+	 * whole clip first, and has no latency to compensate for.
+	 */
+	using namespace RubberBand;
+
+	Stretched* current = _stretched.load ();
+
+	if (!clip || clip->empty () || clip->length == 0 || bpm <= 0 || (current && current->matches (clip.get(), segment_tempo, bpm, sm))) {
+		return;
 	}
+
+	const double      ratio   = segment_tempo / bpm;
+	const uint32_t    nchans  = clip->size ();
+	const samplecnt_t len     = clip->length;
+	const samplecnt_t out_len = (samplecnt_t) ceil (len * ratio);
+
+	RubberBandStretcher::Options options = RubberBandStretcher::Option (RubberBandStretcher::OptionProcessOffline |
+	                                                                    RubberBandStretcher::OptionThreadingNever |
+	                                                                    transients_option (sm));
+
+	RubberBandStretcher rb (_box.session().sample_rate(), nchans, options, ratio, 1.0);
+	rb.setExpectedInputDuration (len);
+	rb.setMaxProcessSize (rb_blocksize);
+
+	std::vector<Sample const*> in (nchans);
+
+	for (samplecnt_t pos = 0; pos < len; pos += rb_blocksize) {
+		const samplecnt_t n = std::min (rb_blocksize, len - pos);
+		for (uint32_t chn = 0; chn < nchans; ++chn) {
+			in[chn] = (*clip)[chn] + pos;
+		}
+		rb.study (&in[0], n, pos + n >= len);
+	}
+
+	Stretched* s = new Stretched;
+
+	s->source        = clip;
+	s->ratio         = ratio;
+	s->segment_tempo = segment_tempo;
+	s->bpm           = bpm;
+	s->mode          = sm;
+
+	for (uint32_t chn = 0; chn < nchans; ++chn) {
+		s->data.push_back (new Sample[out_len]);
+	}
+
+	std::vector<Sample*> out (nchans);
+	samplecnt_t written = 0;
+
+	for (samplecnt_t pos = 0; pos < len; pos += rb_blocksize) {
+		const samplecnt_t n = std::min (rb_blocksize, len - pos);
+		for (uint32_t chn = 0; chn < nchans; ++chn) {
+			in[chn] = (*clip)[chn] + pos;
+		}
+		rb.process (&in[0], n, pos + n >= len);
+
+		int avail;
+		while ((avail = rb.available ()) > 0 && written < out_len) {
+			const samplecnt_t to_read = std::min ((samplecnt_t) avail, out_len - written);
+			for (uint32_t chn = 0; chn < nchans; ++chn) {
+				out[chn] = s->data[chn] + written;
+			}
+			written += rb.retrieve (&out[0], to_read);
+		}
+	}
+
+	s->data.length = written;
+
+	DEBUG_TRACE (DEBUG::Triggers, string_compose ("%1 rendered %2 samples at ratio %3 (%4 bpm)\n", name(), written, ratio, bpm));
+
+	_stretched_all.push_back (s);
+	_stretched.store (s);
+
+	/* Drop older copies, unless the process thread may still use
+	 * one. See ::select_stretched()
+	 */
+
+	Stretched* in_use = _stretched_in_use.load ();
+
+	for (std::vector<Stretched*>::iterator i = _stretched_all.begin(); i != _stretched_all.end(); ) {
+		if (*i != s && *i != in_use) {
+			delete *i;
+			i = _stretched_all.erase (i);
+		} else {
+			++i;
+		}
+	}
+}
+
+void
+AudioTrigger::select_stretched (double bpm)
+{
+	/* This is called from the process thread at the start of each
+	 * pass. Announce the copy we are going to use before using it, and
+	 * check that it is still current, so that the worker never deletes
+	 * it while it may be played.
+	 */
+
+	Stretched* s;
+
+	do {
+		s = _stretched.load ();
+		_stretched_in_use.store (s);
+	} while (s != _stretched.load ());
+
+	if (s && s->matches (data.clip.get(), _segment_tempo, bpm, _stretch_mode)) {
+		_prestretched = s;
+		/* read_index is relative to the start of the original data */
+		read_index = llrint (read_index * s->ratio);
+		return;
+	}
+
+	_prestretched = 0;
+
+	/* stretch in realtime for now, and ask for a copy to use next time */
+
+	if (!data.clip || (_wanted_clip.load () == data.clip.get() && _wanted_tempo.load () == _segment_tempo && _wanted_bpm.load () == bpm && _wanted_mode.load () == _stretch_mode)) {
+		return;
+	}
+
+	/* Nothing is queued: the worker polls the wanted copy of all
+	 * triggers when summoned, see AudioTrigger::render_wanted_stretch()
+	 */
+
+	_wanted_seq.fetch_add (1);
+	_wanted_clip.store (data.clip.get());
+	_wanted_tempo.store (_segment_tempo);
+	_wanted_bpm.store (bpm);
+	_wanted_mode.store (_stretch_mode);
+	_wanted_seq.fetch_add (1);
+
+	TriggerBox::worker->summon ();
+}
+
+void
+AudioTrigger::drop_data ()
+{
 	data.clear ();
+	data.length = 0;
+
+	if (data.clip) {
+		data.clip.reset ();
+		/* the clip may no longer be used by any trigger */
+		AudioClipCache::instance().trim ();
+	}
 }
 
 int
 AudioTrigger::load_data (boost::shared_ptr<AudioRegion> ar)
 {
-	const uint32_t nchans = ar->n_channels();
-
-	data.length = ar->length_samples();
 	drop_data ();
 
-	try {
-		for (uint32_t n = 0; n < nchans; ++n) {
-			data.push_back (new Sample[data.length]);
-			ar->read (data[n], 0, data.length, n);
-		}
-
-		set_name (ar->name());
+	AudioClipCache::ClipPtr clip = AudioClipCache::instance().get (ar, _box.session().sample_rate());
 
-	} catch (...) {
-		drop_data ();
+	if (!clip) {
 		return -1;
 	}
 
+	data.clip   = clip;
+	data.length = clip->length;
+	data.assign (clip->begin(), clip->end());
+
+	set_name (ar->name());
+
 	return 0;
 }
 
@@ -1792,6 +1996,7 @@ AudioTrigger::retrigger ()
 	read_index = _start_offset + _legato_offset;
 	retrieved = 0;
 	_legato_offset = 0; /* used one time only */
+	_select_stretched = true;
 
 	DEBUG_TRACE (DEBUG::Triggers, string_compose ("%1 retriggered to %2\n", _index, read_index));
 }
@@ -1831,6 +2036,28 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 		break;
 	}
 
+	if (_select_stretched) {
+		_select_stretched = false;
+		if (do_stretch) {
+			select_stretched (bpm);
+		} else {
+			_prestretched = 0;
+		}
+	}
+
+	/* A pre-stretched copy is played like unstretched data, until the
+	 * next retrigger (even if the tempo changes meanwhile).
+	 */
+	const bool use_copy = (_prestretched != 0);
+	const bool rt_stretch = do_stretch && !use_copy;
+	samplepos_t last_readable = last_readable_sample;
+
+	if (use_copy) {
+		last_readable = std::min ((samplepos_t) llrint (last_readable_sample * _prestretched->ratio), _prestretched->data.length);
+		last_readable = std::min (last_readable, read_index + std::max ((samplepos_t) 0, final_processed_sample - process_index));
+		last_readable = std::max (last_readable, read_index);
+	}
+
 	/* We use session scratch buffers for both padding the start of the
 	 * input to RubberBand, and to hold the output. Because of this dual
 	 * purpose, we use a generic variable name ('bufp') to refer to them.
@@ -1853,7 +2080,7 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 
 	/* tell the stretcher what we are doing for this ::run() call */
 
-	if (do_stretch && !_playout) {
+	if (rt_stretch && !_playout) {
 
 		const double stretch = _segment_tempo / bpm;
 		_stretcher->setTimeRatio (stretch);
@@ -1905,7 +2132,7 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 		pframes_t to_stretcher;
 		pframes_t from_stretcher;
 
-		if (do_stretch) {
+		if (rt_stretch) {
 
 			if (read_index < last_readable_sample) {
 
@@ -1995,8 +2222,8 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 			}
 
 		} else {
-			/* no stretch */
-			from_stretcher = (pframes_t) std::min ((samplecnt_t) nframes, (last_readable_sample - read_index));
+			/* no stretch, or pre-stretched */
+			from_stretcher = (pframes_t) std::min ((samplecnt_t) nframes, (last_readable - read_index));
 			// cerr << "FS#3 from lrs " << last_readable_sample <<  " - " << read_index << " = " << from_stretcher << endl;
 
 		}
@@ -2009,9 +2236,15 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 
 			for (uint32_t chn = 0; chn < bufs.count().n_audio(); ++chn) {
 
-				uint32_t channel = chn %  data.size();
 				AudioBuffer& buf (bufs.get_audio (chn));
-				Sample* src = do_stretch ? bufp[channel] : (data[channel] + read_index);
+				Sample* src;
+
+				if (use_copy) {
+					src = _prestretched->data[chn % _prestretched->data.size()] + read_index;
+				} else {
+					uint32_t channel = chn %  data.size();
+					src = rt_stretch ? bufp[channel] : (data[channel] + read_index);
+				}
 
 				gain_t gain = _velocity_gain * _gain;  //incorporate the gain from velocity_effect
 
@@ -2030,7 +2263,7 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 		 * stretcher
 		 */
 
-		if (!do_stretch) {
+		if (!rt_stretch) {
 			read_index += from_stretcher;
 		}
 
@@ -2038,7 +2271,7 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 		avail = _stretcher->available ();
 		dest_offset += from_stretcher;
 
-		if (read_index >= last_readable_sample && (!do_stretch || avail <= 0)) {
+		if (read_index >= last_readable && (!rt_stretch || avail <= 0)) {
 
 			if (process_index < final_processed_sample) {
 				DEBUG_TRACE (DEBUG::Triggers, string_compose ("%1 reached end, entering playout mode to cover %2 .. %3\n", index(), process_index, final_processed_sample));
@@ -4407,6 +4640,8 @@ TriggerBoxThread::thread_work ()
 				}
 				delete req; /* back to pool */
 			}
+
+			render_stretched ();
 		}
 	}
 
@@ -4469,6 +4704,53 @@ TriggerBoxThread::request_delete_trigger (Trigger* t)
 	queue_request (req);
 }
 
+void
+TriggerBoxThread::summon ()
+{
+	/* Only wake up the worker, there is no request in the FIFO.
+	 * This does not allocate or lock and can be called from any
+	 * process thread.
+	 */
+	char c = (char) Render;
+	_xthread.deliver (c);
+}
+
+void
+TriggerBoxThread::add_audio_trigger (AudioTrigger* t)
+{
+	Glib::Threads::Mutex::Lock lm (_audio_triggers_lock);
+	_audio_triggers.push_back (t);
+}
+
+void
+TriggerBoxThread::remove_audio_trigger (AudioTrigger* t)
+{
+	Glib::Threads::Mutex::Lock lm (_audio_triggers_lock);
+	std::vector<AudioTrigger*>::iterator i = std::find (_audio_triggers.begin(), _audio_triggers.end(), t);
+	if (i != _audio_triggers.end()) {
+		_audio_triggers.erase (i);
+	}
+}
+
+void
+TriggerBoxThread::render_stretched ()
+{
+	std::vector<AudioTrigger*> triggers;
+
+	{
+		Glib::Threads::Mutex::Lock lm (_audio_triggers_lock);
+		triggers = _audio_triggers;
+	}
+
+	/* Rendering can take a while, so do not hold the lock. Triggers
+	 * are only deleted by this thread (see ::delete_trigger()), so
+	 * none of them can go away meanwhile.
+	 */
+	for (std::vector<AudioTrigger*>::iterator t = triggers.begin(); t != triggers.end(); ++t) {
+		(*t)->render_wanted_stretch ();
+	}
+}
+
 void
 TriggerBoxThread::delete_trigger (Trigger* t)
 {
@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "ardour/mix.h"
+
+#include <immintrin.h>
+#include <xmmintrin.h>
+
+#ifndef __AVX__
+#error "__AVX__ must be enabled for this module to work"
+#endif
+
+/* Unlike the functions in sse_functions_avx*.cc, these are used for
+ * buffers that are not allocated by Ardour (backend and file I/O),
+ * and which are usually not aligned. Unaligned loads and stores are
+ * used throughout, they are no slower than aligned ones on any CPU
+ * that supports AVX, when the data happens to be aligned.
+ */
+
+/**
+ * @brief x86-64 AVX optimized routine for applying a linear gain ramp
+ * @param[in,out] buf Pointer to buffer, which gets updated
+ * @param nframes Number of samples to process
+ * @param gain_start Gain of the first sample
+ * @param gain_end Gain of the sample following the last one
+ */
+void
+x86_avx_apply_gain_ramp (float* buf, uint32_t nframes, float gain_start, float gain_end)
+{
+	if (nframes == 0) {
+		return;
+	}
+
+	const float delta = (gain_end - gain_start) / (float)nframes;
+
+	const __m256 vg0   = _mm256_set1_ps (gain_start);
+	const __m256 vdt   = _mm256_set1_ps (delta);
+	const __m256 vidx  = _mm256_setr_ps (0, 1, 2, 3, 4, 5, 6, 7);
+
+	uint32_t i = 0;
+
+	while (i + 8 <= nframes) {
+		/* gain = gain_start + delta * n, same order of operations as default_apply_gain_ramp */
+		__m256 n = _mm256_add_ps (vidx, _mm256_set1_ps ((float)i));
+		__m256 g = _mm256_add_ps (vg0, _mm256_mul_ps (vdt, n));
+		__m256 x = _mm256_loadu_ps (buf + i);
+		_mm256_storeu_ps (buf + i, _mm256_mul_ps (x, g));
+		i += 8;
+	}
+
+	_mm256_zeroupper ();
+
+	for (; i < nframes; ++i) {
+		buf[i] *= gain_start + delta * (float)i;
+	}
+}
+
+/**
+ * @brief x86-64 AVX optimized routine to copy a mono buffer to one channel of an interleaved buffer
+ * @param[in,out] dst Pointer to interleaved destination buffer
+ * @param[in] src Pointer to mono source buffer
+ * @param nframes Number of frames to process
+ * @param channel Channel to write to
+ * @param n_channels Channel count of the interleaved buffer
+ */
+void
+x86_avx_interleave (float* dst, float const* src, uint32_t nframes, uint32_t channel, uint32_t n_channels)
+{
+	if (n_channels == 1) {
+		x86_sse_avx_copy_vector (dst, src, nframes);
+		return;
+	}
+
+	if (n_channels != 2) {
+		/* there is no AVX scatter, use the plain C loop */
+		default_interleave (dst, src, nframes, channel, n_channels);
+		return;
+	}
+
+	/* stereo, read 4 frames (8 floats) of the interleaved buffer
+	 * and replace every other sample.
+	 */
+	uint32_t i = 0;
+
+	while (i + 4 <= nframes) {
+		__m128 s  = _mm_loadu_ps (src + i);
+		__m128 lo = _mm_unpacklo_ps (s, s); // s0 s0 s1 s1
+		__m128 hi = _mm_unpackhi_ps (s, s); // s2 s2 s3 s3
+		__m256 ss = _mm256_insertf128_ps (_mm256_castps128_ps256 (lo), hi, 1);
+		__m256 d  = _mm256_loadu_ps (dst + 2 * i);
+		if (channel == 0) {
+			d = _mm256_blend_ps (d, ss, 0x55);
+		} else {
+			d = _mm256_blend_ps (d, ss, 0xaa);
+		}
+		_mm256_storeu_ps (dst + 2 * i, d);
+		i += 4;
+	}
+
+	_mm256_zeroupper ();
+
+	for (; i < nframes; ++i) {
+		dst[2 * i + channel] = src[i];
+	}
+}
+
+/**
+ * @brief x86-64 AVX optimized routine to copy one channel of an interleaved buffer to a mono buffer
+ * @param[out] dst Pointer to mono destination buffer
+ * @param[in] src Pointer to interleaved source buffer
+ * @param nframes Number of frames to process
+ * @param channel Channel to read
+ * @param n_channels Channel count of the interleaved buffer
+ */
+void
+x86_avx_deinterleave (float* dst, float const* src, uint32_t nframes, uint32_t channel, uint32_t n_channels)
+{
+	if (n_channels == 1) {
+		x86_sse_avx_copy_vector (dst, src, nframes);
+		return;
+	}
+
+	if (n_channels != 2) {
+		/* there is no AVX gather, use the plain C loop */
+		default_deinterleave (dst, src, nframes, channel, n_channels);
+		return;
+	}
+
+	uint32_t i = 0;
+
+	while (i + 8 <= nframes) {
+		__m256 a = _mm256_loadu_ps (src + 2 * i);     // L0 R0 L1 R1 | L2 R2 L3 R3
+		__m256 b = _mm256_loadu_ps (src + 2 * i + 8); // L4 R4 L5 R5 | L6 R6 L7 R7
+		__m256 c;
+		if (channel == 0) {
+			c = _mm256_shuffle_ps (a, b, _MM_SHUFFLE (2, 0, 2, 0)); // L0 L1 L4 L5 | L2 L3 L6 L7
+		} else {
+			c = _mm256_shuffle_ps (a, b, _MM_SHUFFLE (3, 1, 3, 1));
+		}
+		__m128 lo = _mm256_castps256_ps128 (c);
+		__m128 hi = _mm256_extractf128_ps (c, 1);
+		_mm_storeu_ps (dst + i, _mm_movelh_ps (lo, hi));     // L0 L1 L2 L3
+		_mm_storeu_ps (dst + i + 4, _mm_movehl_ps (hi, lo)); // L4 L5 L6 L7
+		i += 8;
+	}
+
+	_mm256_zeroupper ();
+
+	for (; i < nframes; ++i) {
+		dst[i] = src[2 * i + channel];
+	}
+}
+
+/**
+ * @brief x86-64 AVX optimized routine to convert float to 24bit integer, MSB aligned in 32bit
+ * @param[out] dst Pointer to integer destination buffer
+ * @param[in] src Pointer to source buffer
+ * @param nframes Number of samples to process
+ */
+void
+x86_avx_float_to_s32 (int32_t* dst, float const* src, uint32_t nframes)
+{
+	const __m256 vmin   = _mm256_set1_ps (-1.f);
+	const __m256 vmax   = _mm256_set1_ps (1.f);
+	const __m256 vscale = _mm256_set1_ps (8388607.f);
+
+	uint32_t i = 0;
+
+	while (i + 8 <= nframes) {
+		__m256  x = _mm256_loadu_ps (src + i);
+		x         = _mm256_min_ps (vmax, _mm256_max_ps (vmin, x));
+		__m256i n = _mm256_cvttps_epi32 (_mm256_mul_ps (x, vscale));
+		/* AVX lacks 256bit integer shifts, use SSE2 on each half */
+		__m128i lo = _mm_slli_epi32 (_mm256_castsi256_si128 (n), 8);
+		__m128i hi = _mm_slli_epi32 (_mm256_extractf128_si256 (n, 1), 8);
+		_mm_storeu_si128 ((__m128i*)(dst + i), lo);
+		_mm_storeu_si128 ((__m128i*)(dst + i + 4), hi);
+		i += 8;
+	}
+
+	_mm256_zeroupper ();
+
+	if (i < nframes) {
+		default_float_to_s32 (dst + i, src + i, nframes - i);
+	}
+}
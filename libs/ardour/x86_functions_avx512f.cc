@@ -0,0 +1,453 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifdef FPU_AVX512F_SUPPORT
+
+#include "ardour/mix.h"
+
+#include <immintrin.h>
+
+#ifndef __AVX512F__
+#error "__AVX512F__ must be enabled for this module to work"
+#endif
+
+/* AVX-512 provides per-lane masks for loads and stores. Instead of
+ * handling unaligned heads and tails one sample at a time, the last
+ * (nframes % 16) samples are processed using a masked operation.
+ *
+ * Unaligned loads and stores are used throughout. When data is
+ * aligned (as is the case for Ardour's buffers) they perform the same
+ * as aligned access.
+ */
+
+static inline __mmask16
+tail_mask (uint32_t n)
+{
+	return (__mmask16)((1u << n) - 1);
+}
+
+static inline void
+zero_upper ()
+{
+	/* There's a penalty going from AVX mode to SSE mode. This can
+	 * be avoided by ensuring the CPU that rest of the routine is no
+	 * longer interested in the upper portion of the vector registers.
+	 */
+	_mm256_zeroupper ();
+}
+
+/**
+ * @brief x86-64 AVX-512 optimized routine for compute peak procedure
+ * @param src Pointer to source buffer
+ * @param nframes Number of frames to process
+ * @param current Current peak value
+ * @return float New peak value
+ */
+float
+x86_avx512f_compute_peak (float const* src, uint32_t nframes, float current)
+{
+	__m512 vmax = _mm512_set1_ps (current);
+
+	while (nframes >= 64) {
+		__m512 t0 = _mm512_abs_ps (_mm512_loadu_ps (src + 0));
+		__m512 t1 = _mm512_abs_ps (_mm512_loadu_ps (src + 16));
+		__m512 t2 = _mm512_abs_ps (_mm512_loadu_ps (src + 32));
+		__m512 t3 = _mm512_abs_ps (_mm512_loadu_ps (src + 48));
+
+		vmax = _mm512_max_ps (vmax, _mm512_max_ps (_mm512_max_ps (t0, t1), _mm512_max_ps (t2, t3)));
+
+		src += 64;
+		nframes -= 64;
+	}
+
+	while (nframes >= 16) {
+		vmax = _mm512_max_ps (vmax, _mm512_abs_ps (_mm512_loadu_ps (src)));
+		src += 16;
+		nframes -= 16;
+	}
+
+	if (nframes > 0) {
+		/* masked out lanes are zero, which does not affect the peak */
+		__m512 t = _mm512_maskz_loadu_ps (tail_mask (nframes), src);
+		vmax     = _mm512_max_ps (vmax, _mm512_abs_ps (t));
+	}
+
+	current = _mm512_reduce_max_ps (vmax);
+	zero_upper ();
+	return current;
+}
+
+/**
+ * @brief x86-64 AVX-512 optimized routine for find peak procedure
+ * @param src Pointer to source buffer
+ * @param nframes Number of frames to process
+ * @param[in,out] minf Current minimum value, updated
+ * @param[in,out] maxf Current maximum value, updated
+ */
+void
+x86_avx512f_find_peaks (float const* src, uint32_t nframes, float* minf, float* maxf)
+{
+	__m512 vmin = _mm512_set1_ps (*minf);
+	__m512 vmax = _mm512_set1_ps (*maxf);
+
+	while (nframes >= 32) {
+		__m512 t0 = _mm512_loadu_ps (src + 0);
+		__m512 t1 = _mm512_loadu_ps (src + 16);
+
+		vmin = _mm512_min_ps (vmin, _mm512_min_ps (t0, t1));
+		vmax = _mm512_max_ps (vmax, _mm512_max_ps (t0, t1));
+
+		src += 32;
+		nframes -= 32;
+	}
+
+	while (nframes >= 16) {
+		__m512 t = _mm512_loadu_ps (src);
+		vmin     = _mm512_min_ps (vmin, t);
+		vmax     = _mm512_max_ps (vmax, t);
+		src += 16;
+		nframes -= 16;
+	}
+
+	if (nframes > 0) {
+		/* masked out lanes keep the current min/max */
+		const __mmask16 k = tail_mask (nframes);
+		vmin = _mm512_min_ps (vmin, _mm512_mask_loadu_ps (vmin, k, src));
+		vmax = _mm512_max_ps (vmax, _mm512_mask_loadu_ps (vmax, k, src));
+	}
+
+	*minf = _mm512_reduce_min_ps (vmin);
+	*maxf = _mm512_reduce_max_ps (vmax);
+	zero_upper ();
+}
+
+/**
+ * @brief x86-64 AVX-512 optimized routine for apply gain routine
+ * @param[in,out] dst Pointer to the destination buffer, which gets updated
+ * @param nframes Number of frames (or samples) to process
+ * @param gain Gain to apply
+ */
+void
+x86_avx512f_apply_gain_to_buffer (float* dst, uint32_t nframes, float gain)
+{
+	const __m512 vg = _mm512_set1_ps (gain);
+
+	while (nframes >= 32) {
+		__m512 t0 = _mm512_loadu_ps (dst + 0);
+		__m512 t1 = _mm512_loadu_ps (dst + 16);
+		_mm512_storeu_ps (dst + 0, _mm512_mul_ps (vg, t0));
+		_mm512_storeu_ps (dst + 16, _mm512_mul_ps (vg, t1));
+		dst += 32;
+		nframes -= 32;
+	}
+
+	while (nframes >= 16) {
+		_mm512_storeu_ps (dst, _mm512_mul_ps (vg, _mm512_loadu_ps (dst)));
+		dst += 16;
+		nframes -= 16;
+	}
+
+	if (nframes > 0) {
+		const __mmask16 k = tail_mask (nframes);
+		__m512 t = _mm512_maskz_loadu_ps (k, dst);
+		_mm512_mask_storeu_ps (dst, k, _mm512_mul_ps (vg, t));
+	}
+
+	zero_upper ();
+}
+
+/**
+ * @brief x86-64 AVX-512 optimized routine for mixing buffer with gain.
+ *
+ * AVX-512F includes fused multiply-add.
+ *
+ * @param[in,out] dst Pointer to destination buffer, which gets updated
+ * @param[in] src Pointer to source buffer (not updated)
+ * @param nframes Number of samples to process
+ * @param gain Gain to apply
+ */
+void
+x86_avx512f_mix_buffers_with_gain (float* dst, float const* src, uint32_t nframes, float gain)
+{
+	const __m512 vg = _mm512_set1_ps (gain);
+
+	while (nframes >= 32) {
+		__m512 s0 = _mm512_loadu_ps (src + 0);
+		__m512 s1 = _mm512_loadu_ps (src + 16);
+		__m512 d0 = _mm512_loadu_ps (dst + 0);
+		__m512 d1 = _mm512_loadu_ps (dst + 16);
+		_mm512_storeu_ps (dst + 0, _mm512_fmadd_ps (vg, s0, d0));
+		_mm512_storeu_ps (dst + 16, _mm512_fmadd_ps (vg, s1, d1));
+		src += 32;
+		dst += 32;
+		nframes -= 32;
+	}
+
+	while (nframes >= 16) {
+		__m512 s0 = _mm512_loadu_ps (src);
+		__m512 d0 = _mm512_loadu_ps (dst);
+		_mm512_storeu_ps (dst, _mm512_fmadd_ps (vg, s0, d0));
+		src += 16;
+		dst += 16;
+		nframes -= 16;
+	}
+
+	if (nframes > 0) {
+		const __mmask16 k = tail_mask (nframes);
+		__m512 s0 = _mm512_maskz_loadu_ps (k, src);
+		__m512 d0 = _mm512_maskz_loadu_ps (k, dst);
+		_mm512_mask_storeu_ps (dst, k, _mm512_fmadd_ps (vg, s0, d0));
+	}
+
+	zero_upper ();
+}
+
+/**
+ * @brief x86-64 AVX-512 optimized routine for mixing buffer with no gain.
+ * @param[in,out] dst Pointer to destination buffer, which gets updated
+ * @param[in] src Pointer to source buffer (not updated)
+ * @param nframes Number of samples to process
+ */
+void
+x86_avx512f_mix_buffers_no_gain (float* dst, float const* src, uint32_t nframes)
+{
+	while (nframes >= 32) {
+		__m512 s0 = _mm512_loadu_ps (src + 0);
+		__m512 s1 = _mm512_loadu_ps (src + 16);
+		__m512 d0 = _mm512_loadu_ps (dst + 0);
+		__m512 d1 = _mm512_loadu_ps (dst + 16);
+		_mm512_storeu_ps (dst + 0, _mm512_add_ps (d0, s0));
+		_mm512_storeu_ps (dst + 16, _mm512_add_ps (d1, s1));
+		src += 32;
+		dst += 32;
+		nframes -= 32;
+	}
+
+	while (nframes >= 16) {
+		_mm512_storeu_ps (dst, _mm512_add_ps (_mm512_loadu_ps (dst), _mm512_loadu_ps (src)));
+		src += 16;
+		dst += 16;
+		nframes -= 16;
+	}
+
+	if (nframes > 0) {
+		const __mmask16 k = tail_mask (nframes);
+		__m512 s0 = _mm512_maskz_loadu_ps (k, src);
+		__m512 d0 = _mm512_maskz_loadu_ps (k, dst);
+		_mm512_mask_storeu_ps (dst, k, _mm512_add_ps (d0, s0));
+	}
+
+	zero_upper ();
+}
+
+/**
+ * @brief Copy vector from one location to another
+ * @param[out] dst Pointer to destination buffer
+ * @param[in] src Pointer to source buffer
+ * @param nframes Number of samples to copy
+ */
+void
+x86_avx512f_copy_vector (float* dst, float const* src, uint32_t nframes)
+{
+	while (nframes >= 32) {
+		__m512 s0 = _mm512_loadu_ps (src + 0);
+		__m512 s1 = _mm512_loadu_ps (src + 16);
+		_mm512_storeu_ps (dst + 0, s0);
+		_mm512_storeu_ps (dst + 16, s1);
+		src += 32;
+		dst += 32;
+		nframes -= 32;
+	}
+
+	while (nframes >= 16) {
+		_mm512_storeu_ps (dst, _mm512_loadu_ps (src));
+		src += 16;
+		dst += 16;
+		nframes -= 16;
+	}
+
+	if (nframes > 0) {
+		const __mmask16 k = tail_mask (nframes);
+		_mm512_mask_storeu_ps (dst, k, _mm512_maskz_loadu_ps (k, src));
+	}
+
+	zero_upper ();
+}
+
+/**
+ * @brief x86-64 AVX-512 optimized routine for applying a linear gain ramp
+ * @param[in,out] buf Pointer to buffer, which gets updated
+ * @param nframes Number of samples to process
+ * @param gain_start Gain of the first sample
+ * @param gain_end Gain of the sample following the last one
+ */
+void
+x86_avx512f_apply_gain_ramp (float* buf, uint32_t nframes, float gain_start, float gain_end)
+{
+	if (nframes == 0) {
+		return;
+	}
+
+	const float  delta = (gain_end - gain_start) / (float)nframes;
+	const __m512 vg0   = _mm512_set1_ps (gain_start);
+	const __m512 vdt   = _mm512_set1_ps (delta);
+	const __m512 vinc  = _mm512_set1_ps (16.f);
+
+	__m512 n = _mm512_setr_ps (0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+	while (nframes >= 16) {
+		__m512 g = _mm512_fmadd_ps (vdt, n, vg0);
+		_mm512_storeu_ps (buf, _mm512_mul_ps (_mm512_loadu_ps (buf), g));
+		n = _mm512_add_ps (n, vinc);
+		buf += 16;
+		nframes -= 16;
+	}
+
+	if (nframes > 0) {
+		const __mmask16 k = tail_mask (nframes);
+		__m512 g = _mm512_fmadd_ps (vdt, n, vg0);
+		__m512 t = _mm512_maskz_loadu_ps (k, buf);
+		_mm512_mask_storeu_ps (buf, k, _mm512_mul_ps (t, g));
+	}
+
+	zero_upper ();
+}
+
+/**
+ * @brief x86-64 AVX-512 optimized routine to copy a mono buffer to one channel of an interleaved buffer
+ * @param[in,out] dst Pointer to interleaved destination buffer
+ * @param[in] src Pointer to mono source buffer
+ * @param nframes Number of frames to process
+ * @param channel Channel to write to
+ * @param n_channels Channel count of the interleaved buffer
+ */
+void
+x86_avx512f_interleave (float* dst, float const* src, uint32_t nframes, uint32_t channel, uint32_t n_channels)
+{
+	if (n_channels == 1) {
+		x86_avx512f_copy_vector (dst, src, nframes);
+		return;
+	}
+
+	const __m512i vidx = _mm512_mullo_epi32 (_mm512_setr_epi32 (0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), _mm512_set1_epi32 (n_channels));
+
+	dst += channel;
+
+	while (nframes >= 16) {
+		_mm512_i32scatter_ps (dst, vidx, _mm512_loadu_ps (src), 4);
+		src += 16;
+		dst += 16 * n_channels;
+		nframes -= 16;
+	}
+
+	if (nframes > 0) {
+		const __mmask16 k = tail_mask (nframes);
+		_mm512_mask_i32scatter_ps (dst, k, vidx, _mm512_maskz_loadu_ps (k, src), 4);
+	}
+
+	zero_upper ();
+}
+
+/**
+ * @brief x86-64 AVX-512 optimized routine to copy one channel of an interleaved buffer to a mono buffer
+ * @param[out] dst Pointer to mono destination buffer
+ * @param[in] src Pointer to interleaved source buffer
+ * @param nframes Number of frames to process
+ * @param channel Channel to read
+ * @param n_channels Channel count of the interleaved buffer
+ */
+void
+x86_avx512f_deinterleave (float* dst, float const* src, uint32_t nframes, uint32_t channel, uint32_t n_channels)
+{
+	if (n_channels == 1) {
+		x86_avx512f_copy_vector (dst, src, nframes);
+		return;
+	}
+
+	src += channel;
+
+	if (n_channels == 2) {
+		/* a two-source permute is faster than a gather */
+		const __m512i vidx = _mm512_setr_epi32 (0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+		while (nframes >= 16) {
+			/* for channel 1, the last sample is not part of the permute, do not read past the end */
+			if (channel == 1 && nframes == 16) {
+				break;
+			}
+			__m512 a = _mm512_loadu_ps (src);
+			__m512 b = _mm512_loadu_ps (src + 16);
+			_mm512_storeu_ps (dst, _mm512_permutex2var_ps (a, vidx, b));
+			src += 32;
+			dst += 16;
+			nframes -= 16;
+		}
+	}
+
+	const __m512i vidx = _mm512_mullo_epi32 (_mm512_setr_epi32 (0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), _mm512_set1_epi32 (n_channels));
+
+	while (nframes >= 16) {
+		_mm512_storeu_ps (dst, _mm512_i32gather_ps (vidx, src, 4));
+		src += 16 * n_channels;
+		dst += 16;
+		nframes -= 16;
+	}
+
+	if (nframes > 0) {
+		const __mmask16 k = tail_mask (nframes);
+		__m512 t = _mm512_mask_i32gather_ps (_mm512_setzero_ps (), k, vidx, src, 4);
+		_mm512_mask_storeu_ps (dst, k, t);
+	}
+
+	zero_upper ();
+}
+
+/**
+ * @brief x86-64 AVX-512 optimized routine to convert float to 24bit integer, MSB aligned in 32bit
+ * @param[out] dst Pointer to integer destination buffer
+ * @param[in] src Pointer to source buffer
+ * @param nframes Number of samples to process
+ */
+void
+x86_avx512f_float_to_s32 (int32_t* dst, float const* src, uint32_t nframes)
+{
+	const __m512 vmin   = _mm512_set1_ps (-1.f);
+	const __m512 vmax   = _mm512_set1_ps (1.f);
+	const __m512 vscale = _mm512_set1_ps (8388607.f);
+
+	while (nframes >= 16) {
+		__m512  x = _mm512_loadu_ps (src);
+		x         = _mm512_min_ps (vmax, _mm512_max_ps (vmin, x));
+		__m512i n = _mm512_cvttps_epi32 (_mm512_mul_ps (x, vscale));
+		_mm512_storeu_si512 (dst, _mm512_slli_epi32 (n, 8));
+		src += 16;
+		dst += 16;
+		nframes -= 16;
+	}
+
+	if (nframes > 0) {
+		const __mmask16 k = tail_mask (nframes);
+		__m512  x = _mm512_maskz_loadu_ps (k, src);
+		x         = _mm512_min_ps (vmax, _mm512_max_ps (vmin, x));
+		__m512i n = _mm512_cvttps_epi32 (_mm512_mul_ps (x, vscale));
+		_mm512_mask_storeu_epi32 (dst, k, _mm512_slli_epi32 (n, 8));
+	}
+
+	zero_upper ();
+}
+
+#endif // FPU_AVX512F_SUPPORT
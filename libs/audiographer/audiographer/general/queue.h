@@ -0,0 +1,206 @@
+#ifndef AUDIOGRAPHER_QUEUE_H
+#define AUDIOGRAPHER_QUEUE_H
+
+#include <pthread.h>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include "pbd/g_atomic_compat.h"
+#include "pbd/pthread_utils.h"
+#include "pbd/semutils.h"
+
+#include "audiographer/visibility.h"
+#include "audiographer/exception.h"
+#include "audiographer/flag_debuggable.h"
+#include "audiographer/sink.h"
+#include "audiographer/type_utils.h"
+#include "audiographer/utils/listed_source.h"
+
+namespace AudioGrapher
+{
+
+/** A vertex that passes data on to its outputs from a thread of its own,
+  * so that the outputs run concurrently with whatever feeds the queue,
+  * and with the outputs of other queues.
+  *
+  * Data is copied into one of a fixed number of buffers, which the thread
+  * processes in order. Buffers are handed over without locking, two
+  * semaphores count the free and the filled ones.
+  *
+  * process() blocks while all buffers are in use, so that a slow output
+  * holds back its source instead of queueing without bound, and at
+  * EndOfInput until the thread has processed everything. Exceptions
+  * thrown by the outputs are re-thrown by the next call to process().
+  */
+template <typename T = DefaultSampleType>
+class /*LIBAUDIOGRAPHER_API*/ Queue
+  : public ListedSource<T>
+  , public Sink<T>
+  , public FlagDebuggable<>
+{
+  public:
+	/** Constructor
+	  * \n NOT RT safe
+	  * \param max_samples expected maximum context size, larger contexts reallocate a buffer
+	  * \param n_buffers number of contexts which can be queued
+	  */
+	Queue (samplecnt_t max_samples, unsigned int n_buffers = 4)
+		: _buffers (n_buffers)
+		, _free ("audiographer queue free", n_buffers)
+		, _filled ("audiographer queue filled", 0)
+		, _write (0)
+		, _read (0)
+	{
+		add_supported_flag (ProcessContext<T>::EndOfInput);
+
+		g_atomic_int_set (&_quit, 0);
+		g_atomic_int_set (&_failed, 0);
+
+		for (typename std::vector<Buffer>::iterator i = _buffers.begin(); i != _buffers.end(); ++i) {
+			i->data     = new T[max_samples];
+			i->capacity = max_samples;
+		}
+
+		if (pthread_create (&_thread_id, NULL, _thread, this)) {
+			free_buffers ();
+			throw Exception (*this, "Cannot create export queue thread");
+		}
+	}
+
+	~Queue ()
+	{
+		/* anything still queued is dropped */
+		g_atomic_int_set (&_quit, 1);
+		_filled.signal ();
+		pthread_join (_thread_id, NULL);
+		free_buffers ();
+	}
+
+	/** Queue a copy of \a c, to be passed on by the thread
+	  * \n Not RT safe, blocks while the queue is full.
+	  */
+	void process (ProcessContext<T> const & c)
+	{
+		check_flags (*this, c);
+		rethrow ();
+
+		_free.wait ();
+
+		Buffer& b = _buffers[_write];
+		_write = (_write + 1) % _buffers.size ();
+
+		if (c.samples() > b.capacity) {
+			delete [] b.data;
+			b.data     = new T[c.samples()];
+			b.capacity = c.samples();
+		}
+
+		TypeUtils<T>::copy (c.data(), b.data, c.samples());
+		b.samples      = c.samples();
+		b.channels     = c.channels();
+		b.end_of_input = c.has_flag (ProcessContext<T>::EndOfInput);
+
+		_filled.signal ();
+
+		if (b.end_of_input) {
+			drain ();
+			rethrow ();
+		}
+	}
+
+	using Sink<T>::process;
+
+	/** Wait until everything that has been queued so far is processed.
+	  * Must not be called concurrently with process().
+	  */
+	void drain ()
+	{
+		for (size_t n = 0; n < _buffers.size (); ++n) {
+			_free.wait ();
+		}
+		for (size_t n = 0; n < _buffers.size (); ++n) {
+			_free.signal ();
+		}
+	}
+
+  private:
+	struct Buffer {
+		Buffer () : data (0), capacity (0), samples (0), channels (1), end_of_input (false) {}
+
+		T*           data;
+		samplecnt_t  capacity;
+		samplecnt_t  samples;
+		ChannelCount channels;
+		bool         end_of_input;
+	};
+
+	static void* _thread (void* arg)
+	{
+		pthread_set_name ("ExportQueue");
+		static_cast<Queue*> (arg)->run ();
+		return 0;
+	}
+
+	void run ()
+	{
+		while (true) {
+			_filled.wait ();
+
+			if (g_atomic_int_get (&_quit)) {
+				break;
+			}
+
+			Buffer& b = _buffers[_read];
+			_read = (_read + 1) % _buffers.size ();
+
+			/* after a failure, keep consuming so that process() does not block */
+			if (!g_atomic_int_get (&_failed)) {
+				try {
+					ProcessContext<T> c (b.data, b.samples, b.channels);
+					if (b.end_of_input) {
+						c.set_flag (ProcessContext<T>::EndOfInput);
+					}
+					ListedSource<T>::output (c);
+				} catch (std::exception const & e) {
+					_exception.reset (new Exception (*this, e.what ()));
+					g_atomic_int_set (&_failed, 1);
+				}
+			}
+
+			_free.signal ();
+		}
+	}
+
+	void rethrow ()
+	{
+		if (g_atomic_int_get (&_failed)) {
+			throw *_exception;
+		}
+	}
+
+	void free_buffers ()
+	{
+		for (typename std::vector<Buffer>::iterator i = _buffers.begin(); i != _buffers.end(); ++i) {
+			delete [] i->data;
+			i->data = 0;
+		}
+	}
+
+	std::vector<Buffer> _buffers;
+
+	PBD::Semaphore _free;
+	PBD::Semaphore _filled;
+	size_t         _write; ///< next buffer to fill, only used by process()
+	size_t         _read;  ///< next buffer to output, only used by the thread
+
+	pthread_t         _thread_id;
+	GATOMIC_QUAL gint _quit;
+	GATOMIC_QUAL gint _failed;
+
+	boost::shared_ptr<Exception> _exception;
+};
+
+} // namespace
+
+#endif // AUDIOGRAPHER_QUEUE_H
@@ -0,0 +1,135 @@
+#include "tests/utils.h"
+
+#include "audiographer/general/queue.h"
+
+using namespace AudioGrapher;
+
+template<typename T>
+class EndOfInputSink : public AudioGrapher::Sink<T>
+{
+  public:
+	EndOfInputSink () : count (0) {}
+
+	void process (AudioGrapher::ProcessContext<T> const & c)
+	{
+		if (c.has_flag (AudioGrapher::ProcessContext<T>::EndOfInput)) {
+			++count;
+		}
+	}
+	using AudioGrapher::Sink<T>::process;
+
+	int count;
+};
+
+class QueueTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE (QueueTest);
+  CPPUNIT_TEST (testProcess);
+  CPPUNIT_TEST (testOrder);
+  CPPUNIT_TEST (testLargeContext);
+  CPPUNIT_TEST (testEndOfInput);
+  CPPUNIT_TEST (testExceptions);
+  CPPUNIT_TEST_SUITE_END ();
+
+  public:
+	void setUp()
+	{
+		samples = 128;
+		random_data = TestUtils::init_random_data (samples, 1.0);
+		queue.reset (new Queue<float> (samples, 2));
+		sink_a.reset (new AppendingVectorSink<float>());
+		sink_b.reset (new AppendingVectorSink<float>());
+	}
+
+	void tearDown()
+	{
+		delete [] random_data;
+		queue.reset ();
+	}
+
+	void testProcess()
+	{
+		queue->add_output (sink_a);
+		queue->add_output (sink_b);
+
+		ProcessContext<float> c (random_data, samples, 1);
+		c.set_flag (ProcessContext<float>::EndOfInput);
+		queue->process (c);
+
+		/* EndOfInput waits for the queue to be processed */
+		CPPUNIT_ASSERT_EQUAL (samples, (samplecnt_t) sink_a->get_data().size());
+		CPPUNIT_ASSERT_EQUAL (samples, (samplecnt_t) sink_b->get_data().size());
+		CPPUNIT_ASSERT (TestUtils::array_equals (random_data, sink_a->get_array(), samples));
+		CPPUNIT_ASSERT (TestUtils::array_equals (random_data, sink_b->get_array(), samples));
+	}
+
+	void testOrder()
+	{
+		queue->add_output (sink_a);
+
+		/* more contexts than buffers, process() has to wait for the thread */
+		samplecnt_t const chunk = 16;
+		for (samplecnt_t pos = 0; pos < samples; pos += chunk) {
+			ProcessContext<float> c (&random_data[pos], chunk, 1);
+			queue->process (c);
+		}
+		queue->drain ();
+
+		CPPUNIT_ASSERT_EQUAL (samples, (samplecnt_t) sink_a->get_data().size());
+		CPPUNIT_ASSERT (TestUtils::array_equals (random_data, sink_a->get_array(), samples));
+	}
+
+	void testLargeContext()
+	{
+		queue.reset (new Queue<float> (samples / 4, 2));
+		queue->add_output (sink_a);
+
+		ProcessContext<float> c (random_data, samples, 1);
+		queue->process (c);
+		queue->drain ();
+
+		CPPUNIT_ASSERT_EQUAL (samples, (samplecnt_t) sink_a->get_data().size());
+		CPPUNIT_ASSERT (TestUtils::array_equals (random_data, sink_a->get_array(), samples));
+	}
+
+	void testEndOfInput()
+	{
+		boost::shared_ptr<EndOfInputSink<float> > eoi_sink (new EndOfInputSink<float>());
+		queue->add_output (eoi_sink);
+
+		ProcessContext<float> c (random_data, samples, 1);
+		queue->process (c);
+		queue->drain ();
+		CPPUNIT_ASSERT_EQUAL (0, eoi_sink->count);
+
+		c.set_flag (ProcessContext<float>::EndOfInput);
+		queue->process (c);
+		CPPUNIT_ASSERT_EQUAL (1, eoi_sink->count);
+	}
+
+	void testExceptions()
+	{
+		boost::shared_ptr<ThrowingSink<float> > throwing_sink (new ThrowingSink<float>());
+		queue->add_output (sink_a);
+		queue->add_output (throwing_sink);
+
+		ProcessContext<float> c (random_data, samples, 1);
+		c.set_flag (ProcessContext<float>::EndOfInput);
+		CPPUNIT_ASSERT_THROW (queue->process (c), Exception);
+
+		/* subsequent calls keep failing */
+		CPPUNIT_ASSERT_THROW (queue->process (c), Exception);
+
+		CPPUNIT_ASSERT (TestUtils::array_equals (random_data, sink_a->get_array(), samples));
+	}
+
+  private:
+	boost::shared_ptr<Queue<float> > queue;
+	boost::shared_ptr<AppendingVectorSink<float> > sink_a;
+	boost::shared_ptr<AppendingVectorSink<float> > sink_b;
+
+	float * random_data;
+	samplecnt_t samples;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION (QueueTest);
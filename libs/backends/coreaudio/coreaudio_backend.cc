@@ -36,6 +36,7 @@
 #include "pbd/pthread_utils.h"
 #include "ardour/filesystem_paths.h"
 #include "ardour/port_manager.h"
+#include "ardour/runtime_functions.h"
 #include "pbd/i18n.h"
 
 using namespace ARDOUR;
@@ -1612,22 +1613,18 @@ void*
 CoreAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		std::set<BackendPortPtr>::const_iterator it = connections.begin ();
-		if (it == connections.end ()) {
+		boost::shared_ptr<ConnectionPlan> sources = connection_plan ();
+		ConnectionPlan::const_iterator it = sources->begin ();
+		if (it == sources->end ()) {
 			memset (_buffer, 0, n_samples * sizeof (Sample));
 		} else {
-			boost::shared_ptr<const CoreAudioPort> source = boost::dynamic_pointer_cast<const CoreAudioPort>(*it);
-			assert (source && source->is_output ());
-			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != connections.end ()) {
-				source = boost::dynamic_pointer_cast<const CoreAudioPort>(*it);
-				assert (source && source->is_output ());
-				Sample* dst = buffer ();
-				const Sample* src = source->const_buffer ();
-				for (uint32_t s = 0; s < n_samples; ++s, ++dst, ++src) {
-					*dst += *src;
-				}
+			const CoreAudioPort* source = static_cast<const CoreAudioPort*> (it->get ());
+			assert (dynamic_cast<const CoreAudioPort*> (it->get ()) && source->is_output ());
+			copy_vector (_buffer, source->const_buffer (), n_samples);
+			while (++it != sources->end ()) {
+				source = static_cast<const CoreAudioPort*> (it->get ());
+				assert (dynamic_cast<const CoreAudioPort*> (it->get ()) && source->is_output ());
+				mix_buffers_no_gain (_buffer, source->const_buffer (), n_samples);
 			}
 		}
 	}
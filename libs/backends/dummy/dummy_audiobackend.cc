@@ -21,14 +21,21 @@
 
 #include <math.h>
 #include <sys/time.h>
+#include <sched.h>
 #include <regex.h>
 #include <stdlib.h>
 
+#include <algorithm>
+#include <sstream>
+
+#include <glib/gstdio.h>
 #include <glibmm.h>
 
 #ifdef PLATFORM_WINDOWS
 #include <windows.h>
 #include <pbd/windows_timer_utils.h>
+#else
+#include <sys/resource.h>
 #endif
 
 #include "dummy_audiobackend.h"
@@ -39,6 +46,7 @@
 #include "pbd/pthread_utils.h"
 
 #include "ardour/port_manager.h"
+#include "ardour/runtime_functions.h"
 
 #include "pbd/i18n.h"
 
@@ -58,6 +66,28 @@ static int64_t _x_get_monotonic_usec() {
 	return g_get_monotonic_time();
 }
 
+/* CPU time used by all threads of the process */
+static int64_t _x_get_cpu_usec() {
+#ifdef PLATFORM_WINDOWS
+	FILETIME creation_time, exit_time, kernel, user;
+	if (!GetProcessTimes (GetCurrentProcess (), &creation_time, &exit_time, &kernel, &user)) {
+		return 0;
+	}
+	ULARGE_INTEGER k, u;
+	k.LowPart  = kernel.dwLowDateTime;
+	k.HighPart = kernel.dwHighDateTime;
+	u.LowPart  = user.dwLowDateTime;
+	u.HighPart = user.dwHighDateTime;
+	return (k.QuadPart + u.QuadPart) / 10; // 100ns units
+#else
+	struct rusage ru;
+	if (getrusage (RUSAGE_SELF, &ru)) {
+		return 0;
+	}
+	return (int64_t) (ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1000000 + ru.ru_utime.tv_usec + ru.ru_stime.tv_usec;
+#endif
+}
+
 DummyAudioBackend::DummyAudioBackend (AudioEngine& e, AudioBackendInfo& info)
 	: AudioBackend (e, info)
 	, PortEngineSharedImpl (e, s_instance_name)
@@ -78,6 +108,7 @@ DummyAudioBackend::DummyAudioBackend (AudioEngine& e, AudioBackendInfo& info)
 	, _systemic_output_latency (0)
 	, _processed_samples (0)
 {
+	g_atomic_int_set (&_benchmark_remaining, 0);
 	_instance_name = s_instance_name;
 	_device = _("Silence");
 
@@ -507,6 +538,97 @@ DummyAudioBackend::dsp_load () const
 	return 100.f * _dsp_load;
 }
 
+int
+DummyAudioBackend::start_benchmark (uint32_t n_cycles)
+{
+	if (!_running || n_cycles == 0 || n_cycles > INT32_MAX || g_atomic_int_get (&_benchmark_remaining) > 0) {
+		return -1;
+	}
+	_benchmark.assign (n_cycles, BenchmarkCycle ());
+	g_atomic_int_set (&_benchmark_remaining, n_cycles);
+	return 0;
+}
+
+bool
+DummyAudioBackend::benchmark_running () const
+{
+	return g_atomic_int_get (&_benchmark_remaining) > 0;
+}
+
+static void
+benchmark_stats (std::ostream& o, const char* title, std::vector<int64_t>& v)
+{
+	std::sort (v.begin (), v.end ());
+	double sum = 0;
+	for (std::vector<int64_t>::const_iterator i = v.begin (); i != v.end (); ++i) {
+		sum += *i;
+	}
+	const size_t n = v.size ();
+	o << title
+	  << " min: "  << v.front ()
+	  << " avg: "  << sum / n
+	  << " 50%: "  << v[n / 2]
+	  << " 90%: "  << v[(n * 9) / 10]
+	  << " 99%: "  << v[(n * 99) / 100]
+	  << " max: "  << v.back ()
+	  << "\n";
+}
+
+std::string
+DummyAudioBackend::benchmark_report () const
+{
+	if (g_atomic_int_get (&_benchmark_remaining) > 0 || _benchmark.empty ()) {
+		return "";
+	}
+
+	std::vector<int64_t> wall;
+	std::vector<int64_t> cpu;
+	uint32_t histogram[11] = { 0 }; /* 10% steps, last is overload */
+
+	for (std::vector<BenchmarkCycle>::const_iterator i = _benchmark.begin (); i != _benchmark.end (); ++i) {
+		wall.push_back (i->wall_us);
+		cpu.push_back (i->cpu_us);
+		++histogram[std::min (10, std::max (0, (int) floorf (i->dsp_load * 10.f)))];
+	}
+
+	std::stringstream o;
+	o << _benchmark.size () << " cycles of " << _samples_per_period << " samples at " << _samplerate << " Hz\n";
+	benchmark_stats (o, "wall time [us]", wall);
+	benchmark_stats (o, "CPU time  [us]", cpu);
+	o << "DSP load histogram:\n";
+	for (int b = 0; b < 11; ++b) {
+		if (b < 10) {
+			o << "  " << b * 10 << " - " << (b + 1) * 10 << "%: ";
+		} else {
+			o << "  > 100%: ";
+		}
+		o << histogram[b] << "\n";
+	}
+	return o.str ();
+}
+
+int
+DummyAudioBackend::write_benchmark_data (std::string const& path) const
+{
+	if (g_atomic_int_get (&_benchmark_remaining) > 0 || _benchmark.empty ()) {
+		return -1;
+	}
+
+	FILE* f = g_fopen (path.c_str (), "w");
+	if (!f) {
+		PBD::error << string_compose (_("Dummy backend: cannot write benchmark data to '%1'"), path) << endmsg;
+		return -1;
+	}
+
+	fprintf (f, "cycle,wall_us,cpu_us,dsp_load\n");
+	uint32_t n = 0;
+	for (std::vector<BenchmarkCycle>::const_iterator i = _benchmark.begin (); i != _benchmark.end (); ++i, ++n) {
+		fprintf (f, "%u,%" PRIi64 ",%" PRIi64 ",%f\n", n, i->wall_us, i->cpu_us, i->dsp_load);
+	}
+	fclose (f);
+	return 0;
+}
+
 size_t
 DummyAudioBackend::raw_buffer_size (DataType t)
 {
@@ -932,6 +1054,8 @@ DummyAudioBackend::main_process_thread ()
 
 	int64_t clock1;
 	clock1 = -1;
+	int64_t cpu1 = 0;
+	bool benchmark = false;
 	while (_running) {
 		const size_t samples_per_period = _samples_per_period;
 
@@ -989,20 +1113,39 @@ DummyAudioBackend::main_process_thread ()
 
 			const int64_t elapsed_time = _dsp_load_calc.elapsed_time_us ();
 			const int64_t nominal_time = _dsp_load_calc.get_max_time_us ();
-			if (elapsed_time < nominal_time) {
+			if (benchmark) {
+				/* record this cycle, and proceed with the next one
+				 * right away */
+				BenchmarkCycle& bc (_benchmark[_benchmark.size () - g_atomic_int_get (&_benchmark_remaining)]);
+				bc.wall_us  = elapsed_time;
+				bc.cpu_us   = _x_get_cpu_usec () - cpu1;
+				bc.dsp_load = _dsp_load;
+				g_atomic_int_add (&_benchmark_remaining, -1);
+				sched_yield ();
+			} else if (elapsed_time < nominal_time) {
 				const int64_t sleepy = _speedup * (nominal_time - elapsed_time);
 				Glib::usleep (std::max ((int64_t) 100, sleepy));
 			} else {
 				Glib::usleep (100); // don't hog cpu
 			}
 		} else {
+			/* freewheeling is only used for export, run as fast
+			 * as the session can process. Sleeping here limits an
+			 * offline render to ~10k cycles/sec, regardless of the
+			 * buffer-size.
+			 */
 			_dsp_load = 1.0f;
-			Glib::usleep (100); // don't hog cpu
+			sched_yield ();
 		}
 
 		/* beginning of next cycle */
 		clock1 = _x_get_monotonic_usec();
 
+		benchmark = !_freewheel && g_atomic_int_get (&_benchmark_remaining) > 0;
+		if (benchmark) {
+			cpu1 = _x_get_cpu_usec ();
+		}
+
 		bool connections_changed = false;
 		bool ports_changed = false;
 		if (!pthread_mutex_trylock (&_port_callback_mutex)) {
@@ -1612,28 +1755,24 @@ void*
 DummyAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		std::set<BackendPortPtr>::const_iterator it = connections.begin ();
-		if (it == connections.end ()) {
+		boost::shared_ptr<ConnectionPlan> sources = connection_plan ();
+		ConnectionPlan::const_iterator it = sources->begin ();
+		if (it == sources->end ()) {
 			memset (_buffer, 0, n_samples * sizeof (Sample));
 		} else {
-			boost::shared_ptr<DummyAudioPort> source = boost::dynamic_pointer_cast<DummyAudioPort>(*it);
-			assert (source && source->is_output ());
+			DummyAudioPort* source = static_cast<DummyAudioPort*> (it->get ());
+			assert (dynamic_cast<DummyAudioPort*> (it->get ()) && source->is_output ());
 			if (source->is_physical() && source->is_terminal()) {
 				source->get_buffer(n_samples); // generate signal.
 			}
-			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != connections.end ()) {
-				source = boost::dynamic_pointer_cast<DummyAudioPort>(*it);
-				assert (source && source->is_output ());
-				Sample* dst = buffer ();
+			copy_vector (_buffer, source->const_buffer (), n_samples);
+			while (++it != sources->end ()) {
+				source = static_cast<DummyAudioPort*> (it->get ());
+				assert (dynamic_cast<DummyAudioPort*> (it->get ()) && source->is_output ());
 				if (source->is_physical() && source->is_terminal()) {
 					source->get_buffer(n_samples); // generate signal.
 				}
-				const Sample* src = source->const_buffer ();
-				for (uint32_t s = 0; s < n_samples; ++s, ++dst, ++src) {
-					*dst += *src;
-				}
+				mix_buffers_no_gain (_buffer, source->const_buffer (), n_samples);
 			}
 		}
 	} else if (is_output () && is_physical () && is_terminal()) {
@@ -267,6 +267,12 @@ class DummyAudioBackend : public AudioBackend, public PortEngineSharedImpl {
 		float dsp_load () const;
 		size_t raw_buffer_size (DataType t);
 
+		/* Benchmarking */
+		int start_benchmark (uint32_t n_cycles);
+		bool benchmark_running () const;
+		std::string benchmark_report () const;
+		int write_benchmark_data (std::string const& path) const;
+
 		/* Process time */
 		samplepos_t sample_time ();
 		samplepos_t sample_time_at_cycle_start ();
@@ -384,6 +390,19 @@ class DummyAudioBackend : public AudioBackend, public PortEngineSharedImpl {
 
 		samplecnt_t _processed_samples;
 
+		/* benchmark, data is written by the process thread
+		 * while _benchmark_remaining > 0 */
+		struct BenchmarkCycle {
+			int64_t wall_us;
+			int64_t cpu_us;
+			float   dsp_load;
+
+			BenchmarkCycle () : wall_us (0), cpu_us (0), dsp_load (0) {}
+		};
+
+		std::vector<BenchmarkCycle> _benchmark;
+		mutable GATOMIC_QUAL gint   _benchmark_remaining;
+
 		pthread_t _main_thread;
 
 		/* process threads */
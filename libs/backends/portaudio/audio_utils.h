@@ -22,6 +22,8 @@
 
 #include <stdint.h>
 
+#include "ardour/runtime_functions.h"
+
 inline
 void
 deinterleave_audio_data(const float* interleaved_input,
@@ -30,11 +32,7 @@ deinterleave_audio_data(const float* interleaved_input,
                         uint32_t channel,
                         uint32_t channel_count)
 {
-	const float* ptr = interleaved_input + channel;
-	while (sample_count-- > 0) {
-		*output++ = *ptr;
-		ptr += channel_count;
-	}
+	ARDOUR::deinterleave (output, interleaved_input, sample_count, channel, channel_count);
 }
 
 inline
@@ -45,11 +43,7 @@ interleave_audio_data(float* input,
                       uint32_t channel,
                       uint32_t channel_count)
 {
-	float* ptr = interleaved_output + channel;
-	while (sample_count-- > 0) {
-		*ptr = *input++;
-		ptr += channel_count;
-	}
+	ARDOUR::interleave (interleaved_output, input, sample_count, channel, channel_count);
 }
 
 #endif // AUDIO_UTILS_H
@@ -43,6 +43,7 @@
 
 #include "ardour/filesystem_paths.h"
 #include "ardour/port_manager.h"
+#include "ardour/runtime_functions.h"
 #include "pbd/i18n.h"
 
 #include "audio_utils.h"
@@ -1839,21 +1840,18 @@ PortAudioPort::~PortAudioPort () { }
 void* PortAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		std::set<BackendPortPtr>::const_iterator it = get_connections ().begin ();
-		if (it == get_connections ().end ()) {
+		boost::shared_ptr<ConnectionPlan> sources = connection_plan ();
+		ConnectionPlan::const_iterator it = sources->begin ();
+		if (it == sources->end ()) {
 			memset (_buffer, 0, n_samples * sizeof (Sample));
 		} else {
-			boost::shared_ptr<const PortAudioPort> source = boost::dynamic_pointer_cast<const PortAudioPort>(*it);
-			assert (source && source->is_output ());
-			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != get_connections ().end ()) {
-				source = boost::dynamic_pointer_cast<const PortAudioPort>(*it);
-				assert (source && source->is_output ());
-				Sample* dst = buffer ();
-				const Sample* src = source->const_buffer ();
-				for (uint32_t s = 0; s < n_samples; ++s, ++dst, ++src) {
-					*dst += *src;
-				}
+			const PortAudioPort* source = static_cast<const PortAudioPort*> (it->get ());
+			assert (dynamic_cast<const PortAudioPort*> (it->get ()) && source->is_output ());
+			copy_vector (_buffer, source->const_buffer (), n_samples);
+			while (++it != sources->end ()) {
+				source = static_cast<const PortAudioPort*> (it->get ());
+				assert (dynamic_cast<const PortAudioPort*> (it->get ()) && source->is_output ());
+				mix_buffers_no_gain (_buffer, source->const_buffer (), n_samples);
 			}
 		}
 	}
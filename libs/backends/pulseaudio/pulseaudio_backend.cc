@@ -32,6 +32,7 @@
 #include "pbd/pthread_utils.h"
 
 #include "ardour/port_manager.h"
+#include "ardour/runtime_functions.h"
 
 #include "pulseaudio_backend.h"
 
@@ -1084,9 +1085,7 @@ PulseAudioBackend::main_process_thread ()
 			for (std::vector<BackendPortPtr>::const_iterator it = _system_outputs.begin (); it != _system_outputs.end (); ++it, ++i) {
 				BackendPortPtr port = boost::dynamic_pointer_cast<BackendPort> (*it);
 				const float* src = (const float*) port->get_buffer (_samples_per_period);
-				for (size_t n = 0; n < _samples_per_period; ++n) {
-					buf[N_CHANNELS * n + i] = src[n];
-				}
+				ARDOUR::interleave (buf, src, _samples_per_period, i, N_CHANNELS);
 			}
 
 			if (pa_stream_write (p_stream, buf, bytes_to_write, NULL, 0, PA_SEEK_RELATIVE) < 0) {
@@ -1228,23 +1227,18 @@ void*
 PulseAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		const std::set<BackendPortPtr>&          connections = get_connections ();
-		std::set<BackendPortPtr>::const_iterator it          = connections.begin ();
-
-		if (it == connections.end ()) {
+		boost::shared_ptr<ConnectionPlan> sources = connection_plan ();
+		ConnectionPlan::const_iterator it = sources->begin ();
+		if (it == sources->end ()) {
 			memset (_buffer, 0, n_samples * sizeof (Sample));
 		} else {
-			boost::shared_ptr<PulseAudioPort> source = boost::dynamic_pointer_cast<PulseAudioPort> (*it);
-			assert (source && source->is_output ());
-			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != connections.end ()) {
-				source = boost::dynamic_pointer_cast<PulseAudioPort> (*it);
-				assert (source && source->is_output ());
-				Sample*       dst = buffer ();
-				const Sample* src = source->const_buffer ();
-				for (uint32_t s = 0; s < n_samples; ++s, ++dst, ++src) {
-					*dst += *src;
-				}
+			PulseAudioPort* source = static_cast<PulseAudioPort*> (it->get ());
+			assert (dynamic_cast<PulseAudioPort*> (it->get ()) && source->is_output ());
+			copy_vector (_buffer, source->const_buffer (), n_samples);
+			while (++it != sources->end ()) {
+				source = static_cast<PulseAudioPort*> (it->get ());
+				assert (dynamic_cast<PulseAudioPort*> (it->get ()) && source->is_output ());
+				mix_buffers_no_gain (_buffer, source->const_buffer (), n_samples);
 			}
 		}
 	}
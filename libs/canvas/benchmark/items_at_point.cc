@@ -1,6 +1,8 @@
 #include <sys/time.h>
-#include "canvas/group.h"
+#include <limits>
+#include "canvas/container.h"
 #include "canvas/canvas.h"
+#include "canvas/lookup_table.h"
 #include "canvas/root_group.h"
 #include "canvas/rectangle.h"
 #include "benchmark.h"
@@ -8,24 +10,47 @@
 using namespace std;
 using namespace ArdourCanvas;
 
+static double
+seconds_since (timeval const & start)
+{
+	timeval stop;
+	gettimeofday (&stop, 0);
+
+	int sec = stop.tv_sec - start.tv_sec;
+	int usec = stop.tv_usec - start.tv_usec;
+	if (usec < 0) {
+		--sec;
+		usec += 1e6;
+	}
+
+	return sec + ((double) usec / 1e6);
+}
+
+/** Hit-test a container of @param n_rectangles items, then move some of them
+ *  around between hit-tests (as happens during a drag).
+ *  @param min_items value for RTreeLookupTable::min_items
+ */
 static void
-test (int items_per_cell)
+test (int n_rectangles, size_t min_items)
 {
-	Group::default_items_per_cell = items_per_cell;
+	RTreeLookupTable::min_items = min_items;
 
-	int const n_rectangles = 10000;
 	int const n_tests = 1000;
+	int const n_moves = 10;
 	double const rough_size = 1000;
 	srand (1);
 
 	ImageCanvas canvas;
 
-	list<Item*> rectangles;
+	vector<Item*> rectangles;
 
 	for (int i = 0; i < n_rectangles; ++i) {
 		rectangles.push_back (new Rectangle (canvas.root(), rect_random (rough_size)));
 	}
 
+	timeval start;
+	gettimeofday (&start, 0);
+
 	for (int i = 0; i < n_tests; ++i) {
 		Duple test (double_random() * rough_size, double_random() * rough_size);
 
@@ -33,30 +58,36 @@ test (int items_per_cell)
 		vector<Item const *> items;
 		canvas.root()->add_items_at_point (test, items);
 	}
-}
-
-int main ()
-{
-	int tests[] = { 1, 2, 4, 8, 16, 32, 64, 128, 256 };
 
-	for (unsigned int i = 0; i < sizeof (tests) / sizeof (int); ++i) {
-		timeval start;
-		timeval stop;
+	double const hit = seconds_since (start);
 
-		gettimeofday (&start, 0);
-		test (tests[i]);
-		gettimeofday (&stop, 0);
+	gettimeofday (&start, 0);
 
-		int sec = stop.tv_sec - start.tv_sec;
-		int usec = stop.tv_usec - start.tv_usec;
-		if (usec < 0) {
-			--sec;
-			usec += 1e6;
+	for (int i = 0; i < n_tests; ++i) {
+		for (int j = 0; j < n_moves; ++j) {
+			rectangles[rand() % rectangles.size()]->move (Duple (double_random() * 10 - 5, double_random() * 10 - 5));
 		}
 
-		double seconds = sec + ((double) usec / 1e6);
-
-		cout << "Test " << tests[i] << ": " << seconds << "\n";
+		Duple test (double_random() * rough_size, double_random() * rough_size);
+		vector<Item const *> items;
+		canvas.root()->add_items_at_point (test, items);
 	}
+
+	double const move = seconds_since (start);
+
+	cout << n_rectangles << " " << (min_items == numeric_limits<size_t>::max() ? "linear" : "rtree ")
+	     << "  hit-test: " << hit << "  move+hit-test: " << move << "\n";
 }
 
+int main ()
+{
+	size_t const rtree = RTreeLookupTable::min_items;
+	int sizes[] = { 10, 100, 1000, 10000, 100000 };
+
+	for (unsigned int i = 0; i < sizeof (sizes) / sizeof (int); ++i) {
+		test (sizes[i], numeric_limits<size_t>::max());
+		test (sizes[i], rtree);
+	}
+
+	return 0;
+}
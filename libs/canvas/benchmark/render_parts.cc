@@ -1,9 +1,11 @@
 #include <sys/time.h>
+#include <limits>
 #include <pangomm/init.h>
 #include "pbd/compose.h"
 #include "pbd/xml++.h"
-#include "canvas/group.h"
+#include "canvas/container.h"
 #include "canvas/canvas.h"
+#include "canvas/lookup_table.h"
 #include "canvas/root_group.h"
 #include "canvas/rectangle.h"
 #include "benchmark.h"
@@ -16,14 +18,14 @@ class RenderParts : public Benchmark
 public:
 	RenderParts (string const & session) : Benchmark (session) {}
 
-	void set_items_per_cell (int items)
+	void set_min_items (size_t items)
 	{
-		_items_per_cell = items;
+		_min_items = items;
 	}
 
 	void do_run (ImageCanvas& canvas)
 	{
-		Group::default_items_per_cell = _items_per_cell;
+		RTreeLookupTable::min_items = _min_items;
 
 		for (int i = 0; i < 1e4; i += 50) {
 			canvas.render_to_image (Rect (i, 0, i + 50, 1024));
@@ -31,7 +33,7 @@ public:
 	}
 
 private:
-	int _items_per_cell;
+	size_t _min_items;
 };
 
 int main (int argc, char* argv[])
@@ -45,14 +47,15 @@ int main (int argc, char* argv[])
 
 	RenderParts render_parts (argv[1]);
 
-	int tests[] = { 16, 32, 64, 128, 256, 512, 1024, 1e4, 1e5, 1e6 };
+	/* containers with at least this many children use a spatial index
+	 * to find the children to render, the last one never does.
+	 */
+	size_t tests[] = { 1, 16, 32, 64, 128, 256, 1024, numeric_limits<size_t>::max() };
 
-	for (unsigned int i = 0; i < sizeof (tests) / sizeof (int); ++i) {
-		render_parts.set_items_per_cell (tests[i]);
+	for (unsigned int i = 0; i < sizeof (tests) / sizeof (size_t); ++i) {
+		render_parts.set_min_items (tests[i]);
 		cout << tests[i] << " " << render_parts.run () << "\n";
 	}
 
 	return 0;
 }
-
-
@@ -351,6 +351,8 @@ public:
 	void clear_items (bool with_delete);
 
 	void ensure_lut () const;
+	void lut_item_added (Item*);
+	void notify_parent_lut () const;
 	mutable LookupTable* _lut;
 	/* our items, from lowest to highest in the stack */
 	std::list<Item*> _items;
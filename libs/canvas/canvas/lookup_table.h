@@ -20,6 +20,7 @@
 #ifndef __CANVAS_LOOKUP_TABLE_H__
 #define __CANVAS_LOOKUP_TABLE_H__
 
+#include <map>
 #include <vector>
 #include <boost/multi_array.hpp>
 
@@ -42,6 +43,16 @@ public:
     virtual std::vector<Item*> items_at_point (Duple const &) const = 0;
     virtual bool has_item_at_point (Duple const & point) const = 0;
 
+    /* Changes to the children of our item. Tables that keep no
+     * state of their own can ignore them.
+     */
+    virtual void item_added (Item*) {}
+    virtual void item_removed (Item const *) {}
+    /** the bounding box or position of a child may have changed */
+    virtual void item_changed (Item const *) {}
+    /** a child was moved in the stacking order */
+    virtual void item_restacked (Item const *) {}
+
 protected:
 
     Item const & _item;
@@ -84,6 +95,85 @@ public:
     bool _added;
 };
 
+/** A lookup table that keeps the bounding boxes of the children of an
+ *  item in an R-tree, so that the children in an area or at a point
+ *  can be found without testing every one of them.
+ *
+ *  The tree is bulk-loaded, and then updated as the item reports changes
+ *  to its children. Bounding boxes of changed children are only re-read
+ *  on the next lookup; a child that still fits into its leaf is updated
+ *  in place, others are kept in a short list that is searched linearly
+ *  until it becomes large enough to make rebuilding the tree worthwhile.
+ *
+ *  Like DumbLookupTable, results are in stacking order, lowest first.
+ */
+class LIBCANVAS_API RTreeLookupTable : public LookupTable
+{
+public:
+	RTreeLookupTable (Item const &);
+
+	std::vector<Item*> get (Rect const &);
+	std::vector<Item*> items_at_point (Duple const &) const;
+	bool has_item_at_point (Duple const & point) const;
+
+	void item_added (Item*);
+	void item_removed (Item const *);
+	void item_changed (Item const *);
+	void item_restacked (Item const *);
+
+	/** items with at least this many children use an RTreeLookupTable */
+	static size_t min_items;
+
+private:
+	struct Entry {
+		Entry (Item* i) : item (i), order (0), slot (-1), leaf (-1), loose (false), dirty (true) {}
+
+		Item*   item;
+		Rect    bbox;  ///< in our item's coordinates
+		int64_t order; ///< position in the stack, lowest first
+		int     slot;  ///< index in _slots, or -1
+		int     leaf;  ///< index of the leaf node in _nodes, or -1
+		bool    loose; ///< in _loose
+		bool    dirty; ///< bbox needs to be re-read
+	};
+
+	struct Node {
+		Rect bbox;
+		int  first; ///< first child in _nodes, or first entry in _slots for leaves
+		int  count;
+		bool leaf;
+	};
+
+	struct EntrySortByOrder {
+		bool operator() (Entry const * a, Entry const * b) const {
+			return a->order < b->order;
+		}
+	};
+
+	typedef std::map<Item const *, Entry> Entries;
+
+	void update () const;
+	void rebuild () const;
+	void renumber () const;
+	void read_bbox (Entry&) const;
+	void refresh (Entry&) const;
+	void detach (Entry&) const;
+	void search (Rect const &, std::vector<Entry*>&) const;
+	Rect to_item (Rect const &) const;
+	Rect to_item (Duple const &) const;
+	void set_order (Entry&) const;
+
+	mutable Entries             _entries;
+	mutable std::vector<Node>   _nodes;  ///< root is the last node
+	mutable std::vector<Entry*> _slots;  ///< leaf contents, 0 for removed entries
+	mutable std::vector<Entry*> _loose;  ///< entries not in the tree
+	mutable std::vector<Item const *> _dirty;
+	mutable size_t              _removed;
+	mutable int64_t             _min_order;
+	mutable int64_t             _max_order;
+	mutable bool                _restacked;
+};
+
 }
 
 #endif
@@ -289,6 +289,8 @@ Item::set_position (Duple p)
 
 	_position = p;
 
+	notify_parent_lut ();
+
 	/* only update canvas and parent if visible. Otherwise, this
 	   will be done when ::show() is called.
 	*/
@@ -406,6 +408,8 @@ Item::propagate_show_hide ()
 {
 	/* bounding box may have changed while we were hidden */
 
+	notify_parent_lut ();
+
 	if (_parent) {
 		_parent->child_changed (true);
 	}
@@ -759,6 +763,11 @@ Item::begin_change ()
 void
 Item::end_change ()
 {
+	/* even if hidden, so that the parent's lookup table is up to date
+	 * when we (or one of our ancestors) are shown again.
+	 */
+	notify_parent_lut ();
+
 	if (visible()) {
 		_canvas->item_changed (this, _pre_change_bounding_box);
 
@@ -1054,8 +1063,9 @@ Item::add (Item* i)
 
 	_items.push_back (i);
 	i->reparent (this, true);
-	invalidate_lut ();
+	lut_item_added (i);
 	_bounding_box_dirty = true;
+	notify_parent_lut ();
 }
 
 void
@@ -1065,8 +1075,9 @@ Item::add_front (Item* i)
 
 	_items.push_front (i);
 	i->reparent (this, true);
-	invalidate_lut ();
+	lut_item_added (i);
 	_bounding_box_dirty = true;
+	notify_parent_lut ();
 }
 
 void
@@ -1092,7 +1103,9 @@ Item::remove (Item* i)
 	i->unparent ();
 	i->set_layout_sensitive (false);
 	_items.remove (i);
-	invalidate_lut ();
+	if (_lut) {
+		_lut->item_removed (i);
+	}
 	_bounding_box_dirty = true;
 
 	end_change ();
@@ -1149,7 +1162,9 @@ Item::raise_child_to_top (Item* i)
 	_items.remove (i);
 	_items.push_back (i);
 
-	invalidate_lut ();
+	if (_lut) {
+		_lut->item_restacked (i);
+	}
         redraw ();
 }
 
@@ -1168,7 +1183,9 @@ Item::raise_child (Item* i, int levels)
 	}
 
 	_items.insert (j, i);
-	invalidate_lut ();
+	if (_lut) {
+		_lut->item_restacked (i);
+	}
         redraw ();
 }
 
@@ -1182,7 +1199,9 @@ Item::lower_child_to_bottom (Item* i)
 	}
 	_items.remove (i);
 	_items.push_front (i);
-	invalidate_lut ();
+	if (_lut) {
+		_lut->item_restacked (i);
+	}
         redraw ();
 }
 
@@ -1190,7 +1209,37 @@ void
 Item::ensure_lut () const
 {
 	if (!_lut) {
-		_lut = new DumbLookupTable (*this);
+		if (_items.size() >= RTreeLookupTable::min_items) {
+			_lut = new RTreeLookupTable (*this);
+		} else {
+			_lut = new DumbLookupTable (*this);
+		}
+	}
+}
+
+void
+Item::lut_item_added (Item* i)
+{
+	if (!_lut) {
+		return;
+	}
+
+	if (_items.size() == RTreeLookupTable::min_items) {
+		/* big enough to be worth indexing, start over */
+		invalidate_lut ();
+	} else {
+		_lut->item_added (i);
+	}
+}
+
+/** Tell our parent's lookup table that our bounding box, position or
+ *  visibility may have changed.
+ */
+void
+Item::notify_parent_lut () const
+{
+	if (_parent && _parent->_lut) {
+		_parent->_lut->item_changed (this);
 	}
 }
 
@@ -1204,12 +1253,14 @@ Item::invalidate_lut () const
 void
 Item::child_changed (bool bbox_changed)
 {
-	invalidate_lut ();
+	/* the child has told our lookup table about the change already */
 
 	if (bbox_changed) {
 		_bounding_box_dirty = true;
 	}
 
+	notify_parent_lut ();
+
 	if (_parent) {
 		_parent->child_changed (bbox_changed);
 	}
@@ -18,6 +18,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+
 #include "canvas/item.h"
 #include "canvas/lookup_table.h"
 
@@ -325,3 +327,441 @@ OptimizingLookupTable::get (Rect const & area)
 	return vitems;
 }
 
+
+/* maximum number of entries in a leaf, and of children of a node */
+static const int rtree_fanout = 16;
+
+/* search a little beyond bounding boxes: DumbLookupTable tests against
+ * rounded window coordinates, and Item::covers() of some items has a
+ * tolerance of its own.
+ */
+static const Distance rtree_slop = 2.0;
+
+size_t RTreeLookupTable::min_items = 32;
+
+static inline bool
+rtree_overlaps (Rect const & a, Rect const & b)
+{
+	return a.x0 <= b.x1 && b.x0 <= a.x1 && a.y0 <= b.y1 && b.y0 <= a.y1;
+}
+
+static inline bool
+rtree_encloses (Rect const & outer, Rect const & inner)
+{
+	return outer.x0 <= inner.x0 && outer.y0 <= inner.y0 && inner.x1 <= outer.x1 && inner.y1 <= outer.y1;
+}
+
+/* Coords may be as large as COORD_MAX, avoid (x0 + x1) overflowing */
+
+struct RTreeSortByX {
+	template<typename T> bool operator() (T const * a, T const * b) const {
+		return a->bbox.x0 / 2 + a->bbox.x1 / 2 < b->bbox.x0 / 2 + b->bbox.x1 / 2;
+	}
+};
+
+struct RTreeSortByY {
+	template<typename T> bool operator() (T const * a, T const * b) const {
+		return a->bbox.y0 / 2 + a->bbox.y1 / 2 < b->bbox.y0 / 2 + b->bbox.y1 / 2;
+	}
+};
+
+RTreeLookupTable::RTreeLookupTable (Item const & item)
+	: LookupTable (item)
+	, _removed (0)
+	, _min_order (0)
+	, _max_order (0)
+	, _restacked (false)
+{
+	list<Item*> const & items = _item.items ();
+
+	for (list<Item*>::const_iterator i = items.begin(); i != items.end(); ++i) {
+		_entries.insert (make_pair (*i, Entry (*i)));
+	}
+
+	renumber ();
+	rebuild ();
+}
+
+void
+RTreeLookupTable::item_added (Item* item)
+{
+	pair<Entries::iterator, bool> r = _entries.insert (make_pair (item, Entry (item)));
+
+	if (!r.second) {
+		/* already known, treat as a change */
+		item_changed (item);
+		return;
+	}
+
+	set_order (r.first->second);
+	_dirty.push_back (item);
+}
+
+void
+RTreeLookupTable::item_removed (Item const * item)
+{
+	/* item may be half-way destroyed, do not call it */
+
+	Entries::iterator i = _entries.find (item);
+
+	if (i == _entries.end ()) {
+		return;
+	}
+
+	detach (i->second);
+	_entries.erase (i);
+}
+
+void
+RTreeLookupTable::item_changed (Item const * item)
+{
+	Entries::iterator i = _entries.find (item);
+
+	if (i == _entries.end () || i->second.dirty) {
+		return;
+	}
+
+	i->second.dirty = true;
+	_dirty.push_back (item);
+}
+
+void
+RTreeLookupTable::item_restacked (Item const * item)
+{
+	Entries::iterator i = _entries.find (item);
+
+	if (i != _entries.end ()) {
+		set_order (i->second);
+	}
+}
+
+void
+RTreeLookupTable::set_order (Entry& e) const
+{
+	list<Item*> const & items = _item.items ();
+
+	if (_restacked) {
+		/* everything is renumbered anyway */
+		return;
+	}
+
+	if (!items.empty () && items.back () == e.item) {
+		e.order = ++_max_order;
+	} else if (!items.empty () && items.front () == e.item) {
+		e.order = --_min_order;
+	} else {
+		_restacked = true;
+	}
+}
+
+void
+RTreeLookupTable::renumber () const
+{
+	list<Item*> const & items = _item.items ();
+
+	_min_order = 0;
+	_max_order = 0;
+
+	for (list<Item*>::const_iterator i = items.begin(); i != items.end(); ++i) {
+		Entries::iterator e = _entries.find (*i);
+		if (e != _entries.end ()) {
+			e->second.order = _max_order++;
+		}
+	}
+
+	_max_order = max ((int64_t) 0, _max_order - 1);
+	_restacked = false;
+}
+
+/** Remove an entry from the tree or the loose list */
+void
+RTreeLookupTable::detach (Entry& e) const
+{
+	if (e.slot >= 0) {
+		_slots[e.slot] = 0;
+		e.slot = -1;
+		e.leaf = -1;
+		++_removed;
+	}
+
+	if (e.loose) {
+		_loose.erase (find (_loose.begin (), _loose.end (), &e));
+		e.loose = false;
+	}
+}
+
+void
+RTreeLookupTable::read_bbox (Entry& e) const
+{
+	Rect bbox = e.item->bounding_box ();
+
+	if (bbox) {
+		e.bbox = e.item->item_to_parent (bbox);
+	} else {
+		e.bbox = Rect ();
+	}
+
+	e.dirty = false;
+}
+
+/** Re-read the bounding box of a changed child, and move it in the tree if required */
+void
+RTreeLookupTable::refresh (Entry& e) const
+{
+	read_bbox (e);
+
+	if (!e.bbox) {
+		/* never found by DumbLookupTable either */
+		detach (e);
+		return;
+	}
+
+	if (e.leaf >= 0 && rtree_encloses (_nodes[e.leaf].bbox, e.bbox)) {
+		/* still inside its leaf, and hence inside all of its parents */
+		return;
+	}
+
+	if (!e.loose) {
+		detach (e);
+		_loose.push_back (&e);
+		e.loose = true;
+	}
+}
+
+void
+RTreeLookupTable::update () const
+{
+	if (_restacked) {
+		renumber ();
+	}
+
+	if (_dirty.empty ()) {
+		return;
+	}
+
+	for (vector<Item const *>::const_iterator i = _dirty.begin(); i != _dirty.end(); ++i) {
+		Entries::iterator e = _entries.find (*i);
+		if (e != _entries.end () && e->second.dirty) {
+			refresh (e->second);
+		}
+	}
+
+	_dirty.clear ();
+
+	if (_loose.size () + _removed > max ((size_t) rtree_fanout, _entries.size () / 4)) {
+		rebuild ();
+	}
+}
+
+/** Bulk-load the tree from all entries: sort the entries into vertical
+ *  slices, and pack each slice from top to bottom into leaves
+ *  (sort-tile-recursive). Upper levels group consecutive nodes, which are
+ *  neighbours already.
+ */
+void
+RTreeLookupTable::rebuild () const
+{
+	_nodes.clear ();
+	_slots.clear ();
+	_loose.clear ();
+	_dirty.clear ();
+	_removed = 0;
+
+	for (Entries::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+		Entry& e = i->second;
+		if (e.dirty) {
+			read_bbox (e);
+		}
+		e.slot = -1;
+		e.leaf = -1;
+		e.loose = false;
+		if (e.bbox) {
+			_slots.push_back (&e);
+		}
+	}
+
+	if (_slots.empty ()) {
+		return;
+	}
+
+	const int n_leaves = (_slots.size () + rtree_fanout - 1) / rtree_fanout;
+	const int n_slices = max (1, (int) ceil (sqrt ((double) n_leaves)));
+	const int per_slice = n_slices * rtree_fanout;
+
+	sort (_slots.begin (), _slots.end (), RTreeSortByX ());
+
+	for (size_t s = 0; s < _slots.size (); s += per_slice) {
+		vector<Entry*>::iterator end = _slots.begin () + min (_slots.size (), s + per_slice);
+		sort (_slots.begin () + s, end, RTreeSortByY ());
+	}
+
+	for (size_t s = 0; s < _slots.size (); s += rtree_fanout) {
+		Node n;
+		n.first = s;
+		n.count = min ((size_t) rtree_fanout, _slots.size () - s);
+		n.leaf = true;
+		n.bbox = _slots[s]->bbox;
+		for (int i = 0; i < n.count; ++i) {
+			Entry* e = _slots[s + i];
+			e->slot = s + i;
+			e->leaf = _nodes.size ();
+			n.bbox = n.bbox.extend (e->bbox);
+		}
+		_nodes.push_back (n);
+	}
+
+	size_t level = 0;
+
+	while (_nodes.size () - level > 1) {
+		const size_t next = _nodes.size ();
+		for (size_t c = level; c < next; c += rtree_fanout) {
+			Node n;
+			n.first = c;
+			n.count = min ((size_t) rtree_fanout, next - c);
+			n.leaf = false;
+			n.bbox = _nodes[c].bbox;
+			for (int i = 1; i < n.count; ++i) {
+				n.bbox = n.bbox.extend (_nodes[c + i].bbox);
+			}
+			_nodes.push_back (n);
+		}
+		level = next;
+	}
+}
+
+/** Collect entries whose bounding box overlaps @param area (in our item's
+ * coordinates), in stacking order.
+ */
+void
+RTreeLookupTable::search (Rect const & area, vector<Entry*>& found) const
+{
+	if (!_nodes.empty ()) {
+		vector<int> stack;
+		stack.push_back (_nodes.size () - 1);
+
+		while (!stack.empty ()) {
+			Node const & n = _nodes[stack.back ()];
+			stack.pop_back ();
+
+			if (!rtree_overlaps (n.bbox, area)) {
+				continue;
+			}
+
+			if (n.leaf) {
+				for (int i = n.first; i < n.first + n.count; ++i) {
+					Entry* e = _slots[i];
+					if (e && rtree_overlaps (e->bbox, area)) {
+						found.push_back (e);
+					}
+				}
+			} else {
+				for (int i = n.first; i < n.first + n.count; ++i) {
+					stack.push_back (i);
+				}
+			}
+		}
+	}
+
+	for (vector<Entry*>::const_iterator i = _loose.begin(); i != _loose.end(); ++i) {
+		if (rtree_overlaps ((*i)->bbox, area)) {
+			found.push_back (*i);
+		}
+	}
+
+	sort (found.begin (), found.end (), EntrySortByOrder ());
+}
+
+/* Lookups use window coordinates. All children share the same scroll
+ * offset, which is not necessarily the one of our item (if that is a
+ * ScrollGroup), so convert via a child.
+ */
+
+Rect
+RTreeLookupTable::to_item (Rect const & r) const
+{
+	Item const * child = _item.items ().front ();
+	return child->window_to_item (r).translate (child->position ());
+}
+
+Rect
+RTreeLookupTable::to_item (Duple const & d) const
+{
+	Item const * child = _item.items ().front ();
+	Duple const p = child->window_to_item (d).translate (child->position ());
+	return Rect (p.x, p.y, p.x, p.y);
+}
+
+vector<Item*>
+RTreeLookupTable::get (Rect const & area)
+{
+	vector<Item*> vitems;
+
+	if (_item.items ().empty ()) {
+		return vitems;
+	}
+
+	update ();
+
+	vector<Entry*> found;
+	search (to_item (area).expand (rtree_slop), found);
+
+	/* same test as DumbLookupTable */
+	for (vector<Entry*>::const_iterator i = found.begin(); i != found.end(); ++i) {
+		Rect item_bbox = (*i)->item->bounding_box ();
+		if (!item_bbox) continue;
+		Rect item = (*i)->item->item_to_window (item_bbox);
+		if (item.intersection (area)) {
+			vitems.push_back ((*i)->item);
+		}
+	}
+
+	return vitems;
+}
+
+vector<Item*>
+RTreeLookupTable::items_at_point (Duple const & point) const
+{
+	/* Point is in window coordinate system */
+
+	vector<Item*> vitems;
+
+	if (_item.items ().empty ()) {
+		return vitems;
+	}
+
+	update ();
+
+	vector<Entry*> found;
+	search (to_item (point).expand (rtree_slop), found);
+
+	for (vector<Entry*>::const_iterator i = found.begin(); i != found.end(); ++i) {
+		if ((*i)->item->covers (point)) {
+			vitems.push_back ((*i)->item);
+		}
+	}
+
+	return vitems;
+}
+
+bool
+RTreeLookupTable::has_item_at_point (Duple const & point) const
+{
+	/* Point is in window coordinate system */
+
+	if (_item.items ().empty ()) {
+		return false;
+	}
+
+	update ();
+
+	vector<Entry*> found;
+	search (to_item (point).expand (rtree_slop), found);
+
+	for (vector<Entry*>::const_iterator i = found.begin(); i != found.end(); ++i) {
+		if ((*i)->item->visible () && (*i)->item->covers (point)) {
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -35,6 +35,7 @@
 
 #define GUARD_POINT_DELTA Temporal::timecnt_t (64)
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <iostream>
@@ -72,6 +73,8 @@ ControlList::ControlList (const Parameter& id, const ParameterDescriptor& desc,
 {
 	_frozen = 0;
 	_changed_when_thawed = false;
+	g_atomic_int_set (&_flat_dirty, 1);
+	_edit_count = 0;
 	_lookup_cache.left = timepos_t::max (_time_domain);
 	_lookup_cache.range.first = _events.end();
 	_lookup_cache.range.second = _events.end();
@@ -94,6 +97,8 @@ ControlList::ControlList (const ControlList& other)
 {
 	_frozen = 0;
 	_changed_when_thawed = false;
+	g_atomic_int_set (&_flat_dirty, 1);
+	_edit_count = 0;
 	_lookup_cache.range.first = _events.end();
 	_lookup_cache.range.second = _events.end();
 	_search_cache.first = _events.end();
@@ -117,6 +122,8 @@ ControlList::ControlList (const ControlList& other, timepos_t const & start, tim
 {
 	_frozen = 0;
 	_changed_when_thawed = false;
+	g_atomic_int_set (&_flat_dirty, 1);
+	_edit_count = 0;
 	_lookup_cache.range.first = _events.end();
 	_lookup_cache.range.second = _events.end();
 	_search_cache.first = _events.end();
@@ -465,6 +472,7 @@ ControlList::unlocked_remove_duplicates ()
 	while (i != _events.end()) {
 		if ((*prev)->when == (*i)->when && (*prev)->value == (*i)->value) {
 			i = _events.erase (i);
+			mark_dirty ();
 		} else {
 			++prev;
 			++i;
@@ -580,6 +588,7 @@ ControlList::add_guard_point (timepos_t const & time, timecnt_t const & offset)
 
 		DEBUG_TRACE (DEBUG::ControlList, string_compose ("@%1 insert iterator at end, adding eval-value there %2\n", this, eval_value));
 		_events.push_back (new ControlEvent (when, eval_value));
+		mark_dirty ();
 		/* leave insert iterator at the end */
 
 	} else if ((*most_recent_insert_iterator)->when == when) {
@@ -606,6 +615,7 @@ ControlList::add_guard_point (timepos_t const & time, timecnt_t const & offset)
 								 this, eval_value, (*most_recent_insert_iterator)->when));
 
 		most_recent_insert_iterator = _events.insert (most_recent_insert_iterator, new ControlEvent (when, eval_value));
+		mark_dirty ();
 
 		/* advance most_recent_insert_iterator so that the "real"
 		 * insert occurs in the right place, since it
@@ -687,6 +697,7 @@ ControlList::maybe_add_insert_guard (timepos_t const & time)
 			   new control point so that our insert will happen correctly. */
 			most_recent_insert_iterator = _events.insert ( most_recent_insert_iterator,
 					new ControlEvent (when + GUARD_POINT_DELTA, (*most_recent_insert_iterator)->value));
+			mark_dirty ();
 
 			DEBUG_TRACE (DEBUG::ControlList, string_compose ("@%1 added insert guard point @ %2 = %3\n",
 			                                                 this, when + GUARD_POINT_DELTA,
@@ -720,6 +731,7 @@ ControlList::maybe_insert_straight_line (timepos_t const & time, double value)
 			/* At least two points with the exact same value (straight
 			   line), just move the final point to the new time. */
 			_events.back()->when = when;
+			mark_dirty ();
 			DEBUG_TRACE (DEBUG::ControlList, string_compose ("final value of %1 moved to %2\n", value, when));
 			return true;
 		}
@@ -738,6 +750,7 @@ ControlList::erase_from_iterator_to (iterator iter, timepos_t const & time)
 			DEBUG_TRACE (DEBUG::ControlList, string_compose ("@%1 erase existing @ %2\n", this, (*iter)->when));
 			delete *iter;
 			iter = _events.erase (iter);
+			mark_dirty ();
 			continue;
 		} else if ((*iter)->when >= when) {
 			break;
@@ -1191,6 +1204,7 @@ ControlList::thaw ()
 			unlocked_remove_duplicates ();
 			unlocked_invalidate_insert_iterator ();
 			_sort_pending = false;
+			mark_dirty ();
 		}
 	}
 	maybe_signal_changed ();
@@ -1205,11 +1219,81 @@ ControlList::mark_dirty () const
 	_search_cache.left = timepos_t::max (_time_domain);
 	_search_cache.first = _events.end();
 
+	g_atomic_int_set (&_flat_dirty, 1);
+	++_edit_count;
+
+	if (_flat.when.capacity () < _events.size ()) {
+		/* allocate here (the caller holds the write lock), so that
+		 * update_flat_events() does not need to allocate memory.
+		 */
+		const size_t n = std::max<size_t> (64, 2 * _events.size ());
+		_flat.when.reserve (n);
+		_flat.value.reserve (n);
+		_flat.iter.reserve (n);
+	}
+
 	if (_curve) {
 		_curve->mark_dirty();
 	}
 }
 
+size_t
+ControlList::FlatEvents::upper_bound (int64_t x) const
+{
+	return std::upper_bound (when.begin (), when.end (), x) - when.begin ();
+}
+
+size_t
+ControlList::FlatEvents::lower_bound (int64_t x) const
+{
+	return std::lower_bound (when.begin (), when.end (), x) - when.begin ();
+}
+
+bool
+ControlList::update_flat_events () const
+{
+	if (!g_atomic_int_get (&_flat_dirty) && _flat.size () == _events.size ()) {
+		return _flat.valid;
+	}
+
+	/* Several threads may hold the reader lock, only one of them updates
+	 * the copy. Others use the EventList meanwhile.
+	 */
+	Glib::Threads::Mutex::Lock lm (_flat_lock, Glib::Threads::TRY_LOCK);
+	if (!lm.locked ()) {
+		return false;
+	}
+
+	if (!g_atomic_int_get (&_flat_dirty) && _flat.size () == _events.size ()) {
+		/* another thread just updated it */
+		return _flat.valid;
+	}
+
+	if (_flat.when.capacity () < _events.size ()) {
+		/* events were added without mark_dirty() */
+		return false;
+	}
+
+	_flat.when.clear ();
+	_flat.value.clear ();
+	_flat.iter.clear ();
+
+	_flat.valid       = true;
+	_flat.time_domain = _events.empty () ? _time_domain : _events.front ()->when.time_domain ();
+
+	for (const_iterator i = _events.begin (); i != _events.end (); ++i) {
+		if ((*i)->when.time_domain () != _flat.time_domain) {
+			_flat.valid = false;
+		}
+		_flat.when.push_back ((*i)->when.val ());
+		_flat.value.push_back ((*i)->value);
+		_flat.iter.push_back (i);
+	}
+
+	g_atomic_int_set (&_flat_dirty, 0);
+	return _flat.valid;
+}
+
 void
 ControlList::truncate_end (timepos_t const & last_time)
 {
@@ -1491,6 +1575,40 @@ ControlList::multipoint_eval (timepos_t const & xtime) const
 	double uval, lval;
 	double fraction;
 
+	/* Binary search in the flat copy of the event list, if it is up to date */
+	if (update_flat_events () && xtime.time_domain () == _flat.time_domain) {
+		const int64_t x = xtime.val ();
+		const size_t  n = _flat.size ();
+		const size_t  u = _flat.upper_bound (x);
+
+		if (u == 0) {
+			/* we're before the first point */
+			return _flat.value.front ();
+		}
+
+		const size_t k = u - 1;
+
+		if (k == n - 1 || _flat.when[k] == x || _interpolation == Discrete) {
+			return _flat.value[k];
+		}
+
+		lval     = _flat.value[k];
+		uval     = _flat.value[k + 1];
+		fraction = (double) (x - _flat.when[k]) / (double) (_flat.when[k + 1] - _flat.when[k]);
+
+		switch (_interpolation) {
+			case Logarithmic:
+				return interpolate_logarithmic (lval, uval, fraction, _desc.lower, _desc.upper);
+			case Exponential:
+				return interpolate_gain (lval, uval, fraction, _desc.upper);
+			case Curved:
+				/* only used x-fade curves, never direct eval */
+				assert (0);
+			default: // Linear
+				return interpolate_linear (lval, uval, fraction);
+		}
+	}
+
 	/* "Stepped" lookup (no interpolation) */
 	/* FIXME: no cache.  significant? */
 	if (_interpolation == Discrete) {
@@ -1582,9 +1700,13 @@ ControlList::build_search_cache_if_necessary (timepos_t const & start_time) cons
 	} else if ((_search_cache.left == timepos_t::max (_time_domain)) || (_search_cache.left > start)) {
 		/* Marked dirty (left == max), or we're too far forward, re-search. */
 
-		const ControlEvent start_point (start, 0);
-
-		_search_cache.first = lower_bound (_events.begin(), _events.end(), &start_point, time_comparator);
+		if (update_flat_events () && start.time_domain () == _flat.time_domain) {
+			const size_t idx = _flat.lower_bound (start.val ());
+			_search_cache.first = (idx < _flat.size ()) ? _flat.iter[idx] : _events.end ();
+		} else {
+			const ControlEvent start_point (start, 0);
+			_search_cache.first = lower_bound (_events.begin(), _events.end(), &start_point, time_comparator);
+		}
 		_search_cache.left = start;
 	}
 
@@ -376,6 +376,101 @@ Curve::_get_vector (Temporal::timepos_t const & x0, Temporal::timepos_t const &
 		dx = (hx - lx) / (veclen - 1);
 	}
 
+	ControlList::FlatEvents const& flat (_list.flat_events ());
+
+	if (_list.update_flat_events () && x0.time_domain () == flat.time_domain) {
+		/* Evaluate one segment between two control points at a time,
+		 * rather than looking up the segment for every sample.
+		 */
+		const size_t n = flat.size ();
+
+		i = 0;
+		while (i < veclen) {
+			rx = lx + i * dx;
+
+			const size_t u = flat.upper_bound ((int64_t) rx);
+			const size_t k = u > 0 ? u - 1 : 0;
+
+			if (k >= n - 1) {
+				/* at or after the last point */
+				const float val = flat.value.back ();
+				for (; i < veclen; ++i) {
+					vec[i] = val;
+				}
+				break;
+			}
+
+			const double w0 = flat.when[k];
+			const double w1 = flat.when[k + 1];
+			const double v0 = flat.value[k];
+			const double v1 = flat.value[k + 1];
+
+			/* first sample that is not in this segment */
+			int32_t j_end = veclen;
+			if (dx > 0) {
+				const double je = ceil ((w1 - lx) / dx);
+				if (je < veclen) {
+					j_end = (int32_t) je;
+					while (j_end > i + 1 && (int64_t) (lx + (j_end - 1) * dx) >= flat.when[k + 1]) {
+						--j_end;
+					}
+					while (j_end < veclen && (int64_t) (lx + j_end * dx) < flat.when[k + 1]) {
+						++j_end;
+					}
+				}
+			}
+			j_end = max (j_end, i + 1);
+
+			if (v0 == v1 || _list.interpolation () == ControlList::Discrete) {
+				for (int32_t j = i; j < j_end; ++j) {
+					vec[j] = v0;
+				}
+				i = j_end;
+				continue;
+			}
+
+			const double lower = _list.descriptor().lower;
+			const double upper = _list.descriptor().upper;
+			ControlEvent const* after = *flat.iter[k + 1];
+
+			switch (_list.interpolation()) {
+				case ControlList::Logarithmic:
+					for (int32_t j = i; j < j_end; ++j) {
+						vec[j] = interpolate_logarithmic (v0, v1, (lx + j * dx - w0) / (w1 - w0), lower, upper);
+					}
+					break;
+				case ControlList::Exponential:
+					for (int32_t j = i; j < j_end; ++j) {
+						vec[j] = interpolate_gain (v0, v1, (lx + j * dx - w0) / (w1 - w0), upper);
+					}
+					break;
+				case ControlList::Curved:
+					if (after->coeff) {
+						for (int32_t j = i; j < j_end; ++j) {
+							const double xv  = (int64_t) (lx + j * dx);
+							const double xv2 = xv * xv;
+							vec[j] = after->coeff[0] + (after->coeff[1] * xv) + (after->coeff[2] * xv2) + (after->coeff[3] * xv2 * xv);
+						}
+						break;
+					}
+					/* fallthrough */
+				default: // Linear
+					{
+						/* vec[j] = a + b * j, which the compiler can vectorize */
+						const double b = (v1 - v0) * dx / (w1 - w0);
+						const double a = v0 + (v1 - v0) * (lx - w0) / (w1 - w0);
+						for (int32_t j = i; j < j_end; ++j) {
+							vec[j] = a + b * j;
+						}
+					}
+					break;
+			}
+
+			i = j_end;
+		}
+		return;
+	}
+
 	for (i = 0; i < veclen; ++i, rx += dx) {
 		vec[i] = multipoint_eval (x0.is_beats() ? Temporal::timepos_t::from_ticks (rx) : Temporal::timepos_t::from_superclock (rx));
 	}
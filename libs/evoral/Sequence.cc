@@ -114,23 +114,9 @@ Sequence<Time>::const_iterator::const_iterator(const Sequence<Time>&
 	// Find first note which begins at or after t
 	_note_iter = seq.note_lower_bound(t);
 	// Find first sysex event at or after t
-	for (typename Sequence<Time>::SysExes::const_iterator i = seq.sysexes().begin();
-	     i != seq.sysexes().end(); ++i) {
-		if ((*i)->time() >= t) {
-			_sysex_iter = i;
-			break;
-		}
-	}
-	assert(_sysex_iter == seq.sysexes().end() || (*_sysex_iter)->time() >= t);
-
+	_sysex_iter = seq.sysex_lower_bound(t);
 	// Find first patch event at or after t
-	for (typename Sequence<Time>::PatchChanges::const_iterator i = seq.patch_changes().begin(); i != seq.patch_changes().end(); ++i) {
-		if ((*i)->time() >= t) {
-			_patch_change_iter = i;
-			break;
-		}
-	}
-	assert (_patch_change_iter == seq.patch_changes().end() || (*_patch_change_iter)->time() >= t);
+	_patch_change_iter = seq.patch_change_lower_bound(t);
 
 	// Find first control event after t
 	_control_iters.reserve(seq._controls.size());
@@ -507,8 +493,8 @@ Sequence<Time>::Sequence(const Sequence<Time>& other)
 	, _highest_note(other._highest_note)
 {
 	for (typename Notes::const_iterator i = other._notes.begin(); i != other._notes.end(); ++i) {
-		NotePtr n (new Note<Time> (**i));
-		_notes.insert (n);
+		/* notes are copied in order, append them */
+		_notes.insert (_notes.end(), make_note (**i));
 	}
 
 	for (typename SysExes::const_iterator i = other._sysexes.begin(); i != other._sysexes.end(); ++i) {
@@ -726,7 +712,11 @@ Sequence<Time>::add_note_unlocked(const NotePtr note, void* arg)
 	if (note->note() > _highest_note)
 		_highest_note = note->note();
 
-	_notes.insert (note);
+	/* notes are usually added in order (e.g. when loading a file), in
+	 * which case inserting at the end is amortized constant time. This
+	 * results in the same order as insert (note) in any case.
+	 */
+	_notes.insert (_notes.end(), note);
 	_pitches[note->channel()].insert (note);
 
 	_edited = true;
@@ -847,7 +837,8 @@ Sequence<Time>::remove_note_unlocked(const constNotePtr note)
 			 * so the search_note has all other properties unset.
 			 */
 
-			NotePtr search_note (new Note<Time>(0, Time(), Time(), note->note(), 0));
+			Note<Time> search (0, Time(), Time(), note->note(), 0);
+			NotePtr    search_note (NotePtr(), &search);
 
 			for (j = p.lower_bound (search_note); j != p.end() && (*j)->note() == note->note(); ++j) {
 
@@ -1007,7 +998,7 @@ Sequence<Time>::append_note_on_unlocked (const Event<Time>& ev, event_id_t evid)
 	/* nascent (incoming notes without a note-off ...yet) have a duration
 	   that extends to Beats::max()
 	*/
-	NotePtr note(new Note<Time>(ev.channel(), ev.time(), std::numeric_limits<Temporal::Beats>::max() - ev.time(), ev.note(), ev.velocity()));
+	NotePtr note (make_note (ev.channel(), ev.time(), std::numeric_limits<Temporal::Beats>::max() - ev.time(), ev.note(), ev.velocity()));
 	assert (note->end_time() == std::numeric_limits<Temporal::Beats>::max());
 	note->set_id (evid);
 
@@ -1015,7 +1006,7 @@ Sequence<Time>::append_note_on_unlocked (const Event<Time>& ev, event_id_t evid)
 
 	DEBUG_TRACE (DEBUG::Sequence, string_compose ("Appending active note on %1 channel %2\n",
 	                                              (unsigned)(uint8_t)note->note(), note->channel()));
-	_write_notes[note->channel()].insert (note);
+	_write_notes[note->channel()].insert (_write_notes[note->channel()].end(), note);
 
 }
 
@@ -1150,7 +1141,8 @@ bool
 Sequence<Time>::contains_unlocked (const NotePtr& note) const
 {
 	const Pitches& p (pitches (note->channel()));
-	NotePtr search_note(new Note<Time>(0, Time(), Time(), note->note()));
+	Note<Time>     search (0, Time(), Time(), note->note());
+	NotePtr        search_note (NotePtr(), &search);
 
 	for (typename Pitches::const_iterator i = p.lower_bound (search_note);
 	     i != p.end() && (*i)->note() == note->note(); ++i) {
@@ -1179,7 +1171,8 @@ Sequence<Time>::overlaps_unlocked (const NotePtr& note, const NotePtr& without)
 	Time ea  = note->end_time();
 
 	const Pitches& p (pitches (note->channel()));
-	NotePtr search_note(new Note<Time>(0, Time(), Time(), note->note()));
+	Note<Time>     search (0, Time(), Time(), note->note());
+	NotePtr        search_note (NotePtr(), &search);
 
 	for (typename Pitches::const_iterator i = p.lower_bound (search_note);
 	     i != p.end() && (*i)->note() == note->note(); ++i) {
@@ -1216,7 +1209,11 @@ template<typename Time>
 typename Sequence<Time>::Notes::const_iterator
 Sequence<Time>::note_lower_bound (Time t) const
 {
-	NotePtr search_note(new Note<Time>(0, t, Time(), 0, 0));
+	/* the search key does not need to be allocated, use a shared_ptr
+	 * without ownership (aliasing an empty one) to refer to it.
+	 */
+	Note<Time> search (0, t, Time(), 0, 0);
+	NotePtr    search_note (NotePtr(), &search);
 	typename Sequence<Time>::Notes::const_iterator i = _notes.lower_bound(search_note);
 	assert(i == _notes.end() || (*i)->time() >= t);
 	return i;
@@ -1227,7 +1224,8 @@ template<typename Time>
 typename Sequence<Time>::PatchChanges::const_iterator
 Sequence<Time>::patch_change_lower_bound (Time t) const
 {
-	PatchChangePtr search (new PatchChange<Time> (t, 0, 0, 0));
+	PatchChange<Time> key (t, 0, 0, 0);
+	PatchChangePtr    search (PatchChangePtr(), &key);
 	typename Sequence<Time>::PatchChanges::const_iterator i = _patch_changes.lower_bound (search);
 	assert (i == _patch_changes.end() || (*i)->time() >= t);
 	return i;
@@ -1238,7 +1236,8 @@ template<typename Time>
 typename Sequence<Time>::SysExes::const_iterator
 Sequence<Time>::sysex_lower_bound (Time t) const
 {
-	SysExPtr search (new Event<Time> (NO_EVENT, t));
+	Event<Time> key (NO_EVENT, t);
+	SysExPtr    search (SysExPtr(), &key);
 	typename Sequence<Time>::SysExes::const_iterator i = _sysexes.lower_bound (search);
 	assert (i == _sysexes.end() || (*i)->time() >= t);
 	return i;
@@ -1251,7 +1250,11 @@ template<typename Time>
 typename Sequence<Time>::Notes::iterator
 Sequence<Time>::note_lower_bound (Time t)
 {
-	NotePtr search_note(new Note<Time>(0, t, Time(), 0, 0));
+	/* the search key does not need to be allocated, use a shared_ptr
+	 * without ownership (aliasing an empty one) to refer to it.
+	 */
+	Note<Time> search (0, t, Time(), 0, 0);
+	NotePtr    search_note (NotePtr(), &search);
 	typename Sequence<Time>::Notes::iterator i = _notes.lower_bound(search_note);
 	assert(i == _notes.end() || (*i)->time() >= t);
 	return i;
@@ -1262,7 +1265,8 @@ template<typename Time>
 typename Sequence<Time>::PatchChanges::iterator
 Sequence<Time>::patch_change_lower_bound (Time t)
 {
-	PatchChangePtr search (new PatchChange<Time> (t, 0, 0, 0));
+	PatchChange<Time> key (t, 0, 0, 0);
+	PatchChangePtr    search (PatchChangePtr(), &key);
 	typename Sequence<Time>::PatchChanges::iterator i = _patch_changes.lower_bound (search);
 	assert (i == _patch_changes.end() || (*i)->time() >= t);
 	return i;
@@ -1273,7 +1277,8 @@ template<typename Time>
 typename Sequence<Time>::SysExes::iterator
 Sequence<Time>::sysex_lower_bound (Time t)
 {
-	SysExPtr search (new Event<Time> (NO_EVENT, t));
+	Event<Time> key (NO_EVENT, t);
+	SysExPtr    search (SysExPtr(), &key);
 	typename Sequence<Time>::SysExes::iterator i = _sysexes.lower_bound (search);
 	assert (i == _sysexes.end() || (*i)->time() >= t);
 	return i;
@@ -1313,7 +1318,8 @@ Sequence<Time>::get_notes_by_pitch (Notes& n, NoteOperator op, uint8_t val, int
 		}
 
 		const Pitches& p (pitches (c));
-		NotePtr search_note(new Note<Time>(0, Time(), Time(), val, 0));
+		Note<Time> search (0, Time(), Time(), val, 0);
+		NotePtr    search_note (NotePtr(), &search);
 		typename Pitches::const_iterator i;
 		switch (op) {
 		case PitchEqual:
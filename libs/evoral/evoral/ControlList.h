@@ -25,6 +25,7 @@
 
 #include <cassert>
 #include <list>
+#include <vector>
 #include <stdint.h>
 
 #include <boost/pool/pool.hpp>
@@ -32,6 +33,7 @@
 
 #include <glibmm/threads.h>
 
+#include "pbd/g_atomic_compat.h"
 #include "pbd/signals.h"
 
 #include "temporal/timeline.h"
@@ -292,6 +294,43 @@ public:
 		ControlList::const_iterator first;
 	};
 
+	/** Contiguous copy of the event list.
+	 *
+	 * Binary search and block evaluation on these arrays is a lot more
+	 * cache friendly than walking the linked EventList, which matters
+	 * for evaluating dense automation in realtime context.
+	 */
+	struct FlatEvents {
+		FlatEvents () : valid (false), time_domain (Temporal::AudioTime) {}
+
+		std::vector<int64_t>       when;  /* timepos_t::val() of each event */
+		std::vector<double>        value;
+		std::vector<const_iterator> iter; /* corresponding position in the EventList */
+
+		bool                 valid;       /* false if events use different time domains */
+		Temporal::TimeDomain time_domain; /* time domain of all events */
+
+		size_t size () const { return when.size (); }
+
+		/** @return index of the first event later than @p x */
+		size_t upper_bound (int64_t x) const;
+		/** @return index of the first event not earlier than @p x */
+		size_t lower_bound (int64_t x) const;
+	};
+
+	/** Bring the flat copy of the event list up to date.
+	 *
+	 * The caller must hold the lock (a reader lock is sufficient).
+	 * This is realtime safe, memory is pre-allocated by mark_dirty().
+	 *
+	 * @return true if flat_events() is valid. false if another thread is
+	 * currently updating the copy, or if the events cannot be represented
+	 * (mixed time domains), in which case callers have to fall back
+	 * to use the EventList.
+	 */
+	bool update_flat_events () const;
+	const FlatEvents& flat_events () const { return _flat; }
+
 	/** @return the list of events */
 	const EventList& events() const { return _events; }
 
@@ -318,6 +357,12 @@ public:
 
 	void mark_dirty () const;
 
+	/** @return a counter that is incremented by mark_dirty(), which is
+	 * called for every modification of the events, including guard
+	 * points. The caller must hold the lock.
+	 */
+	uint64_t edit_count () const { return _edit_count; }
+
 	enum InterpolationStyle {
 		Discrete,
 		Linear,
@@ -389,6 +434,11 @@ public:
 
 	mutable Glib::Threads::RWLock _lock;
 
+	mutable FlatEvents            _flat;
+	mutable Glib::Threads::Mutex  _flat_lock;
+	mutable GATOMIC_QUAL gint     _flat_dirty;
+	mutable uint64_t              _edit_count;
+
 	Parameter             _parameter;
 	ParameterDescriptor   _desc;
 	InterpolationStyle    _interpolation;
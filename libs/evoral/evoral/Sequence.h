@@ -29,6 +29,8 @@
 #include <list>
 #include <utility>
 #include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/pool/pool_alloc.hpp>
 #include <glibmm/threads.h>
 
 #include "evoral/visibility.h"
@@ -89,6 +91,22 @@ public:
 	typedef typename boost::weak_ptr<Evoral::Note<Time> >         WeakNotePtr;
 	typedef typename boost::shared_ptr<const Evoral::Note<Time> > constNotePtr;
 
+	/** Notes created by the Sequence itself (when appending events, e.g.
+	 * loading a SMF, or copying a Sequence) are allocated together with
+	 * their reference count from a pool. This saves a heap allocation per
+	 * note, and keeps notes that are loaded together close in memory.
+	 * Memory is returned to the pool, not to the system.
+	 */
+	typedef boost::fast_pool_allocator<Evoral::Note<Time> > NoteAllocator;
+
+	static NotePtr make_note (uint8_t chan, Time time, Time len, uint8_t note, uint8_t vel) {
+		return boost::allocate_shared<Evoral::Note<Time> > (NoteAllocator(), chan, time, len, note, vel);
+	}
+
+	static NotePtr make_note (const Evoral::Note<Time>& other) {
+		return boost::allocate_shared<Evoral::Note<Time> > (NoteAllocator(), other);
+	}
+
 	typedef boost::shared_ptr<Glib::Threads::RWLock::ReaderLock> ReadLock;
 	typedef boost::shared_ptr<WriteLockImpl>                     WriteLock;
 
@@ -329,7 +347,7 @@ protected:
 		return 0;
 	}
 
-	typedef std::multiset<NotePtr, NoteNumberComparator>  Pitches;
+	typedef std::multiset<NotePtr, NoteNumberComparator, boost::fast_pool_allocator<NotePtr> > Pitches;
 	inline       Pitches& pitches(uint8_t chan)       { return _pitches[chan&0xf]; }
 	inline const Pitches& pitches(uint8_t chan) const { return _pitches[chan&0xf]; }
 
@@ -357,7 +375,7 @@ private:
 	SysExes      _sysexes;
 	PatchChanges _patch_changes;
 
-	typedef std::multiset<NotePtr, EarlierNoteComparator> WriteNotes;
+	typedef std::multiset<NotePtr, EarlierNoteComparator, boost::fast_pool_allocator<NotePtr> > WriteNotes;
 	WriteNotes _write_notes[16];
 
 	/** Current bank number on each channel so that we know what
@@ -34,6 +34,7 @@ class LIBPBD_API FPU {
 		HasAVX = 0x10,
 		HasNEON = 0x20,
 		HasFMA = 0x40,
+		HasAVX512F = 0x80,
 	};
 
   public:
@@ -48,6 +49,7 @@ class LIBPBD_API FPU {
 	bool has_sse2 () const { return _flags & HasSSE2; }
 	bool has_avx () const { return _flags & HasAVX; }
 	bool has_fma() const { return _flags & HasFMA; }
+	bool has_avx512f () const { return _flags & HasAVX512F; }
 	bool has_neon () const { return _flags & HasNEON; }
 
   private:
@@ -26,6 +26,7 @@
 
 #include <list>
 #include <map>
+#include <vector>
 
 #ifdef nil
 #undef nil
@@ -109,6 +110,12 @@ public:
 		}
 	}
 
+	/** @return false once disconnect() has started, or the signal is going away */
+	bool connected () const
+	{
+		return _signal.load (std::memory_order_acquire) != 0;
+	}
+
 	void disconnected ()
 	{
 		if (_invalidation_record) {
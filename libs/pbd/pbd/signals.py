@@ -101,21 +101,51 @@ def signal(f, n, v):
     print("private:", file=f)
 
     print("""
-\t/** The slots that this signal will call on emission */
-\ttypedef std::map<boost::shared_ptr<Connection>, slot_function_type> Slots;
-\tSlots _slots;
-""", file=f)
+\t/** The slots that this signal will call on emission, in the order they were connected */
+\ttypedef std::vector<std::pair<boost::shared_ptr<Connection>, slot_function_type> > Slots;
+
+\t/* A list of slots is never modified once it has been published in _slots.
+\t * _connect() and disconnect() replace it as a whole (with _mutex held),
+\t * so that emission can use it without locking or copying.
+\t *
+\t * Emission counts itself in _emitting while it uses the list. Replaced
+\t * lists are kept in _dead until no emission is in progress.
+\t * An empty signal has no list at all.
+\t */
+\tstd::atomic<Slots*> _slots;
+\tstd::atomic<int>    _emitting;
+\tstd::atomic<bool>   _have_dead;
+\tstd::vector<Slots*> _dead;
+
+\tstruct EmissionGuard {
+\t\tEmissionGuard (Signal%(n)d& s) : sig (s) { sig._emitting.fetch_add (1); }
+\t\t~EmissionGuard () { sig.end_emission (); }
+\t\tSignal%(n)d& sig;
+\t};
+""" % { 'n': n }, file=f)
 
     print("public:", file=f)
     print("", file=f)
+    print("\tSignal%d ()" % n, file=f)
+    print("\t\t: _slots (0)", file=f)
+    print("\t\t, _emitting (0)", file=f)
+    print("\t\t, _have_dead (false)", file=f)
+    print("\t{}", file=f)
+    print("", file=f)
     print("\t~Signal%d () {" % n, file=f)
 
     print("\t\t_in_dtor.store (true, std::memory_order_release);", file=f)
     print("\t\tGlib::Threads::Mutex::Lock lm (_mutex);", file=f)
-    print("\t\t/* Tell our connection objects that we are going away, so they don't try to call us */", file=f)
-    print("\t\tfor (%sSlots::const_iterator i = _slots.begin(); i != _slots.end(); ++i) {" % typename, file=f)
-
-    print("\t\t\ti->first->signal_going_away ();", file=f)
+    print("\t\tSlots* s = _slots.exchange (0);", file=f)
+    print("\t\tif (s) {", file=f)
+    print("\t\t\t/* Tell our connection objects that we are going away, so they don't try to call us */", file=f)
+    print("\t\t\tfor (%sSlots::const_iterator i = s->begin(); i != s->end(); ++i) {" % typename, file=f)
+    print("\t\t\t\ti->first->signal_going_away ();", file=f)
+    print("\t\t\t}", file=f)
+    print("\t\t\tdelete s;", file=f)
+    print("\t\t}", file=f)
+    print("\t\tfor (size_t i = 0; i < _dead.size (); ++i) {", file=f)
+    print("\t\t\tdelete _dead[i];", file=f)
     print("\t\t}", file=f)
     print("\t}", file=f)
     print("", file=f)
@@ -231,34 +261,27 @@ def signal(f, n, v):
     else:
         print("\ttypename C::result_type operator() (%s)" % comma_separated(Anan), file=f)
     print("\t{", file=f)
-    print("\t\t/* First, take a copy of our list of slots as it is now */", file=f)
-    print("", file=f)
-    print("\t\tSlots s;", file=f)
-    print("\t\t{", file=f)
-    print("\t\t\tGlib::Threads::Mutex::Lock lm (_mutex);", file=f)
-    print("\t\t\ts = _slots;", file=f)
-    print("\t\t}", file=f)
+    print("\t\t/* Use the list of slots as it is now. It remains valid (and unchanged)", file=f)
+    print("\t\t * until we are done, even if slots are (dis)connected meanwhile.", file=f)
+    print("\t\t */", file=f)
+    print("\t\tEmissionGuard eg (*this);", file=f)
+    print("\t\tSlots const* s = _slots.load ();", file=f)
     print("", file=f)
     if not v:
         print("\t\tstd::list<R> r;", file=f)
-    print("\t\tfor (%sSlots::const_iterator i = s.begin(); i != s.end(); ++i) {" % typename, file=f)
+    print("\t\tif (s) {", file=f)
+    print("\t\t\tfor (%sSlots::const_iterator i = s->begin(); i != s->end(); ++i) {" % typename, file=f)
     print("""
-\t\t\t/* We may have just called a slot, and this may have resulted in
-\t\t\t * disconnection of other slots from us.  The list copy means that
-\t\t\t * this won't cause any problems with invalidated iterators, but we
-\t\t\t * must check to see if the slot we are about to call is still on the list.
-\t\t\t */
-\t\t\tbool still_there = false;
-\t\t\t{
-\t\t\t\tGlib::Threads::Mutex::Lock lm (_mutex);
-\t\t\t\tstill_there = _slots.find (i->first) != _slots.end ();
-\t\t\t}
-
-\t\t\tif (still_there) {""", file=f)
+\t\t\t\t/* We may have just called a slot, and this may have resulted in
+\t\t\t\t * disconnection of other slots from us. We must check to see if
+\t\t\t\t * the slot we are about to call is still connected.
+\t\t\t\t */
+\t\t\t\tif (i->first->connected ()) {""", file=f)
     if v:
-        print("\t\t\t\t(i->second)(%s);" % comma_separated(an), file=f)
+        print("\t\t\t\t\t(i->second)(%s);" % comma_separated(an), file=f)
     else:
-        print("\t\t\t\tr.push_back ((i->second)(%s));" % comma_separated(an), file=f)
+        print("\t\t\t\t\tr.push_back ((i->second)(%s));" % comma_separated(an), file=f)
+    print("\t\t\t\t}", file=f)
     print("\t\t\t}", file=f)
     print("\t\t}", file=f)
     print("", file=f)
@@ -271,13 +294,14 @@ def signal(f, n, v):
     print("""
 \tbool empty () const {
 \t\tGlib::Threads::Mutex::Lock lm (_mutex);
-\t\treturn _slots.empty ();
+\t\treturn _slots.load () == 0;
 \t}
 """, file=f)
     print("""
 \tbool size () const {
 \t\tGlib::Threads::Mutex::Lock lm (_mutex);
-\t\treturn _slots.size ();
+\t\tSlots const* s = _slots.load ();
+\t\treturn s ? s->size () : 0;
 \t}
 """, file=f)
 
@@ -295,10 +319,13 @@ def signal(f, n, v):
 \t{
 \t\tboost::shared_ptr<Connection> c (new Connection (this, ir));
 \t\tGlib::Threads::Mutex::Lock lm (_mutex);
-\t\t_slots[c] = f;
+\t\tSlots const* old = _slots.load ();
+\t\tSlots* s = old ? new Slots (*old) : new Slots;
+\t\ts->push_back (std::make_pair (c, f));
+\t\treplace_slots (s);
 #ifdef DEBUG_PBD_SIGNAL_CONNECTIONS
 \t\tif (_debug_connection) {
-\t\t\tstd::cerr << "+++++++ CONNECT " << this << " size now " << _slots.size() << std::endl;
+\t\t\tstd::cerr << "+++++++ CONNECT " << this << " size now " << s->size() << std::endl;
 \t\t\tPBD::stacktrace (std::cerr, 10);
 \t\t}
 #endif
@@ -318,16 +345,74 @@ def signal(f, n, v):
 \t\t\t/* Spin */
 \t\t\tlm.try_acquire ();
 \t\t}
-\t\t_slots.erase (c);
-\t\tlm.release ();
-
-\t\tc->disconnected ();
+\t\tSlots const* old = _slots.load ();
+\t\tif (old) {
+\t\t\tSlots* s = new Slots;
+\t\t\ts->reserve (old->size ());
+\t\t\tfor (size_t i = 0; i < old->size (); ++i) {
+\t\t\t\tif ((*old)[i].first != c) {
+\t\t\t\t\ts->push_back ((*old)[i]);
+\t\t\t\t}
+\t\t\t}
+\t\t\tif (s->empty ()) {
+\t\t\t\tdelete s;
+\t\t\t\ts = 0;
+\t\t\t}
+\t\t\treplace_slots (s);
+\t\t}
 #ifdef DEBUG_PBD_SIGNAL_CONNECTIONS
 \t\tif (_debug_connection) {
-\t\t\tstd::cerr << "------- DISCCONNECT " << this << " size now " << _slots.size() << std::endl;
+\t\t\tSlots const* s = _slots.load ();
+\t\t\tstd::cerr << "------- DISCCONNECT " << this << " size now " << (s ? s->size () : 0) << std::endl;
 \t\t\tPBD::stacktrace (std::cerr, 10);
 \t\t}
 #endif
+\t\tlm.release ();
+
+\t\tc->disconnected ();
+\t}
+
+\tvoid replace_slots (Slots* s)
+\t{
+\t\t/* called with _mutex held */
+\t\tSlots* old = _slots.exchange (s);
+\t\tif (old) {
+\t\t\t_dead.push_back (old);
+\t\t\t_have_dead.store (true);
+\t\t}
+\t\tdrop_dead ();
+\t}
+
+\tvoid drop_dead ()
+\t{
+\t\t/* called with _mutex held.
+\t\t *
+\t\t * An emission that started before a list was replaced is
+\t\t * counted in _emitting. Any later emission uses the new list,
+\t\t * so once _emitting is zero, nobody can use the old ones.
+\t\t */
+\t\tif (_emitting.load () != 0) {
+\t\t\treturn;
+\t\t}
+\t\tfor (size_t i = 0; i < _dead.size (); ++i) {
+\t\t\tdelete _dead[i];
+\t\t}
+\t\t_dead.clear ();
+\t\t_have_dead.store (false);
+\t}
+
+\tvoid end_emission ()
+\t{
+\t\tif (_emitting.fetch_sub (1) == 1 && _have_dead.load ()) {
+\t\t\t/* The last emission to finish drops lists that were replaced
+\t\t\t * meanwhile. If a writer holds the lock, they are kept until
+\t\t\t * the next change (or the d'tor).
+\t\t\t */
+\t\t\tGlib::Threads::Mutex::Lock lm (_mutex, Glib::Threads::TRY_LOCK);
+\t\t\tif (lm.locked ()) {
+\t\t\t\tdrop_dead ();
+\t\t\t}
+\t\t}
 \t}
 
 };
@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _pbd_work_stealing_deque_h_
+#define _pbd_work_stealing_deque_h_
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <stdint.h>
+
+namespace PBD {
+
+/* Bounded lock free work-stealing deque.
+ *
+ * A single owner thread pushes and pops at the bottom (LIFO), any number
+ * of other threads may concurrently steal from the top (FIFO).
+ *
+ * This is the Chase-Lev deque with the memory-ordering described in
+ * "Correct and Efficient Work-Stealing for Weak Memory Models"
+ * (Lê, Pop, Cohen, Zappa Nardelli, PPoPP 2013), minus the growable array:
+ * the capacity must be reserved up-front while no other thread accesses
+ * the deque.
+ */
+template <typename T>
+class /*LIBPBD_API*/ WorkStealingDeque
+{
+public:
+	WorkStealingDeque (size_t buffer_size = 8)
+		: _buffer (0)
+		, _buffer_mask (0)
+	{
+		reserve (buffer_size);
+	}
+
+	~WorkStealingDeque ()
+	{
+		delete[] _buffer;
+	}
+
+	/* not thread-safe, must only be called while the deque is not in use */
+	void
+	reserve (size_t buffer_size)
+	{
+		size_t sz = 2;
+		while (sz < buffer_size) {
+			sz <<= 1;
+		}
+		if (_buffer_mask >= sz - 1) {
+			return;
+		}
+		delete[] _buffer;
+		_buffer      = new std::atomic<T>[sz];
+		_buffer_mask = sz - 1;
+		clear ();
+	}
+
+	/* not thread-safe, must only be called while the deque is not in use */
+	void
+	clear ()
+	{
+		_top.store (0, std::memory_order_relaxed);
+		_bottom.store (0, std::memory_order_relaxed);
+	}
+
+	/* approximate, for statistics only */
+	size_t
+	size () const
+	{
+		int64_t b = _bottom.load (std::memory_order_relaxed);
+		int64_t t = _top.load (std::memory_order_relaxed);
+		return b > t ? b - t : 0;
+	}
+
+	/** add an element at the bottom. Must only be called by the owner */
+	bool
+	push (T const& data)
+	{
+		int64_t b = _bottom.load (std::memory_order_relaxed);
+		int64_t t = _top.load (std::memory_order_acquire);
+		if (b - t > (int64_t)_buffer_mask) {
+			assert (0);
+			return false;
+		}
+		_buffer[b & _buffer_mask].store (data, std::memory_order_relaxed);
+		std::atomic_thread_fence (std::memory_order_release);
+		_bottom.store (b + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	/** remove the most recently pushed element. Must only be called by the owner */
+	bool
+	pop (T& data)
+	{
+		int64_t b = _bottom.load (std::memory_order_relaxed) - 1;
+		_bottom.store (b, std::memory_order_relaxed);
+		std::atomic_thread_fence (std::memory_order_seq_cst);
+		int64_t t = _top.load (std::memory_order_relaxed);
+
+		if (t > b) {
+			/* empty */
+			_bottom.store (b + 1, std::memory_order_relaxed);
+			return false;
+		}
+
+		data = _buffer[b & _buffer_mask].load (std::memory_order_relaxed);
+
+		if (t == b) {
+			/* last element, race against thieves */
+			bool rv = _top.compare_exchange_strong (t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			_bottom.store (b + 1, std::memory_order_relaxed);
+			return rv;
+		}
+		return true;
+	}
+
+	/** remove the oldest element. May be called by any thread */
+	bool
+	steal (T& data)
+	{
+		int64_t t = _top.load (std::memory_order_acquire);
+		std::atomic_thread_fence (std::memory_order_seq_cst);
+		int64_t b = _bottom.load (std::memory_order_acquire);
+
+		if (t >= b) {
+			return false;
+		}
+
+		data = _buffer[t & _buffer_mask].load (std::memory_order_relaxed);
+		return _top.compare_exchange_strong (t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+	}
+
+private:
+	WorkStealingDeque (WorkStealingDeque const&);
+	WorkStealingDeque& operator= (WorkStealingDeque const&);
+
+	char                 _pad0[64];
+	std::atomic<T>*      _buffer;
+	size_t               _buffer_mask;
+	char                 _pad1[64 - sizeof (std::atomic<T>*) - sizeof (size_t)];
+	std::atomic<int64_t> _top;
+	char                 _pad2[64 - sizeof (int64_t)];
+	std::atomic<int64_t> _bottom;
+	char                 _pad3[64 - sizeof (int64_t)];
+};
+
+} // namespace PBD
+
+#endif
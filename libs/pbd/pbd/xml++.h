@@ -87,6 +87,17 @@ public:
 	int compression() const { return _compression; }
 	int set_compression(int);
 
+	/** Use a compact binary format instead of XML for write().
+	 * The binary format stores the same tree, read() detects the format
+	 * of a file and sets binary() accordingly. A tree can be converted by
+	 * reading one format and writing the other.
+	 */
+	bool binary() const { return _binary; }
+	bool set_binary(bool yn) { return _binary = yn; }
+
+	/** @return true if the file at @p fn is in binary format */
+	static bool is_binary_file(const std::string& fn);
+
 	bool read() { return read_internal(false); }
 	bool read(const std::string& fn) { set_filename(fn); return read_internal(false); }
 	bool read_and_validate() { return read_internal(true); }
@@ -104,11 +115,14 @@ public:
 
 private:
 	bool read_internal(bool validate);
+	bool read_binary();
+	bool write_binary() const;
 
 	std::string _filename;
 	XMLNode*    _root;
 	xmlDocPtr   _doc;
 	int         _compression;
+	bool        _binary;
 };
 
 class LIBPBD_API XMLNode {
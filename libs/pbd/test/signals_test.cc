@@ -1,6 +1,11 @@
+#include <vector>
+
+#include <pthread.h>
+
 #include <glibmm/thread.h>
 
 #include "signals_test.h"
+#include "pbd/g_atomic_compat.h"
 #include "pbd/signals.h"
 
 using namespace std;
@@ -89,3 +94,121 @@ SignalsTest::testScopedConnectionList ()
 
 	CPPUNIT_ASSERT_EQUAL (1, N);
 }
+
+class Disconnector
+{
+public:
+	Disconnector (Emitter* e) : n_first (0), n_second (0) {
+		e->Fred.connect_same_thread (first, boost::bind (&Disconnector::first_receiver, this));
+		e->Fred.connect_same_thread (second, boost::bind (&Disconnector::second_receiver, this));
+	}
+
+	void first_receiver () {
+		++n_first;
+		second.disconnect ();
+	}
+
+	void second_receiver () {
+		++n_second;
+	}
+
+	PBD::ScopedConnection first;
+	PBD::ScopedConnection second;
+	int n_first;
+	int n_second;
+};
+
+void
+SignalsTest::testDisconnectDuringEmission ()
+{
+	Emitter* e = new Emitter;
+	Disconnector d (e);
+
+	/* slots are called in the order they were connected, the first one
+	 * disconnects the second, which must not be called anymore.
+	 */
+	e->emit ();
+	CPPUNIT_ASSERT_EQUAL (1, d.n_first);
+	CPPUNIT_ASSERT_EQUAL (0, d.n_second);
+
+	e->emit ();
+	CPPUNIT_ASSERT_EQUAL (2, d.n_first);
+	CPPUNIT_ASSERT_EQUAL (0, d.n_second);
+
+	delete e;
+}
+
+/* ****************************************************************************/
+
+static void
+count_call (GATOMIC_QUAL gint* cnt)
+{
+	g_atomic_int_inc (cnt);
+}
+
+static const int n_emissions = 100000;
+static const int n_connected = 8;
+
+struct EmitterThread
+{
+	EmitterThread () : sig (0) {}
+
+	void run () {
+		for (int i = 0; i < n_emissions; ++i) {
+			(*sig) ();
+		}
+	}
+
+	static void* launch (void* arg) {
+		static_cast<EmitterThread*> (arg)->run ();
+		return 0;
+	}
+
+	PBD::Signal0<void>* sig;
+};
+
+/* emit from @a n_threads concurrently, while the main thread keeps
+ * connecting and disconnecting an additional slot.
+ */
+static void
+contended_emission (PBD::Signal0<void>* sig, int n_threads, GATOMIC_QUAL gint* cnt)
+{
+	std::vector<EmitterThread> emitters (n_threads);
+	std::vector<pthread_t>     threads (n_threads);
+
+	for (int i = 0; i < n_threads; ++i) {
+		emitters[i].sig = sig;
+		CPPUNIT_ASSERT (pthread_create (&threads[i], NULL, EmitterThread::launch, &emitters[i]) == 0);
+	}
+
+	/* keep changing the list of slots while the emitters run */
+	for (int i = 0; i < 1000; ++i) {
+		PBD::ScopedConnection c;
+		sig->connect_same_thread (c, boost::bind (&count_call, cnt));
+	}
+
+	for (int i = 0; i < n_threads; ++i) {
+		pthread_join (threads[i], NULL);
+	}
+}
+
+void
+SignalsTest::testConcurrentConnect ()
+{
+	PBD::Signal0<void> sig;
+	GATOMIC_QUAL gint  cnt = 0;
+
+	PBD::ScopedConnectionList clist;
+	for (int i = 0; i < n_connected; ++i) {
+		sig.connect_same_thread (clist, boost::bind (&count_call, &cnt));
+	}
+
+	contended_emission (&sig, 4, &cnt);
+
+	/* every emission calls all permanently connected slots */
+	CPPUNIT_ASSERT (g_atomic_int_get (&cnt) >= 4 * n_emissions * n_connected);
+	CPPUNIT_ASSERT (!sig.empty ());
+
+	clist.drop_connections ();
+	CPPUNIT_ASSERT (sig.empty ());
+}
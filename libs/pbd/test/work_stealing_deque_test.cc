@@ -0,0 +1,112 @@
+#include <glib.h>
+
+#include "work_stealing_deque_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (WorkStealingDequeTest);
+
+using namespace std;
+
+#define N_ITEMS   200000
+#define N_THIEVES 3
+
+WorkStealingDequeTest::WorkStealingDequeTest ()
+	: CppUnit::TestFixture ()
+	, _deque (N_ITEMS)
+{
+}
+
+void
+WorkStealingDequeTest::single_thread ()
+{
+	PBD::WorkStealingDeque<int*> d (4);
+	int v[4] = { 0, 1, 2, 3 };
+	int* r;
+
+	CPPUNIT_ASSERT (!d.pop (r));
+	CPPUNIT_ASSERT (!d.steal (r));
+
+	for (int i = 0; i < 4; ++i) {
+		CPPUNIT_ASSERT (d.push (&v[i]));
+	}
+	CPPUNIT_ASSERT_EQUAL ((size_t)4, d.size ());
+
+	/* owner is LIFO */
+	CPPUNIT_ASSERT (d.pop (r));
+	CPPUNIT_ASSERT_EQUAL (3, *r);
+
+	/* thieves are FIFO */
+	CPPUNIT_ASSERT (d.steal (r));
+	CPPUNIT_ASSERT_EQUAL (0, *r);
+
+	CPPUNIT_ASSERT (d.pop (r));
+	CPPUNIT_ASSERT_EQUAL (2, *r);
+	CPPUNIT_ASSERT (d.steal (r));
+	CPPUNIT_ASSERT_EQUAL (1, *r);
+
+	CPPUNIT_ASSERT (!d.pop (r));
+	CPPUNIT_ASSERT (!d.steal (r));
+	CPPUNIT_ASSERT_EQUAL ((size_t)0, d.size ());
+}
+
+static void*
+launch_thief (void* self)
+{
+	WorkStealingDequeTest* t = static_cast<WorkStealingDequeTest*> (self);
+	t->thief_thread ();
+	return NULL;
+}
+
+void
+WorkStealingDequeTest::thief_thread ()
+{
+	int* r;
+	while (!g_atomic_int_get (&_done) || _deque.size () > 0) {
+		if (_deque.steal (r)) {
+			g_atomic_int_inc (&_seen[*r]);
+			g_atomic_int_inc (&_consumed);
+		}
+	}
+}
+
+void
+WorkStealingDequeTest::steal_race ()
+{
+	std::vector<int> values (N_ITEMS);
+	_seen.assign (N_ITEMS, 0);
+	g_atomic_int_set (&_done, 0);
+	g_atomic_int_set (&_consumed, 0);
+
+	pthread_t thieves[N_THIEVES];
+	for (int i = 0; i < N_THIEVES; ++i) {
+		CPPUNIT_ASSERT (pthread_create (&thieves[i], NULL, launch_thief, this) == 0);
+	}
+
+	/* owner pushes, and every now and then consumes some itself */
+	int* r;
+	for (int i = 0; i < N_ITEMS; ++i) {
+		values[i] = i;
+		CPPUNIT_ASSERT (_deque.push (&values[i]));
+		if (i % 3 == 0 && _deque.pop (r)) {
+			g_atomic_int_inc (&_seen[*r]);
+			g_atomic_int_inc (&_consumed);
+		}
+	}
+
+	while (_deque.pop (r)) {
+		g_atomic_int_inc (&_seen[*r]);
+		g_atomic_int_inc (&_consumed);
+	}
+
+	g_atomic_int_set (&_done, 1);
+
+	for (int i = 0; i < N_THIEVES; ++i) {
+		void* return_value;
+		CPPUNIT_ASSERT (pthread_join (thieves[i], &return_value) == 0);
+	}
+
+	/* every item must be consumed exactly once */
+	CPPUNIT_ASSERT_EQUAL (N_ITEMS, (int)g_atomic_int_get (&_consumed));
+	for (int i = 0; i < N_ITEMS; ++i) {
+		CPPUNIT_ASSERT_EQUAL (1, _seen[i]);
+	}
+}
@@ -0,0 +1,28 @@
+#include <vector>
+#include <pthread.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "pbd/g_atomic_compat.h"
+#include "pbd/work_stealing_deque.h"
+
+class WorkStealingDequeTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (WorkStealingDequeTest);
+	CPPUNIT_TEST (single_thread);
+	CPPUNIT_TEST (steal_race);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	WorkStealingDequeTest ();
+	void single_thread ();
+	void steal_race ();
+
+	void thief_thread ();
+
+private:
+	PBD::WorkStealingDeque<int*> _deque;
+	std::vector<int>             _seen;
+	GATOMIC_QUAL gint            _done;
+	GATOMIC_QUAL gint            _consumed;
+};
@@ -218,7 +218,8 @@ static const uint32_t test_iterations = 10;
 
 void
 test_xml_document (const std::string& test_name,
-                   std::vector<NodeOptions>& node_options)
+                   std::vector<NodeOptions>& node_options,
+                   bool binary = false)
 {
 	const string test_output_dir = test_output_directory (test_name);
 
@@ -243,6 +244,7 @@ test_xml_document (const std::string& test_name,
 
 		write_timing_data.start_timing ();
 
+		test_xml.set_binary (binary);
 		test_xml.write (output_file_path);
 
 		write_timing_data.add_elapsed ();
@@ -256,7 +258,9 @@ test_xml_document (const std::string& test_name,
 		read_timing_data.add_elapsed ();
 
 		// check that what we have read is identical to what was written
+		CPPUNIT_ASSERT (read_doc.root());
 		CPPUNIT_ASSERT (*read_doc.root() == *test_xml.root());
+		CPPUNIT_ASSERT (read_doc.binary() == binary);
 
 		// These files are too big to keep around
 		CPPUNIT_ASSERT (g_remove (output_file_path.c_str ()) == 0);
@@ -304,3 +308,61 @@ XMLTest::testPerfLargeXMLDocument ()
 
 	test_xml_document ("testPerfLargeXMLDocument", node_options);
 }
+
+void
+XMLTest::testPerfLargeBinaryDocument ()
+{
+	std::vector<NodeOptions> node_options;
+
+	// same as testPerfLargeXMLDocument
+	node_options.push_back (NodeOptions (child_node_name, 32, 2));
+	node_options.push_back (NodeOptions (grandchild_node_name, 128, 16, get_event_content (32)));
+	node_options.push_back (NodeOptions (great_grandchild_node_name, 16, 8));
+
+	test_xml_document ("testPerfLargeBinaryDocument", node_options, true);
+}
+
+void
+XMLTest::testBinaryRoundTrip ()
+{
+	std::string session_file;
+	CPPUNIT_ASSERT (find_file (test_search_path (), "TestSession.ardour", session_file));
+
+	const string output_dir = test_output_directory ("BinaryRoundTrip");
+	const string bin_path = Glib::build_filename (output_dir, "TestSession.bin");
+	const string xml_path = Glib::build_filename (output_dir, "TestSession.ardour");
+
+	XMLTree orig (session_file);
+	CPPUNIT_ASSERT (orig.root());
+	CPPUNIT_ASSERT (!orig.binary());
+	CPPUNIT_ASSERT (!XMLTree::is_binary_file (session_file));
+
+	/* XML -> binary */
+	orig.set_binary (true);
+	CPPUNIT_ASSERT (orig.write (bin_path));
+	CPPUNIT_ASSERT (XMLTree::is_binary_file (bin_path));
+
+	XMLTree bin (bin_path);
+	CPPUNIT_ASSERT (bin.root());
+	CPPUNIT_ASSERT (bin.binary());
+	CPPUNIT_ASSERT (*bin.root() == *orig.root());
+
+	/* binary -> XML */
+	bin.set_binary (false);
+	CPPUNIT_ASSERT (bin.write (xml_path));
+	CPPUNIT_ASSERT (!XMLTree::is_binary_file (xml_path));
+
+	XMLTree xml (xml_path);
+	CPPUNIT_ASSERT (xml.root());
+	CPPUNIT_ASSERT (*xml.root() == *orig.root());
+
+	/* truncated files are rejected */
+	std::string data = Glib::file_get_contents (bin_path);
+	Glib::file_set_contents (bin_path, data.substr (0, data.size () / 2));
+	XMLTree truncated;
+	CPPUNIT_ASSERT (!truncated.read (bin_path));
+	CPPUNIT_ASSERT (!truncated.root());
+
+	CPPUNIT_ASSERT (g_remove (bin_path.c_str ()) == 0);
+	CPPUNIT_ASSERT (g_remove (xml_path.c_str ()) == 0);
+}
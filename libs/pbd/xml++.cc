@@ -7,6 +7,10 @@
 
 #include <string.h>
 #include <iostream>
+#include <map>
+#include <stdint.h>
+
+#include <glib/gstdio.h>
 
 #include "pbd/xml++.h"
 
@@ -27,6 +31,7 @@ XMLTree::XMLTree()
 	, _root(0)
 	, _doc (0)
 	, _compression(0)
+	, _binary(false)
 {
 }
 
@@ -35,6 +40,7 @@ XMLTree::XMLTree(const string& fn, bool validate)
 	, _root(0)
 	, _doc (0)
 	, _compression(0)
+	, _binary(false)
 {
 	read_internal(validate);
 }
@@ -44,6 +50,7 @@ XMLTree::XMLTree(const XMLTree* from)
 	, _root(new XMLNode(*from->root()))
 	, _doc (xmlCopyDoc (from->_doc, 1))
 	, _compression(from->compression())
+	, _binary(from->binary())
 {
 
 }
@@ -85,6 +92,12 @@ XMLTree::read_internal(bool validate)
 		_doc = 0;
 	}
 
+	_binary = is_binary_file (_filename);
+
+	if (_binary) {
+		return read_binary ();
+	}
+
 	/* Calling this prevents libxml2 from treating whitespace as active
 	   nodes. It needs to be called before we create a parser context.
 	*/
@@ -161,6 +174,10 @@ XMLTree::write() const
 	XMLNodeList children;
 	int result;
 
+	if (_binary) {
+		return write_binary ();
+	}
+
 	xmlKeepBlanksDefault(0);
 	doc = xmlNewDoc(xml_version);
 	xmlSetDocCompressMode(doc, _compression);
@@ -842,3 +859,265 @@ XMLNode::dump (ostream& s, string p) const
 		s << p << "</" << _name << ">\n";
 	}
 }
+
+/* Binary format
+ *
+ * The file starts with binary_magic, followed by the root node. A node is
+ * written as its name, its content, the number of properties, the
+ * properties (name, value), the number of children and the children.
+ * Counts are unsigned LEB128 varints.
+ *
+ * Every string starts with a varint tag: the lowest two bits are the kind,
+ * the other bits are an index or a length:
+ *   0: a reference to a previously interned string (index)
+ *   1: a string (length, bytes), which is interned
+ *   2: a string (length, bytes), which is not interned
+ * Node and property names, and short values, are interned. Sessions
+ * repeat them many times, so they are only written once per file.
+ *
+ * The writer streams the tree to the file, the reader builds the XMLNode
+ * tree directly. Neither needs a libxml2 document.
+ */
+
+static const char   binary_magic[] = "\x89" "ARDXML\r\n\x1a\n\x01"; // incl. version 1
+static const size_t binary_magic_len = sizeof (binary_magic) - 1;
+static const size_t binary_intern_max_len = 16;
+
+namespace {
+
+class BinaryWriter
+{
+public:
+	BinaryWriter (FILE* f) : _f (f), _ok (true) {
+		_buf.reserve (65536);
+	}
+
+	bool ok () const { return _ok; }
+
+	void put_bytes (char const* d, size_t len) {
+		_buf.append (d, len);
+		if (_buf.size () >= 65536) {
+			flush ();
+		}
+	}
+
+	void put_varint (uint64_t v) {
+		char b[10];
+		size_t n = 0;
+		while (v >= 0x80) {
+			b[n++] = (char) (0x80 | (v & 0x7f));
+			v >>= 7;
+		}
+		b[n++] = (char) v;
+		put_bytes (b, n);
+	}
+
+	void put_string (std::string const& str, bool intern) {
+		if (intern) {
+			std::map<std::string, uint64_t>::const_iterator i = _strings.find (str);
+			if (i != _strings.end ()) {
+				put_varint (i->second << 2);
+				return;
+			}
+			uint64_t idx = _strings.size ();
+			_strings.insert (std::make_pair (str, idx));
+			put_varint (((uint64_t) str.size () << 2) | 1);
+		} else {
+			put_varint (((uint64_t) str.size () << 2) | 2);
+		}
+		put_bytes (str.data (), str.size ());
+	}
+
+	void put_node (XMLNode const& n) {
+		put_string (n.name (), true);
+		put_string (n.content (), n.content ().size () <= binary_intern_max_len);
+
+		XMLPropertyList const& props = n.properties ();
+		put_varint (props.size ());
+		for (XMLPropertyConstIterator i = props.begin (); i != props.end (); ++i) {
+			put_string ((*i)->name (), true);
+			put_string ((*i)->value (), (*i)->value ().size () <= binary_intern_max_len);
+		}
+
+		XMLNodeList const& children = n.children ();
+		put_varint (children.size ());
+		for (XMLNodeConstIterator i = children.begin (); i != children.end (); ++i) {
+			put_node (**i);
+		}
+	}
+
+	void flush () {
+		if (_ok && !_buf.empty () && fwrite (_buf.data (), 1, _buf.size (), _f) != _buf.size ()) {
+			_ok = false;
+		}
+		_buf.clear ();
+	}
+
+private:
+	FILE*                           _f;
+	bool                            _ok;
+	std::string                     _buf;
+	std::map<std::string, uint64_t> _strings;
+};
+
+class BinaryReader
+{
+public:
+	BinaryReader (char const* d, size_t len) : _d (d), _end (d + len) {}
+
+	XMLNode* get_node (unsigned int depth = 0) {
+		std::string name;
+		std::string content;
+
+		if (depth > 4096 || !get_string (name) || !get_string (content)) {
+			return 0;
+		}
+
+		XMLNode* node = new XMLNode (name);
+
+		uint64_t n_props;
+		bool ok = get_varint (n_props);
+		for (uint64_t i = 0; ok && i < n_props; ++i) {
+			std::string pname;
+			std::string pvalue;
+			ok = get_string (pname) && get_string (pvalue);
+			if (ok) {
+				node->set_property (pname.c_str (), pvalue);
+			}
+		}
+
+		node->set_content (content);
+
+		uint64_t n_children = 0;
+		ok = ok && get_varint (n_children);
+		for (uint64_t i = 0; ok && i < n_children; ++i) {
+			XMLNode* child = get_node (depth + 1);
+			if (child) {
+				node->add_child_nocopy (*child);
+			} else {
+				ok = false;
+			}
+		}
+
+		if (!ok) {
+			delete node;
+			return 0;
+		}
+		return node;
+	}
+
+	bool at_end () const { return _d == _end; }
+
+private:
+	bool get_varint (uint64_t& v) {
+		v = 0;
+		for (unsigned int shift = 0; shift < 64 && _d < _end; shift += 7) {
+			const unsigned char b = *_d++;
+			v |= (uint64_t) (b & 0x7f) << shift;
+			if (!(b & 0x80)) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool get_string (std::string& str) {
+		uint64_t tag;
+		if (!get_varint (tag)) {
+			return false;
+		}
+		const uint64_t val = tag >> 2;
+		switch (tag & 3) {
+			case 0:
+				if (val >= _strings.size ()) {
+					return false;
+				}
+				str = _strings[val];
+				return true;
+			case 1:
+			case 2:
+				if (val > (uint64_t) (_end - _d)) {
+					return false;
+				}
+				str.assign (_d, val);
+				_d += val;
+				if (tag & 1) {
+					_strings.push_back (str);
+				}
+				return true;
+			default:
+				return false;
+		}
+	}
+
+	char const*              _d;
+	char const*              _end;
+	std::vector<std::string> _strings;
+};
+
+} // anon namespace
+
+bool
+XMLTree::is_binary_file (const string& fn)
+{
+	FILE* f = g_fopen (fn.c_str (), "rb");
+	if (!f) {
+		return false;
+	}
+	char magic[binary_magic_len];
+	bool rv = fread (magic, 1, binary_magic_len, f) == binary_magic_len && !memcmp (magic, binary_magic, binary_magic_len);
+	fclose (f);
+	return rv;
+}
+
+bool
+XMLTree::read_binary ()
+{
+	gchar* data;
+	gsize  len;
+
+	if (!g_file_get_contents (_filename.c_str (), &data, &len, NULL)) {
+		return false;
+	}
+
+	if (len < binary_magic_len || memcmp (data, binary_magic, binary_magic_len)) {
+		g_free (data);
+		return false;
+	}
+
+	BinaryReader reader (data + binary_magic_len, len - binary_magic_len);
+	_root = reader.get_node ();
+
+	if (_root && !reader.at_end ()) {
+		/* trailing garbage */
+		delete _root;
+		_root = 0;
+	}
+
+	g_free (data);
+	return _root != 0;
+}
+
+bool
+XMLTree::write_binary () const
+{
+	if (!_root) {
+		return false;
+	}
+
+	FILE* f = g_fopen (_filename.c_str (), "wb");
+	if (!f) {
+		return false;
+	}
+
+	BinaryWriter writer (f);
+	writer.put_bytes (binary_magic, binary_magic_len);
+	writer.put_node (*_root);
+	writer.flush ();
+
+	bool ok = writer.ok ();
+	if (fclose (f) != 0) {
+		ok = false;
+	}
+	return ok;
+}
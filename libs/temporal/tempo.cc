@@ -711,6 +711,8 @@ TempoMap::copy_points (TempoMap const & other)
 {
 	std::vector<Point*> p;
 
+	drop_lookup ();
+
 	p.reserve (other._meters.size() + other._tempos.size() + other._bartimes.size());
 
 	for (Meters::const_iterator m = other._meters.begin(); m != other._meters.end(); ++m) {
@@ -738,6 +740,42 @@ TempoMap::copy_points (TempoMap const & other)
 	}
 }
 
+void
+TempoMap::build_lookup ()
+{
+	if (!_lookup.empty()) {
+		/* still valid, the map has not been modified since it was built */
+		return;
+	}
+
+	TempoPoint const * tp = &_tempos.front();
+	MeterPoint const * mp = &_meters.front();
+
+	_lookup.reserve (_points.size());
+
+	/* same as _get_tempo_and_meter(): a point may be a tempo and a meter
+	 * (MusicTimePoint), and the entry for a point uses the tempo and
+	 * meter that are in effect at (and including) it.
+	 */
+
+	for (Points::const_iterator p = _points.begin(); p != _points.end(); ++p) {
+
+		TempoPoint const * tpp;
+		MeterPoint const * mpp;
+
+		if ((tpp = dynamic_cast<TempoPoint const *> (&(*p))) != 0) {
+			tp = tpp;
+		}
+
+		if ((mpp = dynamic_cast<MeterPoint const *> (&(*p))) != 0) {
+			mp = mpp;
+		}
+
+		LookupEntry e = { p->sclock(), p->beats(), p->bbt(), tp, mp };
+		_lookup.push_back (e);
+	}
+}
+
 void
 TempoMap::set_time_domain (TimeDomain td)
 {
@@ -778,6 +816,8 @@ TempoMap::add_meter (MeterPoint* mp)
 	const superclock_t sclock_limit = mp->sclock();
 	const Beats beats_limit = mp->beats ();
 
+	drop_lookup ();
+
 	switch (time_domain()) {
 	case AudioTime:
 		for (m = _meters.begin(); m != _meters.end() && m->sclock() < sclock_limit; ++m);
@@ -815,6 +855,7 @@ TempoMap::add_meter (MeterPoint* mp)
 void
 TempoMap::change_tempo (TempoPoint & p, Tempo const & t)
 {
+	drop_lookup ();
 	*((Tempo*)&p) = t;
 }
 
@@ -882,6 +923,8 @@ TempoMap::add_tempo (TempoPoint * tp)
 	const superclock_t sclock_limit = tp->sclock();
 	const Beats beats_limit = tp->beats ();
 
+	drop_lookup ();
+
 	switch (time_domain()) {
 	case AudioTime:
 		for (t = _tempos.begin(); t != _tempos.end() && t->sclock() < sclock_limit; ++t);
@@ -1013,6 +1056,8 @@ TempoMap::add_or_replace_bartime (MusicTimePoint & tp)
 	Points::iterator p;
 	superclock_t sclock_limit = tp.sclock();
 
+	drop_lookup ();
+
 	for (m = _bartimes.begin(); m != _bartimes.end() && m->sclock() < sclock_limit; ++m);
 	for (p = _points.begin(); p != _points.end() && p->sclock() < sclock_limit; ++p);
 
@@ -1087,6 +1132,8 @@ TempoMap::remove_point (Point const & point)
 	Points::iterator p;
 	Point const * tpp (&point);
 
+	drop_lookup ();
+
 	/* note that the point passed here must be an element of the _points
 	 * list, which is not true for the point passed to the callees
 	 * (remove_tempo(), remove_meter(), remove_bartime().
@@ -1111,6 +1158,8 @@ TempoMap::reset_starting_at (superclock_t sc)
 	cerr << "RESET starting at " << sc << endl;
 	dump (cerr);
 
+	drop_lookup ();
+
 	assert (!_tempos.empty());
 	assert (!_meters.empty());
 
@@ -1681,6 +1730,8 @@ TempoMap::sample_rate_changed (samplecnt_t new_sr)
 {
 	const double ratio = new_sr / (double) TEMPORAL_SAMPLE_RATE;
 
+	drop_lookup ();
+
 	for (Tempos::iterator t = _tempos.begin(); t != _tempos.end(); ++t) {
 		t->map_reset_set_sclock_for_sr_change (llrint (ratio * t->sclock()));
 	}
@@ -2394,6 +2445,8 @@ TempoMap::set_state (XMLNode const & node, int version)
 		return set_state_3x (node);
 	}
 
+	drop_lookup ();
+
 	/* global map properties */
 
 	/* XXX this should probably be at the global level in the session file because it affects a lot more than just the tempo map, potentially */
@@ -2676,6 +2729,8 @@ TempoMap::insert_time (timepos_t const & pos, timecnt_t const & duration)
 		return;
 	}
 
+	drop_lookup ();
+
 	Tempos::iterator     t (_tempos.begin());
 	Meters::iterator     m (_meters.begin());
 	MusicTimes::iterator b (_bartimes.begin());
@@ -2804,6 +2859,8 @@ TempoMap::remove_time (timepos_t const & pos, timecnt_t const & duration)
 	superclock_t end ((pos + duration).superclocks());
 	superclock_t shift (duration.superclocks());
 
+	drop_lookup ();
+
 	TempoPoint* last_tempo = 0;
 	MeterPoint* last_meter = 0;
 	TempoPoint* tempo_after = 0;
@@ -2917,6 +2974,10 @@ TempoMap::metric_at (timepos_t const & pos) const
 TempoMetric
 TempoMap::metric_at (superclock_t sc, bool can_match) const
 {
+	if (!_lookup.empty()) {
+		return lookup_metric (&LookupEntry::sclock, sc, can_match);
+	}
+
 	TempoPoint const * tp = 0;
 	MeterPoint const * mp = 0;
 
@@ -2928,6 +2989,10 @@ TempoMap::metric_at (superclock_t sc, bool can_match) const
 TempoMetric
 TempoMap::metric_at (Beats const & b, bool can_match) const
 {
+	if (!_lookup.empty()) {
+		return lookup_metric (&LookupEntry::beats, b, can_match);
+	}
+
 	TempoPoint const * tp = 0;
 	MeterPoint const * mp = 0;
 
@@ -2939,6 +3004,10 @@ TempoMap::metric_at (Beats const & b, bool can_match) const
 TempoMetric
 TempoMap::metric_at (BBT_Time const & bbt, bool can_match) const
 {
+	if (!_lookup.empty()) {
+		return lookup_metric (&LookupEntry::bbt, bbt, can_match);
+	}
+
 	TempoPoint const * tp = 0;
 	MeterPoint const * mp = 0;
 
@@ -2952,6 +3021,8 @@ TempoMap::set_ramped (TempoPoint & tp, bool yn)
 {
 	assert (!_tempos.empty());
 
+	drop_lookup ();
+
 	Rampable & r (tp);
 
 	if (tp.ramped() == yn) {
@@ -3188,6 +3259,7 @@ void
 TempoMap::init ()
 {
 	SharedPtr new_map (new TempoMap (Tempo (120, 4), Meter (4, 4)));
+	new_map->build_lookup ();
 	_map_mgr.init (new_map);
 	fetch ();
 }
@@ -3201,6 +3273,11 @@ TempoMap::write_copy()
 int
 TempoMap::update (TempoMap::SharedPtr m)
 {
+	/* the map is immutable once published, build the lookup table
+	 * before any other thread can see it.
+	 */
+	m->build_lookup ();
+
 	if (!_map_mgr.update (m)) {
 		return -1;
 	}
@@ -3415,6 +3492,8 @@ TempoMap::set_state_3x (const XMLNode& node)
 	XMLNodeList nlist;
 	XMLNodeConstIterator niter;
 
+	drop_lookup ();
+
 	nlist = node.children();
 
 	/* Need initial tempo & meter points, because subsequent ones will use
@@ -759,9 +759,63 @@ class /*LIBTEMPORAL_API*/ TempoMap : public PBD::StatefulDestructible
 	LIBTEMPORAL_API	TempoMetric metric_at (BBT_Time const &, bool can_match = true) const;
 
   private:
-	template<typename TimeType, typename Comparator> TempoPoint const & _tempo_at (TimeType when, Comparator cmp) const {
+	/* A flat copy of the positions of all points, along with the tempo
+	 * and meter in effect at (and including) each of them. This allows
+	 * to look up the metric for a given time using a binary search
+	 * instead of walking the _points list.
+	 *
+	 * It is built when a map is published via ::init() or ::update(),
+	 * and dropped by every method that modifies the map. Since a
+	 * writable copy never has one, lookups in a map that is being
+	 * modified use the (slower) list walk.
+	 */
+	struct LookupEntry {
+		superclock_t       sclock;
+		Beats              beats;
+		BBT_Time           bbt;
+		TempoPoint const * tempo;
+		MeterPoint const * meter;
+	};
+
+	typedef std::vector<LookupEntry> Lookup;
+
+	/* return the last entry at or before (@param can_match true) or
+	 * before (@param can_match false) @param when, or null if there
+	 * is none.
+	 */
+	template<typename TimeType> LookupEntry const * lookup (TimeType LookupEntry::*member, TimeType const & when, bool can_match) const {
+		size_t lo = 0;
+		size_t hi = _lookup.size();
+
+		while (lo < hi) {
+			const size_t mid = (lo + hi) / 2;
+			if (can_match ? !(when < _lookup[mid].*member) : (_lookup[mid].*member < when)) {
+				lo = mid + 1;
+			} else {
+				hi = mid;
+			}
+		}
+
+		return lo ? &_lookup[lo - 1] : 0;
+	}
+
+	/* same semantics as get_tempo_and_meter (..., false) */
+	template<typename TimeType> TempoMetric lookup_metric (TimeType LookupEntry::*member, TimeType const & when, bool can_match) const {
+		LookupEntry const * e = lookup (member, when, can_match || when == TimeType());
+		if (!e) {
+			return TempoMetric (_tempos.front(), _meters.front());
+		}
+		return TempoMetric (*e->tempo, *e->meter);
+	}
+
+	template<typename TimeType, typename Comparator> TempoPoint const & _tempo_at (TimeType when, Comparator cmp, TimeType LookupEntry::*member) const {
 		assert (!_tempos.empty());
 
+		if (!_lookup.empty()) {
+			LookupEntry const * e = lookup (member, when, false);
+			return e ? *e->tempo : _tempos.front();
+		}
+
 		Tempos::const_iterator prev = _tempos.end();
 		for (Tempos::const_iterator t = _tempos.begin(); t != _tempos.end(); ++t) {
 			if (cmp (*t, when)) {
@@ -776,9 +830,14 @@ class /*LIBTEMPORAL_API*/ TempoMap : public PBD::StatefulDestructible
 		return *prev;
 	}
 
-	template<typename TimeType, typename Comparator> MeterPoint const & _meter_at (TimeType when, Comparator cmp) const {
+	template<typename TimeType, typename Comparator> MeterPoint const & _meter_at (TimeType when, Comparator cmp, TimeType LookupEntry::*member) const {
 		assert (!_meters.empty());
 
+		if (!_lookup.empty()) {
+			LookupEntry const * e = lookup (member, when, false);
+			return e ? *e->meter : _meters.front();
+		}
+
 		Meters::const_iterator prev = _meters.end();
 		for (Meters::const_iterator m = _meters.begin(); m != _meters.end(); ++m) {
 			if (cmp (*m, when)) {
@@ -795,14 +854,14 @@ class /*LIBTEMPORAL_API*/ TempoMap : public PBD::StatefulDestructible
 
   public:
 	LIBTEMPORAL_API	MeterPoint const& meter_at (timepos_t const & p) const;
-	LIBTEMPORAL_API	MeterPoint const& meter_at (superclock_t sc) const { return _meter_at (sc, Point::sclock_comparator()); }
-	LIBTEMPORAL_API	MeterPoint const& meter_at (Beats const & b) const { return _meter_at (b, Point::beat_comparator()); }
-	LIBTEMPORAL_API	MeterPoint const& meter_at (BBT_Time const & bbt) const { return _meter_at (bbt, Point::bbt_comparator()); }
+	LIBTEMPORAL_API	MeterPoint const& meter_at (superclock_t sc) const { return _meter_at (sc, Point::sclock_comparator(), &LookupEntry::sclock); }
+	LIBTEMPORAL_API	MeterPoint const& meter_at (Beats const & b) const { return _meter_at (b, Point::beat_comparator(), &LookupEntry::beats); }
+	LIBTEMPORAL_API	MeterPoint const& meter_at (BBT_Time const & bbt) const { return _meter_at (bbt, Point::bbt_comparator(), &LookupEntry::bbt); }
 
 	LIBTEMPORAL_API	TempoPoint const& tempo_at (timepos_t const & p) const;
-	LIBTEMPORAL_API	TempoPoint const& tempo_at (superclock_t sc) const { return _tempo_at (sc, Point::sclock_comparator()); }
-	LIBTEMPORAL_API	TempoPoint const& tempo_at (Beats const & b) const { return _tempo_at (b, Point::beat_comparator()); }
-	LIBTEMPORAL_API TempoPoint const& tempo_at (BBT_Time const & bbt) const { return _tempo_at (bbt, Point::bbt_comparator()); }
+	LIBTEMPORAL_API	TempoPoint const& tempo_at (superclock_t sc) const { return _tempo_at (sc, Point::sclock_comparator(), &LookupEntry::sclock); }
+	LIBTEMPORAL_API	TempoPoint const& tempo_at (Beats const & b) const { return _tempo_at (b, Point::beat_comparator(), &LookupEntry::beats); }
+	LIBTEMPORAL_API TempoPoint const& tempo_at (BBT_Time const & bbt) const { return _tempo_at (bbt, Point::bbt_comparator(), &LookupEntry::bbt); }
 
 	LIBTEMPORAL_API TempoPoint const* previous_tempo (TempoPoint const &) const;
 
@@ -888,6 +947,11 @@ class /*LIBTEMPORAL_API*/ TempoMap : public PBD::StatefulDestructible
 
 	TimeDomain _time_domain;
 
+	Lookup     _lookup;
+
+	void build_lookup ();
+	void drop_lookup () { _lookup.clear (); }
+
 	int set_tempos_from_state (XMLNode const &);
 	int set_meters_from_state (XMLNode const &);
 	int set_music_times_from_state (XMLNode const &);
@@ -38,3 +38,44 @@ TempoMapTest::convertTest()
 {
 }
 
+
+void
+TempoMapTest::lookupTest()
+{
+	TempoMap::SharedPtr orig (TempoMap::fetch());
+	TempoMap::SharedPtr tmap (TempoMap::write_copy());
+
+	for (int n = 1; n < 64; ++n) {
+		tmap->set_tempo (Tempo (90 + (n % 7) * 10, 4), timepos_t (Beats (n * 4 + (n % 3), 0)));
+	}
+	tmap->set_meter (Meter (3, 4), BBT_Time (20, 1, 0));
+
+	TempoMap::update (tmap);
+
+	/* a published map uses its lookup table, a copy of it walks the
+	 * list of points. Both must give the same results.
+	 */
+	TempoMap::SharedPtr published (TempoMap::use());
+	TempoMap const plain (*published);
+
+	for (int64_t ticks = 0; ticks < 300 * ticks_per_beat; ticks += 97) {
+		Beats const b (Beats::ticks (ticks));
+		superclock_t const sc = plain.superclock_at (b);
+		BBT_Time const bbt = plain.bbt_at (b);
+
+		CPPUNIT_ASSERT_EQUAL (sc, published->superclock_at (b));
+		CPPUNIT_ASSERT_EQUAL (bbt, published->bbt_at (b));
+		CPPUNIT_ASSERT_EQUAL (plain.bbt_at (timepos_t::from_superclock (sc + 11)), published->bbt_at (timepos_t::from_superclock (sc + 11)));
+		CPPUNIT_ASSERT_EQUAL (plain.quarters_at_superclock (sc + 11), published->quarters_at_superclock (sc + 11));
+		CPPUNIT_ASSERT_EQUAL (plain.quarters_at (bbt), published->quarters_at (bbt));
+		CPPUNIT_ASSERT_EQUAL (plain.superclock_at (bbt), published->superclock_at (bbt));
+		CPPUNIT_ASSERT_EQUAL (plain.tempo_at (sc).sclock(), published->tempo_at (sc).sclock());
+		CPPUNIT_ASSERT_EQUAL (plain.tempo_at (b).sclock(), published->tempo_at (b).sclock());
+		CPPUNIT_ASSERT_EQUAL (plain.meter_at (bbt).sclock(), published->meter_at (bbt).sclock());
+		CPPUNIT_ASSERT_EQUAL (plain.metric_at (b, false).superclocks_per_note_type(), published->metric_at (b, false).superclocks_per_note_type());
+	}
+
+	/* restore the initial map for other tests */
+	TempoMap::write_copy();
+	TempoMap::update (orig);
+}
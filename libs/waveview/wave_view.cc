@@ -18,6 +18,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
 #include <cmath>
 
 #include <boost/scoped_array.hpp>
@@ -121,6 +122,11 @@ WaveView::init ()
 
 WaveView::~WaveView ()
 {
+	for (DrawRequests::const_iterator i = _requests.begin (); i != _requests.end (); ++i) {
+		cancel_request (*i);
+	}
+	_requests.clear ();
+
 #ifdef ENABLE_THREADED_WAVEFORM_RENDERING
 	WaveViewThreads::deinitialize ();
 #endif
@@ -231,13 +237,13 @@ WaveView::set_clip_level (double dB)
 }
 
 boost::shared_ptr<WaveViewDrawRequest>
-WaveView::create_draw_request (WaveViewProperties const& props) const
+WaveView::create_draw_request (WaveViewProperties const& props, int64_t tile) const
 {
 	assert (props.is_valid());
 
 	boost::shared_ptr<WaveViewDrawRequest> request (new WaveViewDrawRequest);
 
-	request->image = boost::shared_ptr<WaveViewImage> (new WaveViewImage (_region, props));
+	request->image = boost::shared_ptr<WaveViewImage> (new WaveViewImage (_region, props, tile));
 	return request;
 }
 
@@ -269,17 +275,156 @@ WaveView::prepare_for_render (Rect const& area) const
 		return;
 	}
 
-	if (_image) {
-		if (_image->props.is_equivalent (required_props)) {
-			return;
+	int64_t first;
+	int64_t last;
+
+	tile_range (required_props, first, last);
+
+	for (int64_t tile = first; tile <= last; ++tile) {
+		get_image (tile_properties (tile), tile, false);
+	}
+
+	cancel_stale_requests ();
+}
+
+void
+WaveView::tile_range (WaveViewProperties const& props, int64_t& first, int64_t& last) const
+{
+	double const tile_samples = WaveViewImage::tile_width * props.samples_per_pixel;
+
+	first = floor (props.get_sample_start () / tile_samples);
+	last  = floor (std::max (props.get_sample_start (), props.get_sample_end () - 1) / tile_samples);
+}
+
+WaveViewProperties
+WaveView::tile_properties (int64_t tile) const
+{
+	/* tiles are aligned to the source, so that all regions using the
+	 * source share them, except at the region bounds.
+	 */
+	double const tile_samples = WaveViewImage::tile_width * _props->samples_per_pixel;
+
+	WaveViewProperties props = *_props;
+	props.set_sample_offsets (llrint (tile * tile_samples), llrint ((tile + 1) * tile_samples));
+	return props;
+}
+
+boost::shared_ptr<WaveViewImage>
+WaveView::lookup_image (WaveViewProperties const& props, int64_t tile) const
+{
+	for (Images::const_iterator i = _images.begin (); i != _images.end (); ++i) {
+		if ((*i)->tile == tile && (*i)->contains_image_with_properties (props)) {
+			return *i;
+		}
+	}
+
+	for (DrawRequests::const_iterator i = _requests.begin (); i != _requests.end (); ++i) {
+		if ((*i)->image->tile == tile && !(*i)->stopped () && (*i)->image->props.is_equivalent (props)) {
+			return (*i)->image;
+		}
+	}
+
+	return get_cache_group ()->lookup_image (props, tile);
+}
+
+boost::shared_ptr<WaveViewImage>
+WaveView::get_image (WaveViewProperties const& props, int64_t tile, bool draw_now) const
+{
+	boost::shared_ptr<WaveViewImage> image = lookup_image (props, tile);
+
+	if (image && image->finished ()) {
+		get_cache_group ()->add_image (image);
+		return image;
+	}
+
+	if (image) {
+		/* the image is still being drawn, maybe for another WaveView */
+		boost::shared_ptr<WaveViewDrawRequest> req = image->request.lock ();
+
+		if (req && !req->stopped ()) {
+			if (!draw_now) {
+				if (find (_requests.begin (), _requests.end (), req) == _requests.end ()) {
+					_requests.push_back (req);
+				}
+				return boost::shared_ptr<WaveViewImage> ();
+			}
+			cancel_request (req);
 		} else {
-			// Image does not contain sample area required
+			// Request was cancelled, the image will never be finished
+			get_cache_group ()->remove_image (image);
+		}
+	}
+
+	boost::shared_ptr<WaveViewDrawRequest> const request = create_draw_request (props, tile);
+
+	if (!draw_now) {
+		queue_draw_request (request);
+		return boost::shared_ptr<WaveViewImage> ();
+	}
+
+	process_draw_request (request);
+
+	if (!request->finished ()) {
+		return boost::shared_ptr<WaveViewImage> ();
+	}
+
+	get_cache_group ()->add_image (request->image);
+	return request->image;
+}
+
+void
+WaveView::cancel_request (boost::shared_ptr<WaveViewDrawRequest> const& req) const
+{
+	req->cancel ();
+
+	if (!req->finished ()) {
+		/* other WaveViews waiting for this image will request it again */
+		get_cache_group ()->remove_image (req->image);
+	}
+}
+
+void
+WaveView::cancel_stale_requests () const
+{
+	if (_requests.empty ()) {
+		return;
+	}
+
+	/* tiles that are visible now, nothing if the WaveView is off-screen */
+	int64_t first = 0;
+	int64_t last  = -1;
+
+	Rect self_rect;
+	Rect visible_rect;
+
+	if (get_item_and_draw_rect_in_window_coords (_canvas->visible_area (), self_rect, visible_rect)) {
+		WaveViewProperties visible_props = *_props;
+		visible_props.set_sample_positions_from_pixel_offsets (visible_rect.x0 - self_rect.x0,
+		                                                       visible_rect.x1 - self_rect.x0);
+		if (visible_props.is_valid ()) {
+			tile_range (visible_props, first, last);
 		}
 	}
 
-	boost::shared_ptr<WaveViewDrawRequest> request = create_draw_request (required_props);
+	for (DrawRequests::iterator i = _requests.begin (); i != _requests.end ();) {
+		boost::shared_ptr<WaveViewDrawRequest> req = *i;
+
+		if (req->stopped () || req->finished ()) {
+			i = _requests.erase (i);
+			continue;
+		}
+
+		int64_t const tile = req->image->tile;
 
-	queue_draw_request (request);
+		if (tile < first || tile > last || !req->image->props.is_equivalent (tile_properties (tile))) {
+			// Tile scrolled out of view, or zoom/height/etc changed
+			cancel_request (req);
+			i = _requests.erase (i);
+			continue;
+		}
+
+		++i;
+	}
 }
 
 bool
@@ -338,30 +483,14 @@ WaveView::queue_draw_request (boost::shared_ptr<WaveViewDrawRequest> const& requ
 		return;
 	}
 
-	if (current_request) {
-		current_request->cancel ();
-	}
-
-	boost::shared_ptr<WaveViewImage> cached_image =
-	    get_cache_group ()->lookup_image (request->image->props);
-
-	if (cached_image) {
-		// The image may not be finished at this point but that is fine, great in
-		// fact as it means it should only need to be drawn once.
-		request->image = cached_image;
-		current_request = request;
-	} else {
-		// now we can finally set an optimal image now that we are not using the
-		// properties for comparisons.
-		request->image->props.set_width_samples (optimal_image_width_samples ());
+	request->image->request = request;
 
-		current_request = request;
+	// Add it to the cache so that other WaveViews can refer to the same image
+	get_cache_group()->add_image (request->image);
 
-		// Add it to the cache so that other WaveViews can refer to the same image
-		get_cache_group()->add_image (current_request->image);
+	_requests.push_back (request);
 
-		WaveViewThreads::enqueue_draw_request (current_request);
-	}
+	WaveViewThreads::enqueue_draw_request (_requests.back ());
 }
 
 void
@@ -797,80 +926,6 @@ WaveView::draw_image (Cairo::RefPtr<Cairo::ImageSurface>& image, PeakData* peaks
 	context->fill ();
 }
 
-samplecnt_t
-WaveView::optimal_image_width_samples () const
-{
-	/* Compute how wide the image should be in samples.
-	 *
-	 * The resulting image should be wider than the canvas width so that the
-	 * image does not have to be redrawn each time the canvas offset changes, but
-	 * drawing too much unnecessarily, for instance when zooming into the canvas
-	 * the part of the image that is outside of the visible canvas area may never
-	 * be displayed and will just increase apparent render time and reduce
-	 * responsiveness in non-threaded rendering and cause "flashing" waveforms in
-	 * threaded rendering mode.
-	 *
-	 * Another thing to consider is that if there are a number of waveforms on
-	 * the canvas that are the width of the canvas then we don't want to have to
-	 * draw the images for them all at once as it will cause a spike in render
-	 * time, or in threaded rendering mode it will mean all the draw requests will
-	 * the queued during the same sample/expose event. This issue can be
-	 * alleviated by using an element of randomness in selecting the image width.
-	 *
-	 * If the value of samples per pixel is less than 1/10th of a second, use
-	 * 1/10th of a second instead.
-	 */
-
-	samplecnt_t canvas_width_samples = _canvas->visible_area().width() * _props->samples_per_pixel;
-	const samplecnt_t one_tenth_of_second = _region->session().sample_rate() / 10;
-
-	/* If zoomed in where a canvas item interects with the canvas area but
-	 * stretches for many pages either side, to avoid having draw all images when
-	 * the canvas scrolls by a page width the multiplier would have to be a
-	 * randomized amount centered around 3 times the visible canvas width, but
-	 * for other operations like zooming or even with a stationary playhead it is
-	 * a lot of extra drawing that can affect performance.
-	 *
-	 * So without making things too complicated with different widths for
-	 * different operations, try to use a width that is a balance and will work
-	 * well for scrolling(non-page width) so all the images aren't redrawn at the
-	 * same time but also faster for sequential zooming operations.
-	 *
-	 * Canvas items that don't intersect with the edges of the visible canvas
-	 * will of course only draw images that are the pixel width of the item.
-	 *
-	 * It is a perhaps a coincidence that these values are centered roughly
-	 * around the golden ratio but they did work well in my testing.
-	 */
-	const double min_multiplier = 1.4;
-	const double max_multiplier = 1.8;
-
-	/**
-	 * A combination of high resolution screens, high samplerates and high
-	 * zoom levels(1 sample per pixel) can cause 1/10 of a second(in
-	 * pixels) to exceed the cairo image size limit.
-	 */
-	const double cairo_image_limit = 32767.0;
-	const double max_image_width = cairo_image_limit / max_multiplier;
-
-	samplecnt_t max_width_samples = floor (max_image_width / _props->samples_per_pixel);
-
-	const samplecnt_t one_tenth_of_second_limited = std::min (one_tenth_of_second, max_width_samples);
-
-	samplecnt_t new_sample_count = std::max (canvas_width_samples, one_tenth_of_second_limited);
-
-	const double multiplier = g_random_double_range (min_multiplier, max_multiplier);
-
-	return new_sample_count * multiplier;
-}
-
-void
-WaveView::set_image (boost::shared_ptr<WaveViewImage> img) const
-{
-	get_cache_group ()->add_image (img);
-	_image = img;
-}
-
 void
 WaveView::process_draw_request (boost::shared_ptr<WaveViewDrawRequest> req)
 {
@@ -999,141 +1054,80 @@ WaveView::render (Rect const & area, Cairo::RefPtr<Cairo::Context> context) cons
 
 	assert (required_props.is_valid());
 
-	boost::shared_ptr<WaveViewImage> image_to_draw;
-
-	if (current_request) {
-		if (!current_request->image->props.is_equivalent (required_props)) {
-			// The WaveView properties may have been updated during recording between
-			// prepare_for_render and render calls and the new required props have
-			// different end sample value.
-			current_request->cancel ();
-			current_request.reset ();
-		} else if (current_request->finished ()) {
-			image_to_draw = current_request->image;
-			current_request.reset ();
-		}
-	} else {
-		// No current Request
-	}
-
-	if (!image_to_draw && _image) {
-		if (_image->props.is_equivalent (required_props)) {
-			// Image contains required properties
-			image_to_draw = _image;
-		} else {
-			// Image does not contain properties required
-		}
-	}
-
-	if (!image_to_draw) {
-		image_to_draw = get_cache_group ()->lookup_image (required_props);
-		if (image_to_draw && !image_to_draw->finished ()) {
-			// Found equivalent but unfinished Image in cache
-			image_to_draw.reset ();
-		}
-	}
-
-	if (!image_to_draw) {
-		// No existing image to draw
-
-		boost::shared_ptr<WaveViewDrawRequest> const request = create_draw_request (required_props);
-
-		if (draw_image_in_gui_thread ()) {
-			// now that we have to draw something, draw more than required.
-			request->image->props.set_width_samples (optimal_image_width_samples ());
+	int64_t first;
+	int64_t last;
 
-			process_draw_request (request);
+	tile_range (required_props, first, last);
 
-			image_to_draw = request->image;
+	Images images;
+	bool   missing = false;
 
-		} else if (current_request) {
-			if (current_request->finished ()) {
-				// There is a chance the request is now finished since checking above
-				image_to_draw = current_request->image;
-				current_request.reset ();
-			} else if (_canvas->get_microseconds_since_render_start () < 15000) {
-				current_request->cancel ();
-				current_request.reset ();
+	for (int64_t tile = first; tile <= last; ++tile) {
 
-				// Drawing image in GUI thread as we have time
-
-				// now that we have to draw something, draw more than required.
-				request->image->props.set_width_samples (optimal_image_width_samples ());
+		/* Draw a missing image in the GUI thread if we have to, or if
+		 * there is time. Otherwise defer the rendering to another
+		 * thread or perhaps render pass if a thread cannot generate it
+		 * in time.
+		 */
+		bool const draw_now = draw_image_in_gui_thread () || _canvas->get_microseconds_since_render_start () < 15000;
 
-				process_draw_request (request);
+		boost::shared_ptr<WaveViewImage> image = get_image (tile_properties (tile), tile, draw_now);
 
-				image_to_draw = request->image;
-			} else {
-				// Waiting for current request to finish
-				redraw ();
-				return;
-			}
-		} else {
-			// Defer the rendering to another thread or perhaps render pass if
-			// a thread cannot generate it in time.
-			queue_draw_request (request);
-			redraw ();
-			return;
+		if (!image) {
+			missing = true;
+			continue;
 		}
-	}
 
-	/* reset this so that future missing images can be generated in a worker thread. */
-	_draw_image_in_gui_thread = false;
+		images.push_back (image);
 
-	assert (image_to_draw);
-
-	/* compute the first pixel of the image that should be used when we
-	 * render the specified range.
-	 */
+		/* compute the first pixel of the image relative to the region
+		 * start, and round the position to an exact pixel in device
+		 * space to avoid blurring
+		 */
 
-	double image_origin_in_self_coordinates =
-	    (image_to_draw->props.get_sample_start () - _props->region_start) / _props->samples_per_pixel;
+		double const image_origin_in_self_coordinates =
+		    (image->props.get_sample_start () - _props->region_start) / _props->samples_per_pixel;
 
-	/* the image may only be a best-effort ... it may not span the entire
-	 * range requested, though it is guaranteed to cover the start. So
-	 * determine how many pixels we can actually draw.
-	 */
+		double x  = self.x0 + image_origin_in_self_coordinates;
+		double y  = self.y0;
+		context->user_to_device (x, y);
+		x = floor (x);
+		y = floor (y);
+		context->device_to_user (x, y);
 
-	const double draw_start_pixel = draw.x0;
-	const double draw_end_pixel = draw.x1;
+		/* only fill the part of the requested area that the image covers */
 
-	double draw_width_pixels = draw_end_pixel - draw_start_pixel;
+		double const x0 = max (draw.x0, x);
+		double const x1 = min (draw.x1, x + image->cairo_image->get_width ());
 
-	if (image_to_draw != _image) {
+		if (x1 <= x0) {
+			continue;
+		}
 
-		/* the image is guaranteed to start at or before
-		 * draw_start. But if it starts before draw_start, that reduces
-		 * the maximum available width we can render with.
-		 *
-		 * so .. clamp the draw width to the smaller of what we need to
-		 * draw or the available width of the image.
+		/* the coordinates specify where in "user coordinates" (i.e. what we
+		 * generally call "canvas coordinates" in this code) the image origin
+		 * will appear. So specifying (10,10) will put the upper left corner of
+		 * the image at (10,10) in user space.
 		 */
-		draw_width_pixels = min ((double)image_to_draw->cairo_image->get_width (), draw_width_pixels);
 
-		set_image (image_to_draw);
+		context->rectangle (x0, draw.y0, x1 - x0, draw.height());
+		context->set_source (image->cairo_image, x, y);
+		context->fill ();
 	}
 
-	context->rectangle (draw_start_pixel, draw.y0, draw_width_pixels, draw.height());
+	if (!images.empty ()) {
+		_images.swap (images);
+	}
 
-	/* round image origin position to an exact pixel in device space to
-	 * avoid blurring
-	 */
+	/* reset this so that future missing images can be generated in a worker thread. */
+	_draw_image_in_gui_thread = false;
 
-	double x  = self.x0 + image_origin_in_self_coordinates;
-	double y  = self.y0;
-	context->user_to_device (x, y);
-	x = floor (x);
-	y = floor (y);
-	context->device_to_user (x, y);
-
-	/* the coordinates specify where in "user coordinates" (i.e. what we
-	 * generally call "canvas coordinates" in this code) the image origin
-	 * will appear. So specifying (10,10) will put the upper left corner of
-	 * the image at (10,10) in user space.
-	 */
+	cancel_stale_requests ();
 
-	context->set_source (image_to_draw->cairo_image, x, y);
-	context->fill ();
+	if (missing) {
+		// Waiting for worker threads to draw the remaining tiles
+		redraw ();
+	}
 }
 
 void
@@ -1340,6 +1334,43 @@ WaveView::region_resized ()
 	end_change ();
 }
 
+void
+WaveView::peaks_changed (samplepos_t start, samplecnt_t cnt)
+{
+	if (!_region || cnt <= 0) {
+		return;
+	}
+
+	samplepos_t const end = start + cnt;
+
+	/* images are shared with all other WaveViews of the source, and
+	 * may be drawn in a worker thread right now.
+	 */
+	get_cache_group ()->invalidate (start, end);
+
+	for (Images::iterator i = _images.begin (); i != _images.end ();) {
+		if ((*i)->props.get_sample_end () <= start || (*i)->props.get_sample_start () >= end) {
+			++i;
+		} else {
+			i = _images.erase (i);
+		}
+	}
+
+	for (DrawRequests::iterator i = _requests.begin (); i != _requests.end ();) {
+		WaveViewProperties const& props ((*i)->image->props);
+		if (props.get_sample_end () <= start || props.get_sample_start () >= end) {
+			++i;
+		} else {
+			(*i)->cancel ();
+			i = _requests.erase (i);
+		}
+	}
+
+	if (end > _props->region_start && start < _props->region_end) {
+		redraw ();
+	}
+}
+
 void
 WaveView::set_global_gradient_depth (double depth)
 {
@@ -56,10 +56,11 @@ WaveViewProperties::WaveViewProperties (boost::shared_ptr<ARDOUR::AudioRegion> r
 /*-------------------------------------------------*/
 
 WaveViewImage::WaveViewImage (boost::shared_ptr<const ARDOUR::AudioRegion> const& region_ptr,
-                              WaveViewProperties const& properties)
+                              WaveViewProperties const& properties, int64_t tile_index)
 	: region (region_ptr)
 	, props (properties)
-	, timestamp (0)
+	, tile (tile_index)
+	, group (0)
 {
 
 }
@@ -90,73 +91,87 @@ WaveViewCacheGroup::add_image (boost::shared_ptr<WaveViewImage> image)
 		return;
 	}
 
-	ImageCache::iterator oldest_image_it = _cached_images.begin();
-	ImageCache::iterator second_oldest_image_it = _cached_images.end();
+	if (image->group) {
+		/* an image is only ever in one group, the one of its source */
+		assert (image->group == this);
+		_parent_cache.touch_image (image);
+		return;
+	}
 
-	for (ImageCache::iterator it = _cached_images.begin (); it != _cached_images.end (); ++it) {
-		if ((*it) == image) {
-			// Must never be more than one instance of the image in the cache
-			(*it)->timestamp = g_get_monotonic_time ();
-			return;
-		} else if ((*it)->props.is_equivalent (image->props)) {
-			// Equivalent Image already in cache, updating timestamp
-			(*it)->timestamp = g_get_monotonic_time ();
-			return;
-		}
+	_cached_images.insert (std::make_pair (std::make_pair (image->props.samples_per_pixel, image->tile), image));
+	_parent_cache.add_image (this, image);
+}
 
-		if ((*it)->timestamp < (*oldest_image_it)->timestamp) {
-			second_oldest_image_it = oldest_image_it;
-			oldest_image_it = it;
-		}
+void
+WaveViewCacheGroup::remove_image (boost::shared_ptr<WaveViewImage> image)
+{
+	if (!image || image->group != this) {
+		return;
 	}
 
-	// no duplicate or equivalent image so we are definitely adding it to cache
-	image->timestamp = g_get_monotonic_time ();
+	erase (image);
+	_parent_cache.remove_image (image);
+}
 
-	if (_parent_cache.full () || full ()) {
-		if (oldest_image_it != _cached_images.end()) {
-			// Replacing oldest Image in cache
-			_parent_cache.decrease_size ((*oldest_image_it)->size_in_bytes ());
-			*oldest_image_it = image;
-			_parent_cache.increase_size (image->size_in_bytes ());
+void
+WaveViewCacheGroup::erase (boost::shared_ptr<WaveViewImage> const& image)
+{
+	std::pair<ImageCache::iterator, ImageCache::iterator> r =
+	    _cached_images.equal_range (std::make_pair (image->props.samples_per_pixel, image->tile));
 
-			if (second_oldest_image_it != _cached_images.end ()) {
-				// Removing second oldest Image in cache
-				_parent_cache.decrease_size ((*second_oldest_image_it)->size_in_bytes ());
-				_cached_images.erase (second_oldest_image_it);
-			}
+	for (ImageCache::iterator i = r.first; i != r.second; ++i) {
+		if (i->second == image) {
+			_cached_images.erase (i);
 			return;
-		} else {
-			/**
-			 * Add the image to the cache even if the threshold is exceeded so that
-			 * new WaveViews can still cache images with a full cache, the size of
-			 * the cache will quickly equalize back to the threshold as new images
-			 * are added and the size of the cache is reduced.
-			 */
 		}
 	}
 
-	_cached_images.push_back (image);
-	_parent_cache.increase_size (image->size_in_bytes ());
+	assert (0);
 }
 
 boost::shared_ptr<WaveViewImage>
-WaveViewCacheGroup::lookup_image (WaveViewProperties const& props)
+WaveViewCacheGroup::lookup_image (WaveViewProperties const& props, int64_t tile)
 {
-	for (ImageCache::iterator i = _cached_images.begin (); i != _cached_images.end (); ++i) {
-		if ((*i)->props.is_equivalent (props)) {
-			return (*i);
+	std::pair<ImageCache::iterator, ImageCache::iterator> r =
+	    _cached_images.equal_range (std::make_pair (props.samples_per_pixel, tile));
+
+	for (ImageCache::iterator i = r.first; i != r.second; ++i) {
+		if (i->second->props.is_equivalent (props)) {
+			return i->second;
 		}
 	}
 	return boost::shared_ptr<WaveViewImage>();
 }
 
+void
+WaveViewCacheGroup::invalidate (samplepos_t start, samplepos_t end)
+{
+	ImageCache::iterator i = _cached_images.begin ();
+
+	while (i != _cached_images.end ()) {
+		boost::shared_ptr<WaveViewImage> image = i->second;
+
+		if (image->props.get_sample_end () <= start || image->props.get_sample_start () >= end) {
+			++i;
+			continue;
+		}
+
+		boost::shared_ptr<WaveViewDrawRequest> req = image->request.lock ();
+		if (req) {
+			req->cancel ();
+		}
+
+		_cached_images.erase (i++);
+		_parent_cache.remove_image (image);
+	}
+}
+
 void
 WaveViewCacheGroup::clear_cache ()
 {
 	// Tell the parent cache about the images we are about to drop references to
 	for (ImageCache::iterator it = _cached_images.begin (); it != _cached_images.end (); ++it) {
-		_parent_cache.decrease_size ((*it)->size_in_bytes ());
+		_parent_cache.remove_image (it->second);
 	}
 	_cached_images.clear ();
 }
@@ -181,6 +196,50 @@ WaveViewCache::get_instance ()
 	return instance;
 }
 
+void
+WaveViewCache::add_image (WaveViewCacheGroup* group, boost::shared_ptr<WaveViewImage> const& image)
+{
+	image->group = group;
+	image->lru   = _lru.insert (_lru.begin (), image);
+	increase_size (image->size_in_bytes ());
+
+	evict ();
+}
+
+void
+WaveViewCache::touch_image (boost::shared_ptr<WaveViewImage> const& image)
+{
+	assert (image->group);
+	_lru.splice (_lru.begin (), _lru, image->lru);
+}
+
+void
+WaveViewCache::remove_image (boost::shared_ptr<WaveViewImage> const& image)
+{
+	assert (image->group);
+	decrease_size (image->size_in_bytes ());
+	image->group = 0;
+	/* this may drop the last reference to the image */
+	_lru.erase (image->lru);
+}
+
+void
+WaveViewCache::evict ()
+{
+	/* Drop least recently used images of any source until the cache is
+	 * within its size limit. Images that are in use by a WaveView stay
+	 * around until it drops them, but can no longer be shared.
+	 *
+	 * Never drop the image that was just added, new WaveViews can still
+	 * cache images when the threshold is very small.
+	 */
+	while (full () && _lru.size () > 1) {
+		boost::shared_ptr<WaveViewImage> image = _lru.back ();
+		image->group->erase (image);
+		remove_image (image);
+	}
+}
+
 void
 WaveViewCache::increase_size (uint64_t bytes)
 {
@@ -251,6 +310,7 @@ void
 WaveViewCache::set_image_cache_threshold (uint64_t sz)
 {
 	_image_cache_threshold = sz;
+	evict ();
 }
 
 /*-------------------------------------------------*/
@@ -329,9 +389,16 @@ WaveViewThreads::_dequeue_draw_request ()
 	 * pulled the request before we were fully awake and reacquired the mutex.
 	 */
 
-	if (!_queue.empty()) {
+	while (!_queue.empty()) {
 		req = _queue.front ();
 		_queue.pop_front ();
+
+		if (!req->stopped ()) {
+			break;
+		}
+
+		/* cancelled while queued, e.g. scrolled out of view */
+		req.reset ();
 	}
 
 	return req;
@@ -344,12 +411,12 @@ WaveViewThreads::start_threads ()
 
 	const int num_cpus = hardware_concurrency ();
 
-	/* the upper limit of 8 here is entirely arbitrary. It just doesn't
-	 * seem worthwhile having "ncpus" of low priority threads for
-	 * rendering waveforms into the cache.
+	/* leave one core for the GUI thread. Requests are for small tiles,
+	 * so more threads keep up with scrolling large sessions. The upper
+	 * limit is arbitrary.
 	 */
 
-	uint32_t num_threads = std::min (8, std::max (1, num_cpus - 1));
+	uint32_t num_threads = std::min (16, std::max (1, num_cpus - 1));
 
 	for (uint32_t i = 0; i != num_threads; ++i) {
 		boost::shared_ptr<WaveViewDrawingThread> new_thread (new WaveViewDrawingThread ());
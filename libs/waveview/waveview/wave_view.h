@@ -21,6 +21,9 @@
 #ifndef _WAVEVIEW_WAVE_VIEW_H_
 #define _WAVEVIEW_WAVE_VIEW_H_
 
+#include <list>
+#include <vector>
+
 #include <boost/shared_ptr.hpp>
 #include <boost/scoped_ptr.hpp>
 
@@ -65,11 +68,13 @@ public:
 	   when drawing, we will map the zeroth-pixel of the waveview
 	   into a window.
 
-	   The waveview itself contains a set of pre-rendered Cairo::ImageSurfaces
-	   that cache sections of the display. This is filled on-demand and
-	   never cleared until something explicitly marks the cache invalid
-	   (such as a change in samples_per_pixel, the log scaling, rectified or
-	   other view parameters).
+	   The display is composed of pre-rendered Cairo::ImageSurfaces of
+	   fixed width tiles, aligned to the source data, which are shared
+	   with all other WaveViews of the same source. Tiles are drawn
+	   on-demand (mostly by worker threads) and kept in a cache until
+	   it reaches its size limit, or something explicitly marks the
+	   cache invalid (such as a change in the log scaling, rectified or
+	   other global view parameters).
 	*/
 
 	WaveView (ArdourCanvas::Canvas*, boost::shared_ptr<ARDOUR::AudioRegion>);
@@ -102,6 +107,11 @@ public:
 	void region_resized ();
 	void gain_changed ();
 
+	/** Drop the images of source samples [start, start + cnt) and redraw
+	 * them, e.g. while the peakfile of the source is being built.
+	 */
+	void peaks_changed (ARDOUR::samplepos_t start, ARDOUR::samplecnt_t cnt);
+
 	void set_show_zero_line (bool);
 	bool show_zero_line () const;
 
@@ -165,7 +175,11 @@ private:
 
 	boost::scoped_ptr<WaveViewProperties> _props;
 
-	mutable boost::shared_ptr<WaveViewImage> _image;
+	typedef std::vector<boost::shared_ptr<WaveViewImage> > Images;
+	typedef std::list<boost::shared_ptr<WaveViewDrawRequest> > DrawRequests;
+
+	/** tiles used by the last render() */
+	mutable Images _images;
 
 	mutable boost::shared_ptr<WaveViewCacheGroup> _cache_group;
 
@@ -186,9 +200,9 @@ private:
 	ARDOUR::samplepos_t region_end () const;
 
 	/**
-	 * _image stays non-null after the first time it is set
+	 * _images stays non-empty after the first time it is set
 	 */
-	bool rendered () const { return _image.get(); }
+	bool rendered () const { return !_images.empty (); }
 
 	bool draw_image_in_gui_thread () const;
 
@@ -205,7 +219,8 @@ private:
 
 	void init();
 
-	mutable boost::shared_ptr<WaveViewDrawRequest> current_request;
+	/** requests for tiles that are being drawn in a worker thread */
+	mutable DrawRequests _requests;
 
 	PBD::ScopedConnectionList invalidation_connection;
 
@@ -238,16 +253,27 @@ private:
 	                        boost::shared_ptr<WaveViewDrawRequest>);
 	static void draw_absent_image (Cairo::RefPtr<Cairo::ImageSurface>&, ARDOUR::PeakData*, int);
 
-	ARDOUR::samplecnt_t optimal_image_width_samples () const;
+	/** find the tiles covering the samples of @p props */
+	void tile_range (WaveViewProperties const& props, int64_t& first, int64_t& last) const;
+	WaveViewProperties tile_properties (int64_t tile) const;
+
+	/** @return the (finished) image of a tile, or null if it is not
+	 * available yet. If @p draw_now is true, a missing image is drawn in
+	 * the calling thread, otherwise it is requested from a worker thread.
+	 */
+	boost::shared_ptr<WaveViewImage> get_image (WaveViewProperties const&, int64_t tile, bool draw_now) const;
+	boost::shared_ptr<WaveViewImage> lookup_image (WaveViewProperties const&, int64_t tile) const;
 
-	void set_image (boost::shared_ptr<WaveViewImage> img) const;
+	/** cancel requests for tiles that are no longer visible or needed */
+	void cancel_stale_requests () const;
+	void cancel_request (boost::shared_ptr<WaveViewDrawRequest> const&) const;
 
 	// @return true if item area intersects with draw area
 	bool get_item_and_draw_rect_in_window_coords (ArdourCanvas::Rect const& canvas_rect,
 	                                              ArdourCanvas::Rect& item_area,
 	                                              ArdourCanvas::Rect& draw_rect) const;
 
-	boost::shared_ptr<WaveViewDrawRequest> create_draw_request (WaveViewProperties const&) const;
+	boost::shared_ptr<WaveViewDrawRequest> create_draw_request (WaveViewProperties const&, int64_t tile) const;
 
 	void queue_draw_request (boost::shared_ptr<WaveViewDrawRequest> const&) const;
 
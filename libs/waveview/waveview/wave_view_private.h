@@ -20,6 +20,8 @@
 #define _WAVEVIEW_WAVE_VIEW_PRIVATE_H_
 
 #include <deque>
+#include <list>
+#include <map>
 
 #include "pbd/pthread_utils.h"
 #include "waveview/wave_view.h"
@@ -164,18 +166,38 @@ public: // methods
 	}
 };
 
+struct WaveViewDrawRequest;
+class WaveViewCacheGroup;
+
+/* A tile of a waveform, the image of the samples
+ * [tile * tile_width * spp, (tile + 1) * tile_width * spp)
+ * of a source, limited to the bounds of the region it is drawn for.
+ */
 struct WaveViewImage {
 public: // ctors
 	WaveViewImage (boost::shared_ptr<const ARDOUR::AudioRegion> const& region_ptr,
-	               WaveViewProperties const& properties);
+	               WaveViewProperties const& properties, int64_t tile);
 
 	~WaveViewImage ();
 
+	static const int tile_width = 256; // pixels
+
 public: // member variables
 	boost::weak_ptr<const ARDOUR::AudioRegion> region;
 	WaveViewProperties props;
+	int64_t tile;
 	Cairo::RefPtr<Cairo::ImageSurface> cairo_image;
-	uint64_t timestamp;
+
+	/** the request drawing this image, if any */
+	boost::weak_ptr<WaveViewDrawRequest> request;
+
+private:
+	friend class WaveViewCache;
+	friend class WaveViewCacheGroup;
+
+	/* set while the image is in the cache, only used by the GUI thread */
+	WaveViewCacheGroup* group;
+	std::list<boost::shared_ptr<WaveViewImage> >::iterator lru;
 
 public: // methods
 	bool finished() { return static_cast<bool>(cairo_image); }
@@ -219,6 +241,9 @@ private:
 
 class WaveViewCache;
 
+/* The images of one source. All groups share a least-recently-used
+ * list in the WaveViewCache, which limits the total size of all images.
+ */
 class WaveViewCacheGroup
 {
 public:
@@ -228,18 +253,27 @@ public:
 
 public:
 
-	// @return image with matching properties or null
-	boost::shared_ptr<WaveViewImage> lookup_image (WaveViewProperties const&);
+	/** @return image of the tile with matching properties or null.
+	 * The image may not be finished yet.
+	 */
+	boost::shared_ptr<WaveViewImage> lookup_image (WaveViewProperties const&, int64_t tile);
 
+	/** Add an image to the cache, or mark it as most recently used
+	 * if it is already cached.
+	 */
 	void add_image (boost::shared_ptr<WaveViewImage>);
 
-	bool full () const { return _cached_images.size() > max_size(); }
+	void remove_image (boost::shared_ptr<WaveViewImage>);
 
-	static uint32_t max_size () { return 16; }
+	/** Remove all images that overlap the source samples [start, end),
+	 * and stop drawing those that are not finished yet.
+	 */
+	void invalidate (samplepos_t start, samplepos_t end);
 
 	void clear_cache ();
 
 private:
+	friend class WaveViewCache;
 
 	/**
 	 * At time of writing we don't strictly need a reference to the parent cache
@@ -248,8 +282,13 @@ private:
 	 */
 	WaveViewCache& _parent_cache;
 
-	typedef std::list<boost::shared_ptr<WaveViewImage> > ImageCache;
+	/* images by samples-per-pixel and tile index. There can be several
+	 * images for a tile (different height, colors or region bounds)
+	 */
+	typedef std::multimap<std::pair<double, int64_t>, boost::shared_ptr<WaveViewImage> > ImageCache;
 	ImageCache _cached_images;
+
+	void erase (boost::shared_ptr<WaveViewImage> const&);
 };
 
 class WaveViewCache
@@ -279,9 +318,18 @@ private:
 	uint64_t image_cache_size;
 	uint64_t _image_cache_threshold;
 
+	/* images of all groups, most recently used first */
+	typedef std::list<boost::shared_ptr<WaveViewImage> > ImageLRU;
+	ImageLRU _lru;
+
 private:
 	friend class WaveViewCacheGroup;
 
+	void add_image (WaveViewCacheGroup*, boost::shared_ptr<WaveViewImage> const&);
+	void touch_image (boost::shared_ptr<WaveViewImage> const&);
+	void remove_image (boost::shared_ptr<WaveViewImage> const&);
+	void evict ();
+
 	void increase_size (uint64_t bytes);
 	void decrease_size (uint64_t bytes);
 
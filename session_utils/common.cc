@@ -131,7 +131,7 @@ SessionUtils::init (bool print_log)
 }
 
 // TODO return NULL, rather than exit() ?!
-static Session * _load_session (string dir, string state)
+static Session * _load_session (string dir, string state, uint32_t buffer_size, uint32_t n_system_ports)
 {
 	AudioEngine* engine = AudioEngine::create ();
 
@@ -140,8 +140,13 @@ static Session * _load_session (string dir, string state)
 		::exit (EXIT_FAILURE);
 	}
 
-	engine->set_input_channels (256);
-	engine->set_output_channels (256);
+	engine->set_input_channels (n_system_ports);
+	engine->set_output_channels (n_system_ports);
+
+	if (buffer_size > 0 && engine->set_buffer_size (buffer_size)) {
+		std::cerr << "Cannot set buffer-size " << buffer_size << ".\n";
+		return 0;
+	}
 
 	float sr;
 	SampleFormat sf;
@@ -175,11 +180,11 @@ static Session * _load_session (string dir, string state)
 }
 
 Session *
-SessionUtils::load_session (string dir, string state, bool exit_at_failure)
+SessionUtils::load_session (string dir, string state, bool exit_at_failure, uint32_t buffer_size, uint32_t n_system_ports)
 {
 	Session* s = 0;
 	try {
-		s = _load_session (dir, state);
+		s = _load_session (dir, state, buffer_size, n_system_ports);
 	} catch (failed_constructor& e) {
 		cerr << "failed_constructor: " << e.what() << "\n";
 		::exit (EXIT_FAILURE);
@@ -34,9 +34,12 @@ namespace SessionUtils {
 
 	/** @param dir Session directory.
 	 *  @param state Session state file, without .ardour suffix.
+	 *  @param buffer_size engine buffer-size (samples per cycle), 0: backend default
+	 *  @param n_system_ports number of system input and output ports to register, 0: backend default
 	 *  @returns an ardour session object (free with \ref unload_session) or NULL
 	 */
-	ARDOUR::Session* load_session (std::string dir, std::string state, bool exit_at_failure = true);
+	ARDOUR::Session* load_session (std::string dir, std::string state, bool exit_at_failure = true,
+	                               uint32_t buffer_size = 0, uint32_t n_system_ports = 256);
 
 	/** @param dir Session directory.
 	 *  @param state Session state file, without .ardour suffix.
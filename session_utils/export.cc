@@ -16,8 +16,10 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
 #include <iostream>
 #include <cstdlib>
+#include <inttypes.h>
 #include <getopt.h>
 #include <glibmm.h>
 
@@ -25,6 +27,7 @@
 
 #include "pbd/basename.h"
 #include "pbd/enumwriter.h"
+#include "pbd/microseconds.h"
 
 #include "ardour/broadcast_info.h"
 #include "ardour/export_handler.h"
@@ -33,6 +36,7 @@
 #include "ardour/export_channel_configuration.h"
 #include "ardour/export_format_specification.h"
 #include "ardour/export_filename.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/route.h"
 #include "ardour/session_metadata.h"
 #include "ardour/broadcast_info.h"
@@ -50,6 +54,8 @@ struct ExportSettings
 		, _sample_format (ExportFormatBase::SF_16)
 		, _normalize (false)
 		, _bwf (false)
+		, _buffer_size (8192)
+		, _threads (0)
 	{}
 
 	std::string samplerate () const
@@ -78,6 +84,8 @@ struct ExportSettings
 	ExportFormatBase::SampleFormat _sample_format;
 	bool _normalize;
 	bool _bwf;
+	uint32_t _buffer_size;
+	int _threads;
 };
 
 static int export_session (Session *session,
@@ -179,6 +187,8 @@ static int export_session (Session *session,
 	fmp->set_soundcloud_upload(false);
 	session->get_export_handler()->add_export_config (tsp, ccp, fmp, fnp, b);
 
+	const PBD::microseconds_t t0 = PBD::get_microseconds ();
+
 	if (0 != session->get_export_handler()->do_export()) {
 		return -1;
 	}
@@ -187,7 +197,13 @@ static int export_session (Session *session,
 
 	// TODO trap SIGINT -> status->abort();
 
+	int n_polls = 0;
 	while (status->running ()) {
+		/* poll often, a short session is rendered in a fraction of a second */
+		Glib::usleep (50000);
+		if (++n_polls % 20) {
+			continue;
+		}
 		double progress = 0.0;
 		switch (status->active_job) {
 		case ExportStatus::Normalizing:
@@ -202,13 +218,23 @@ static int export_session (Session *session,
 			printf ("* Exporting...            \r");
 			break;
 		}
-		Glib::usleep (1000000);
 	}
 	printf("\n");
 
+	const PBD::microseconds_t t1 = PBD::get_microseconds ();
+
 	status->finish (TRS_UI);
 
-	printf ("* Done.\n");
+	if (status->aborted ()) {
+		printf ("* Export failed.\n");
+		return -1;
+	}
+
+	const double elapsed = std::max<PBD::microseconds_t> (1, t1 - t0) * 1e-6;
+	const double rate    = (end - start) / elapsed;
+
+	printf ("* Done. Rendered %" PRId64 " samples in %.2f sec: %.0f samples/sec (%.1fx realtime)\n",
+	        (int64_t) (end - start), elapsed, rate, rate / session->nominal_sample_rate ());
 	return 0;
 }
 
@@ -219,10 +245,12 @@ static void usage () {
 	printf ("Options:\n\
   -b, --bitdepth <depth>     set export-format (16, 24, 32, float)\n\
   -B, --broadcast            include broadcast wave header\n\
+  -c, --cycle-size <n>       process n samples per cycle (default 8192)\n\
   -h, --help                 display this help and exit\n\
   -n, --normalize            normalize signal level (to 0dBFS)\n\
   -o, --output  <file>       export output file name\n\
   -s, --samplerate <rate>    samplerate to use\n\
+  -t, --threads <n>          number of DSP threads (default: preferences)\n\
   -V, --version              print version information and exit\n\
 \n");
 	printf ("\n\
@@ -231,6 +259,10 @@ using the master-bus outputs.\n\
 By default a 16bit signed .wav file at session-rate is exported.\n\
 If the no output-file is given, the session's export dir is used.\n\
 \n\
+The session is rendered faster than realtime, without sound card and\n\
+with a single system input and output port. Large cycle sizes reduce\n\
+per-cycle overhead.\n\
+\n\
 Note: the tool expects a session-name without .ardour file-name extension.\n\
 \n");
 
@@ -244,15 +276,17 @@ int main (int argc, char* argv[])
 	ExportSettings settings;
 	std::string outfile;
 
-	const char *optstring = "b:Bhno:s:V";
+	const char *optstring = "b:Bc:hno:s:t:V";
 
 	const struct option longopts[] = {
 		{ "bitdepth",   1, 0, 'b' },
 		{ "broadcast",  0, 0, 'B' },
+		{ "cycle-size", 1, 0, 'c' },
 		{ "help",       0, 0, 'h' },
 		{ "normalize",  0, 0, 'n' },
 		{ "output",     1, 0, 'o' },
 		{ "samplerate", 1, 0, 's' },
+		{ "threads",    1, 0, 't' },
 		{ "version",    0, 0, 'V' },
 	};
 
@@ -288,6 +322,17 @@ int main (int argc, char* argv[])
 				settings._bwf = true;
 				break;
 
+			case 'c':
+				{
+					const int bs = atoi (optarg);
+					if (bs >= 16 && bs <= 8192) {
+						settings._buffer_size = bs;
+					} else {
+						fprintf(stderr, "Invalid Cycle Size\n");
+					}
+				}
+				break;
+
 			case 'n':
 				settings._normalize = true;
 				break;
@@ -307,6 +352,17 @@ int main (int argc, char* argv[])
 				}
 				break;
 
+			case 't':
+				{
+					const int nt = atoi (optarg);
+					if (nt >= 1 && nt <= 256) {
+						settings._threads = nt;
+					} else {
+						fprintf(stderr, "Invalid number of threads\n");
+					}
+				}
+				break;
+
 			case 'V':
 				printf ("ardour-utils version %s\n\n", VERSIONSTRING);
 				printf ("Copyright (C) GPL 2015,2017 Robin Gareus <robin@gareus.org>\n");
@@ -332,16 +388,24 @@ int main (int argc, char* argv[])
 	SessionUtils::init(false);
 	Session* s = 0;
 
-	s = SessionUtils::load_session (argv[optind], argv[optind+1]);
+	if (settings._threads > 0) {
+		/* size of the process-graph thread-pool */
+		Config->set_processor_usage (settings._threads);
+	}
+
+	/* System ports are not needed, the master-bus output is exported.
+	 * Use the minimum, the dummy backend falls back to 8 ports for 0.
+	 */
+	s = SessionUtils::load_session (argv[optind], argv[optind+1], true, settings._buffer_size, 1);
 
 	if (settings._samplerate == 0) {
 		settings._samplerate = s->nominal_sample_rate ();
 	}
 
-	export_session (s, outfile, settings);
+	const int rv = export_session (s, outfile, settings);
 
 	SessionUtils::unload_session(s);
 	SessionUtils::cleanup();
 
-	return 0;
+	return rv == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -0,0 +1,23 @@
+ardour { ["type"] = "Snippet", name = "Processor DSP timing",
+	license     = "MIT",
+	author      = "Ardour Team",
+	description = [[Print the 20 most expensive processors, sorted by the 99th percentile of their per-cycle DSP time. Collection is enabled when the script is run for the first time; run it again after some time to see the results.]]
+}
+
+function factory () return function ()
+
+	if not Session:processor_timing_enabled () then
+		Session:set_processor_timing_enabled (true)
+		print ("Processor timing enabled, collecting data...")
+		return
+	end
+
+	for proc in Session:processors_by_dsp_load (20):iter () do
+		local rv, stats = proc:get_dsp_timing (0, 0, 0, 0)
+		if rv then
+			print (string.format (" * %-28s | min: %.3f avg: %.3f p99: %.3f max: %.3f [ms]",
+				string.sub (proc:name (), 0, 28),
+				stats[1] / 1000.0, stats[2] / 1000.0, stats[3] / 1000.0, stats[4] / 1000.0))
+		end
+	end
+end end
@@ -0,0 +1,96 @@
+-- cd gtk2_ardour; ./arlua < ../tools/butler_refill_benchmark.lua
+
+-- This script creates some tracks, records noise, and then
+-- measures the time it takes the butler to refill all playback
+-- buffers after a locate, for various numbers of butler threads
+-- (Preferences > Performance > Disk I/O threads).
+--
+-- For meaningful results with large sessions, drop the page cache
+-- before each run (echo 3 > /proc/sys/vm/drop_caches) or use more
+-- recorded data than fits into memory.
+
+reclen   = 60 -- seconds to record
+n_tracks = 64 -- number of tracks to create
+n_locate = 20 -- locates per measurement
+threads  = { 1, 2, 4, 8 }
+
+backend = AudioEngine:set_backend("None (Dummy)", "", "")
+backend:set_device_name ("Uniform White Noise")
+
+os.execute('rm -rf /tmp/luabench')
+s = create_session ("/tmp/luabench", "luabench", 48000)
+assert (s)
+
+s:new_audio_track (1, 2, nil, n_tracks, "",  ARDOUR.PresentationInfo.max_order, ARDOUR.TrackMode.Normal, true)
+
+for t in s:get_tracks():iter() do
+	t:rec_enable_control():set_value(1, PBD.GroupControlDisposition.UseGroup)
+end
+
+ARDOUR.LuaAPI.usleep (100000)
+
+s:goto_start()
+s:maybe_enable_record()
+
+s:request_roll (ARDOUR.TransportRequestSource.TRS_UI)
+ARDOUR.LuaAPI.usleep (1000000 * reclen)
+s:request_stop (false, false, ARDOUR.TransportRequestSource.TRS_UI);
+
+for t in s:get_tracks():iter() do
+	t:rec_enable_control():set_value(0, PBD.GroupControlDisposition.UseGroup)
+end
+
+ARDOUR.LuaAPI.usleep (100000)
+
+s:goto_start()
+s:save_state("")
+
+function min_buffer_load ()
+	local load = 1
+	for t in s:get_tracks():iter() do
+		load = math.min (load, t:playback_buffer_load ())
+	end
+	return load
+end
+
+-- locate to pos and return the time [ms] until all playback buffers are full
+function locate_and_refill (pos)
+	local t_start = ARDOUR.LuaAPI.monotonic_time ()
+	s:request_locate (pos, ARDOUR.LocateTransportDisposition.MustStop, ARDOUR.TransportRequestSource.TRS_UI)
+
+	-- wait for the locate to complete
+	while s:transport_sample () ~= pos do
+		ARDOUR.LuaAPI.usleep (1000)
+	end
+
+	while min_buffer_load () < .99 do
+		ARDOUR.LuaAPI.usleep (1000)
+	end
+	return (ARDOUR.LuaAPI.monotonic_time () - t_start) / 1000
+end
+
+local sr = s:nominal_sample_rate ()
+math.randomseed (0)
+
+for _, n in ipairs (threads) do
+	ARDOUR.config():set_butler_threads (n)
+	ARDOUR.LuaAPI.usleep (500000)
+
+	local t_min = math.huge
+	local t_max = 0
+	local t_sum = 0
+	for i = 1, n_locate do
+		-- locate far enough to not be able to use the buffered data
+		local pos = math.floor (math.random () * (reclen - 10) * sr)
+		local dt = locate_and_refill (pos)
+		t_min = math.min (t_min, dt)
+		t_max = math.max (t_max, dt)
+		t_sum = t_sum + dt
+	end
+	print (string.format ("butler threads: %2d tracks: %d refill after locate [ms]: min: %.1f avg: %.1f max: %.1f",
+	                      n, n_tracks, t_min, t_sum / n_locate, t_max))
+	collectgarbage ()
+end
+
+close_session()
+quit()
@@ -0,0 +1,43 @@
+-- cd gtk2_ardour; ./arlua ../tools/engine_benchmark.lua <session-dir> <snapshot> [cycles] [csv-file]
+
+-- This script loads a session with the Dummy backend, starts the
+-- transport and processes a fixed number of cycles as fast as
+-- possible. It prints wall-clock and CPU time statistics per cycle,
+-- and a histogram of the DSP load. Optionally the per-cycle timings
+-- are written to a CSV file, e.g. to compare builds.
+--
+-- The same can be done with `hardour --benchmark <cycles> DIR SNAPSHOT`
+
+dir      = arg[1]
+snapshot = arg[2]
+n_cycles = tonumber (arg[3] or 10000)
+csv      = arg[4]
+
+assert (dir and snapshot, "usage: engine_benchmark.lua <session-dir> <snapshot> [cycles] [csv-file]")
+
+backend = AudioEngine:set_backend("None (Dummy)", "", "")
+assert (backend)
+
+s = load_session (dir, snapshot)
+assert (s)
+
+s:goto_start()
+s:request_roll (ARDOUR.TransportRequestSource.TRS_UI)
+ARDOUR.LuaAPI.usleep (100000)
+
+assert (backend:start_benchmark (n_cycles) == 0)
+
+while backend:benchmark_running () do
+	ARDOUR.LuaAPI.usleep (100000)
+end
+
+s:request_stop (false, false, ARDOUR.TransportRequestSource.TRS_UI);
+
+print (backend:benchmark_report ())
+
+if csv then
+	assert (backend:write_benchmark_data (csv) == 0)
+end
+
+close_session ()
+quit ()
@@ -0,0 +1,78 @@
+#!/bin/bash
+
+# Compare serial (1 thread) and parallel disk I/O with ARDOUR::IOTaskList,
+# for each given number of threads, e.g.
+#   ./run-iotask-test.sh -d /mnt/nvme 1 2 4 8 16
+#
+# This uses the io_tasklist profiling tool, which is built with
+# ./waf configure --test
+
+TOP=`dirname "$0"`/..
+. $TOP/build/gtk2_ardour/ardev_common_waf.sh
+bin=$TOP/build/libs/ardour/io_tasklist
+
+dir=/tmp
+filesize=100 # megabytes
+numfiles=128
+blocksize=262144
+needfiles=1
+args=
+
+if uname -a | grep --silent arwin ; then
+    ddmega=m
+else
+    ddmega=M
+fi
+
+while [ $# -gt 1 ] ; do
+    case $1 in
+	-d) dir=$2; shift; shift ;;
+	-f) filesize=$2; shift; shift ;;
+	-n) numfiles=$2; shift; shift ;;
+	-b) blocksize=$2; shift; shift ;;
+	-w) args="$args -w"; shift ;;
+	-s) args="$args -s"; shift ;;
+        *) break ;;
+    esac
+done
+
+if [ -d $dir -a -f $dir/testfile_1 ] ; then
+    # dir exists and has a testfile within it - reuse to avoid
+    # recreating files
+    echo "# Re-using files in $dir"
+    needfiles=
+else
+    dir=$dir/iotasktest_$$
+    mkdir $dir
+
+    if [ $? != 0 ] ; then
+	echo "Cannot create testfile directory $dir"
+	exit 1
+    fi
+fi
+
+if [ x$needfiles != x ] ; then
+    echo "# Building files for test..."
+    for i in `seq 1 $numfiles` ; do
+	dd of=$dir/testfile_$i if=/dev/zero bs=1$ddmega count=$filesize >/dev/null 2>&1
+    done
+fi
+
+rounds=`expr $filesize \* 1048576 / $blocksize`
+
+for nt in $@ ; do
+
+    if uname -a | grep --silent arwin ; then
+        # clears cache on OS X
+        sudo purge
+    elif [ -f /proc/sys/vm/drop_caches ] ; then
+        # Linux cache clearing
+        echo 3 | sudo tee /proc/sys/vm/drop_caches >/dev/null
+    else
+        # need an alternative for other operating systems
+        :
+    fi
+
+    echo "# Threads $nt"
+    $bin $args -n $nt -b $blocksize -r $rounds -l $numfiles -q $dir/testfile_%d
+done